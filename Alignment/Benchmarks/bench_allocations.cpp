@@ -0,0 +1,128 @@
+// bench_allocations.cpp
+//
+// Reservas de memoria por alineamiento al alinear muchas parejas cortas:
+// construir un NeedlemanWunsch por pareja frente a reutilizar uno solo con
+// set_sequences(). Cuenta las llamadas a operator new sustituyéndolo de forma
+// global; tras una pasada de calentamiento, el alineador reutilizado no
+// debería reservar nada.
+//
+// Uso: benchAlloc [número de parejas] [longitud mínima] [longitud máxima]
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "needleman_wunsch.h"
+
+namespace {
+
+std::atomic<unsigned long long> allocation_count{0};
+
+std::string random_dna(std::size_t length, std::mt19937& rng) {
+    static const char bases[] = "ACGT";
+    std::uniform_int_distribution<int> pick(0, 3);
+    std::string seq(length, 'A');
+    for (char& c : seq) {
+        c = bases[pick(rng)];
+    }
+    return seq;
+}
+
+// Ejecuta f(k) para cada pareja dos veces (calentamiento y medida) y devuelve
+// las reservas y el tiempo de la segunda pasada.
+template <typename F>
+void measure(const char* name, std::size_t num_pairs, F&& f) {
+    for (std::size_t k = 0; k < num_pairs; ++k) {
+        f(k);
+    }
+    const unsigned long long before = allocation_count.load();
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t k = 0; k < num_pairs; ++k) {
+        f(k);
+    }
+    auto end = std::chrono::steady_clock::now();
+    const unsigned long long allocations = allocation_count.load() - before;
+    const double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << std::setw(28) << name << std::setw(14) << std::setprecision(2)
+              << static_cast<double>(allocations) / num_pairs << std::setw(12) << std::setprecision(3)
+              << seconds * 1e6 / num_pairs << std::endl;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t num_pairs = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const std::size_t min_length = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+    const std::size_t max_length = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 200;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> pick_length(min_length, max_length);
+    std::vector<std::string> seqs_a(num_pairs);
+    std::vector<std::string> seqs_b(num_pairs);
+    for (std::size_t k = 0; k < num_pairs; ++k) {
+        seqs_a[k] = random_dna(pick_length(rng), rng);
+        seqs_b[k] = random_dna(pick_length(rng), rng);
+    }
+    const ScoringScheme scheme = ScoringScheme::dna(1, -1, -2);
+
+    long long checksum = 0;
+    NeedlemanWunsch reused(scheme);
+
+    std::cout << num_pairs << " pairs, " << min_length << "-" << max_length << " bp" << std::endl;
+    std::cout << std::setw(28) << "mode" << std::setw(14) << "allocs/pair" << std::setw(12) << "us/pair"
+              << std::endl;
+    std::cout << std::fixed;
+
+    measure("new object + score_only", num_pairs, [&](std::size_t k) {
+        checksum += NeedlemanWunsch(seqs_a[k], seqs_b[k], scheme).score_only();
+    });
+    measure("reused + score_only", num_pairs, [&](std::size_t k) {
+        reused.set_sequences(seqs_a[k], seqs_b[k]);
+        checksum += reused.score_only();
+    });
+    measure("new object + align", num_pairs, [&](std::size_t k) {
+        NeedlemanWunsch nw(seqs_a[k], seqs_b[k], scheme);
+        nw.align();
+        checksum += nw.get_cigar().size();
+    });
+    measure("reused + align", num_pairs, [&](std::size_t k) {
+        reused.set_sequences(seqs_a[k], seqs_b[k]);
+        reused.align();
+        checksum += reused.get_cigar().size();
+    });
+    measure("reused + align_affine", num_pairs, [&](std::size_t k) {
+        reused.set_sequences(seqs_a[k], seqs_b[k]);
+        reused.align_affine(-5, -1);
+        checksum += reused.get_cigar().size();
+    });
+    measure("reused + adaptive band", num_pairs, [&](std::size_t k) {
+        reused.set_sequences(seqs_a[k], seqs_b[k]);
+        checksum += reused.score_only_adaptive_band();
+    });
+
+    std::cout << "checksum " << checksum << std::endl;
+    return 0;
+}
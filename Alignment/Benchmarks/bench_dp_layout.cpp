@@ -0,0 +1,169 @@
+// bench_dp_layout.cpp
+//
+// Compara la disposición antigua de las matrices de programación dinámica
+// (std::vector<std::vector<int>> + std::vector<std::vector<char>>) con la
+// nueva (filas rotatorias + PackedTraceMatrix contigua de 2 bits por celda).
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "needleman_wunsch.h"
+
+namespace {
+
+const int MATCH = 3;
+const int MISMATCH = -1;
+const int GAP = -2;
+
+std::string random_dna(std::size_t length, std::mt19937& rng) {
+    static const char bases[] = "ACGT";
+    std::uniform_int_distribution<int> pick(0, 3);
+    std::string seq(length, 'A');
+    for (char& c : seq) {
+        c = bases[pick(rng)];
+    }
+    return seq;
+}
+
+// Réplica de la implementación anterior de NeedlemanWunsch::align(),
+// con la misma función de puntuación, para que sólo cambie la disposición.
+struct LegacyNeedlemanWunsch {
+    std::vector<std::vector<int>> score_matrix;
+    std::vector<std::vector<char>> trace_matrix;
+    std::string aligned_a;
+    std::string aligned_b;
+
+    int s(char a, char b) const {
+        static const std::unordered_map<char, std::unordered_map<char, int>> score_map{
+            {'A', {{'A', MATCH}, {'C', MISMATCH}, {'G', -MISMATCH}, {'T', MISMATCH}}},
+            {'C', {{'A', MISMATCH}, {'C', MATCH}, {'G', MISMATCH}, {'T', -MISMATCH}}},
+            {'G', {{'A', -MISMATCH}, {'C', MISMATCH}, {'G', MATCH}, {'T', MISMATCH}}},
+            {'T', {{'A', MISMATCH}, {'C', -MISMATCH}, {'G', MISMATCH}, {'T', MATCH}}},
+        };
+        return score_map.at(a).at(b);
+    }
+
+    int align(const std::string& a, const std::string& b) {
+        score_matrix.assign(a.length() + 1, std::vector<int>(b.length() + 1));
+        trace_matrix.assign(a.length() + 1, std::vector<char>(b.length() + 1));
+        for (std::size_t j = 0; j < score_matrix[0].size(); ++j) {
+            score_matrix[0][j] = static_cast<int>(j) * GAP;
+            trace_matrix[0][j] = 'L';
+        }
+        for (std::size_t i = 0; i < score_matrix.size(); ++i) {
+            score_matrix[i][0] = static_cast<int>(i) * GAP;
+            trace_matrix[i][0] = 'U';
+        }
+        for (std::size_t i = 1; i < score_matrix.size(); ++i) {
+            for (std::size_t j = 1; j < score_matrix[0].size(); ++j) {
+                int match_score = score_matrix[i - 1][j - 1] + s(a[i - 1], b[j - 1]);
+                int delete_score = score_matrix[i - 1][j] + GAP;
+                int insert_score = score_matrix[i][j - 1] + GAP;
+                int max_score = std::max({match_score, delete_score, insert_score});
+                score_matrix[i][j] = max_score;
+                if (max_score == match_score) {
+                    trace_matrix[i][j] = 'D';
+                } else if (max_score == delete_score) {
+                    trace_matrix[i][j] = 'U';
+                } else {
+                    trace_matrix[i][j] = 'L';
+                }
+            }
+        }
+
+        std::size_t i = a.length();
+        std::size_t j = b.length();
+        aligned_a.clear();
+        aligned_b.clear();
+        while (i > 0 || j > 0) {
+            if (i > 0 && j > 0 && trace_matrix[i][j] == 'D') {
+                aligned_a = a[i - 1] + aligned_a;
+                aligned_b = b[j - 1] + aligned_b;
+                --i;
+                --j;
+            } else if (i > 0 && trace_matrix[i][j] == 'U') {
+                aligned_a = a[i - 1] + aligned_a;
+                aligned_b = '-' + aligned_b;
+                --i;
+            } else {
+                aligned_a = '-' + aligned_a;
+                aligned_b = b[j - 1] + aligned_b;
+                --j;
+            }
+        }
+        return score_matrix[a.length()][b.length()];
+    }
+};
+
+// Memoria de las matrices antiguas: cada fila es un bloque independiente
+// (cabecera del vector + datos), sin contar la sobrecarga del asignador.
+std::size_t legacy_bytes(std::size_t rows, std::size_t cols) {
+    return rows * (sizeof(std::vector<int>) + cols * sizeof(int))
+         + rows * (sizeof(std::vector<char>) + cols * sizeof(char));
+}
+
+std::size_t flat_bytes(std::size_t rows, std::size_t cols) {
+    return PackedTraceMatrix(rows, cols).size_bytes() + 2 * cols * sizeof(int);
+}
+
+template <typename F>
+double time_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(42);
+    const std::size_t lengths[] = {500, 1000, 2000, 4000};
+
+    std::cout << std::setw(8) << "length"
+              << std::setw(14) << "legacy ms" << std::setw(14) << "flat ms"
+              << std::setw(10) << "speedup"
+              << std::setw(14) << "legacy MiB" << std::setw(14) << "flat MiB"
+              << std::setw(10) << "ratio" << std::endl;
+
+    for (std::size_t length : lengths) {
+        std::string a = random_dna(length, rng);
+        std::string b = random_dna(length, rng);
+
+        LegacyNeedlemanWunsch legacy;
+        int legacy_score = 0;
+        double legacy_ms = time_ms([&] { legacy_score = legacy.align(a, b); });
+
+        int flat_score = 0;
+        double flat_ms = time_ms([&] {
+            NeedlemanWunsch nw(a, b, MATCH, MISMATCH, GAP);
+            nw.align();
+            flat_score = nw.get_alignment_score();
+        });
+
+        if (legacy_score != flat_score) {
+            std::cerr << "Score mismatch at length " << length << ": "
+                      << legacy_score << " vs " << flat_score << std::endl;
+            return 1;
+        }
+
+        const double mib = 1024.0 * 1024.0;
+        double legacy_mib = legacy_bytes(length + 1, length + 1) / mib;
+        double flat_mib = flat_bytes(length + 1, length + 1) / mib;
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(8) << length
+                  << std::setw(14) << legacy_ms << std::setw(14) << flat_ms
+                  << std::setw(10) << legacy_ms / flat_ms
+                  << std::setw(14) << legacy_mib << std::setw(14) << flat_mib
+                  << std::setw(10) << legacy_mib / flat_mib << std::endl;
+    }
+
+    return 0;
+}
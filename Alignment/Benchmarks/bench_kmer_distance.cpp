@@ -0,0 +1,97 @@
+// bench_kmer_distance.cpp
+//
+// Tiempo de la matriz de distancias de entrada de Neighbour Joining según
+// cómo se calcula: por alineamiento (calculate_distance_matrix(), sólo para
+// pocas secuencias, extrapolando al resto) o por k-meros, más el árbol con la
+// búsqueda acotada. Los esbozos MinHash se comparan en tiempo constante por
+// pareja y se miden con todos los genomas; los perfiles de frecuencias crecen
+// con 4^k y se miden con los `perfiles` primeros. Las secuencias son genomas
+// sintéticos de familias de 50 con un 1 % de sustituciones.
+//
+// Uso: benchKmerDistance [genomas] [longitud] [perfiles] [hilos]
+//      (por defecto 2000 20000 500 0)
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include "neighbour_joining.h"
+
+namespace {
+
+std::unordered_map<std::string, std::string> synthetic_genomes(std::size_t count, std::size_t length) {
+    std::mt19937 rng(11);
+    const char bases[] = "ACGT";
+    std::unordered_map<std::string, std::string> genomes;
+    std::string ancestor;
+    for (std::size_t g = 0; g < count; ++g) {
+        if (g % 50 == 0) {
+            ancestor.clear();
+            for (std::size_t p = 0; p < length; ++p) {
+                ancestor += bases[rng() % 4];
+            }
+        }
+        std::string genome = ancestor;
+        for (char& c : genome) {
+            if (rng() % 100 == 0) {
+                c = bases[rng() % 4];
+            }
+        }
+        genomes["G" + std::to_string(g)] = genome;
+    }
+    return genomes;
+}
+
+template <typename Step>
+double seconds(Step step) {
+    auto start = std::chrono::steady_clock::now();
+    step();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    const std::size_t length = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000;
+    const std::size_t profile_count = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 500;
+    const unsigned threads = argc > 4 ? static_cast<unsigned>(std::atoi(argv[4])) : 0;
+
+    std::cout << std::fixed << std::setprecision(3);
+
+    // Referencia: alineamiento de todas las parejas con pocas secuencias.
+    const std::size_t aligned_count = 10;
+    {
+        NeighbourJoining nj(synthetic_genomes(aligned_count, length));
+        nj.set_num_threads(threads);
+        const double elapsed = seconds([&] { nj.calculate_distance_matrix(); });
+        const double pairs = aligned_count * (aligned_count - 1) / 2.0;
+        std::cout << "alignment    " << aligned_count << " genomes: " << elapsed << " s ("
+                  << elapsed / pairs * 1e3 << " ms/pair, ~" << elapsed / pairs * count * (count - 1) / 2.0
+                  << " s for " << count << ")" << std::endl;
+    }
+
+    const KmerMeasure measures[] = {KMER_MASH, KMER_EUCLIDEAN, KMER_MANHATTAN, KMER_PEARSON};
+    const char* names[] = {"mash", "euclidean", "manhattan", "pearson"};
+    for (int m = 0; m < 4; ++m) {
+        KmerDistanceOptions options;
+        options.measure = measures[m];
+        options.k = measures[m] == KMER_MASH ? 21 : 6;
+        const std::size_t genomes = measures[m] == KMER_MASH ? count : std::min(count, profile_count);
+        NeighbourJoining nj(synthetic_genomes(genomes, length));
+        nj.set_num_threads(threads);
+        nj.set_rapid_search(true);
+        const double distances = seconds([&] { nj.calculate_kmer_distance_matrix(options); });
+        const double tree = seconds([&] { nj.construct_tree(); });
+        std::cout << std::left << std::setw(10) << names[m] << std::right << " k=" << std::setw(2) << options.k
+                  << "  " << genomes << " genomes: distances " << distances << " s, tree " << tree << " s"
+                  << std::endl;
+    }
+    return 0;
+}
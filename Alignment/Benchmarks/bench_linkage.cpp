@@ -0,0 +1,80 @@
+// bench_linkage.cpp
+//
+// Tiempo de construcción de un árbol guía con cada estrategia de
+// NeighbourJoining::construct_tree() sobre matrices de distancias aleatorias:
+// UPGMA, WPGMA y enlace simple y completo (cadenas de vecinos más cercanos,
+// O(n^2)) frente a Neighbour Joining con la búsqueda acotada.
+//
+// Uso: benchLinkage [número de taxones]...   (por defecto 1000 2000 4000 8000)
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "neighbour_joining.h"
+
+int main(int argc, char* argv[]) {
+    std::vector<std::size_t> sizes;
+    for (int k = 1; k < argc; ++k) {
+        sizes.push_back(std::strtoul(argv[k], nullptr, 10));
+    }
+    if (sizes.empty()) {
+        sizes = {1000, 2000, 4000, 8000};
+    }
+
+    const TreeMethod methods[] = {TREE_UPGMA, TREE_WPGMA, TREE_SINGLE_LINKAGE, TREE_COMPLETE_LINKAGE,
+                                  TREE_NEIGHBOUR_JOINING};
+    const char* names[] = {"UPGMA", "WPGMA", "single", "complete", "NJ (rapid)"};
+
+    std::cout << std::setw(8) << "taxa";
+    for (const char* name : names) {
+        std::cout << std::setw(12) << name;
+    }
+    std::cout << "   (seconds)" << std::endl;
+
+    for (std::size_t n : sizes) {
+        std::unordered_map<std::string, std::string> sequences;
+        for (std::size_t s = 0; s < n; ++s) {
+            sequences["T" + std::to_string(s)] = "A";
+        }
+
+        // Distancias euclídeas entre puntos aleatorios, como en benchNJTree.
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> coordinate(0.0, 1.0);
+        std::vector<double> points(4 * n);
+        for (double& x : points) {
+            x = coordinate(rng);
+        }
+        DistanceMatrix distances(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < i; ++j) {
+                double sum = 0.0;
+                for (int c = 0; c < 4; ++c) {
+                    const double diff = points[4 * i + c] - points[4 * j + c];
+                    sum += diff * diff;
+                }
+                distances.set(i, j, static_cast<float>(std::sqrt(sum)));
+            }
+        }
+
+        std::cout << std::fixed << std::setprecision(3) << std::setw(8) << n;
+        for (TreeMethod method : methods) {
+            NeighbourJoining nj(sequences);
+            nj.set_tree_method(method);
+            nj.set_rapid_search(true);
+            nj.set_distance_matrix(distances);
+            auto start = std::chrono::steady_clock::now();
+            nj.construct_tree();
+            auto end = std::chrono::steady_clock::now();
+            std::cout << std::setw(12) << std::chrono::duration<double>(end - start).count();
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
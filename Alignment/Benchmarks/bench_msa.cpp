@@ -0,0 +1,75 @@
+// bench_msa.cpp
+//
+// Tiempo del alineamiento múltiple progresivo (progressive_alignment()) de
+// una familia de secuencias emparentadas a lo largo de su árbol de Neighbour
+// Joining, con distinto número de hilos, y su puntuación de suma de parejas.
+//
+// Uso: benchMSA [secuencias] [longitud]   (por defecto 200 300)
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "neighbour_joining.h"
+#include "progressive_alignment.h"
+
+int main(int argc, char* argv[]) {
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200;
+    const std::size_t length = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 300;
+
+    // Un ancestro común y descendientes con un 10 % de sustituciones y un 3 %
+    // de inserciones y de deleciones.
+    std::mt19937 rng(7);
+    const char bases[] = "ACGT";
+    std::string ancestor;
+    for (std::size_t k = 0; k < length; ++k) {
+        ancestor += bases[rng() % 4];
+    }
+    std::unordered_map<std::string, std::string> sequences;
+    for (std::size_t s = 0; s < count; ++s) {
+        std::string sequence;
+        for (char c : ancestor) {
+            const unsigned event = rng() % 100;
+            if (event < 10) {
+                sequence += bases[rng() % 4];
+            } else if (event < 13) {
+                sequence += c;
+                sequence += bases[rng() % 4];
+            } else if (event >= 16) {
+                sequence += c;
+            }
+        }
+        sequences["S" + std::to_string(s)] = sequence;
+    }
+
+    const ScoringScheme scoring = ScoringScheme::dna(3, -1, -2);
+    NeighbourJoining nj(sequences, scoring);
+    nj.calculate_distance_matrix();
+    const NeighbourJoining::Node* root = nj.construct_tree();
+
+    std::vector<unsigned> thread_counts = {1};
+    const unsigned hardware = std::thread::hardware_concurrency();
+    for (unsigned threads = 2; threads <= hardware; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+
+    std::cout << count << " sequences of ~" << length << " bp" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "seconds" << std::setw(10) << "columns"
+              << std::setw(16) << "sum of pairs" << std::endl;
+    for (unsigned threads : thread_counts) {
+        auto start = std::chrono::steady_clock::now();
+        MultipleAlignment alignment = progressive_alignment(root, scoring, threads);
+        auto end = std::chrono::steady_clock::now();
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(3) << std::setw(12)
+                  << std::chrono::duration<double>(end - start).count() << std::setw(10)
+                  << alignment.rows.front().size() << std::setw(16) << sum_of_pairs_score(alignment, scoring)
+                  << std::endl;
+    }
+    return 0;
+}
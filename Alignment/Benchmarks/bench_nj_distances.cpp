@@ -0,0 +1,86 @@
+// bench_nj_distances.cpp
+//
+// Escalado de NeighbourJoining::calculate_distance_matrix() con el número de
+// hilos. Comprueba además que la matriz es idéntica para cualquier número de
+// hilos.
+//
+// Uso: benchNJ [número de secuencias] [hilos máximos]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "neighbour_joining.h"
+
+namespace {
+
+std::string random_dna(std::size_t length, std::mt19937& rng) {
+    static const char bases[] = "ACGT";
+    std::uniform_int_distribution<int> pick(0, 3);
+    std::string seq(length, 'A');
+    for (char& c : seq) {
+        c = bases[pick(rng)];
+    }
+    return seq;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int num_sequences = argc > 1 ? std::atoi(argv[1]) : 48;
+    unsigned max_threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : std::thread::hardware_concurrency();
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+
+    // Longitudes muy distintas para que el reparto por coste importe.
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> length(100, 1500);
+    std::unordered_map<std::string, std::string> sequences;
+    for (int s = 0; s < num_sequences; ++s) {
+        sequences["Seq" + std::to_string(s)] = random_dna(length(rng), rng);
+    }
+
+    std::cout << num_sequences << " sequences, "
+              << num_sequences * (num_sequences - 1) / 2 << " pairwise alignments" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(14) << "ms"
+              << std::setw(10) << "speedup" << std::setw(12) << "efficiency" << std::endl;
+
+    DistanceMatrix reference;
+    double serial_ms = 0.0;
+    for (unsigned threads = 1; ; threads = std::min(threads * 2, max_threads)) {
+        NeighbourJoining nj(sequences);
+        nj.set_num_threads(threads);
+
+        auto start = std::chrono::steady_clock::now();
+        nj.calculate_distance_matrix();
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        if (threads == 1) {
+            reference = nj.get_distance_matrix();
+            serial_ms = ms;
+        } else if (nj.get_distance_matrix() != reference) {
+            std::cerr << "Distance matrix differs with " << threads << " threads" << std::endl;
+            return 1;
+        }
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(8) << threads << std::setw(14) << ms
+                  << std::setw(10) << serial_ms / ms
+                  << std::setw(12) << serial_ms / ms / threads << std::endl;
+
+        if (threads >= max_threads) {
+            break;
+        }
+    }
+
+    return 0;
+}
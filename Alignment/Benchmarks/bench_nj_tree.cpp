@@ -0,0 +1,86 @@
+// bench_nj_tree.cpp
+//
+// Tiempo y memoria de la construcción del árbol de Neighbour Joining
+// (NeighbourJoining::construct_tree()) sobre matrices de distancias
+// aleatorias de varios tamaños, sin contar el cálculo de las distancias:
+// búsqueda exhaustiva frente a la acotada al estilo de RapidNJ, con las filas
+// ordenadas en memoria y en un fichero temporal. Comprueba además que los
+// tres árboles son idénticos.
+//
+// Uso: benchNJTree [número de taxones]...   (por defecto 500 1000 2000 4000)
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "neighbour_joining.h"
+
+int main(int argc, char* argv[]) {
+    std::vector<std::size_t> sizes;
+    for (int k = 1; k < argc; ++k) {
+        sizes.push_back(std::strtoul(argv[k], nullptr, 10));
+    }
+    if (sizes.empty()) {
+        sizes = {500, 1000, 2000, 4000};
+    }
+
+    const std::string spill = std::filesystem::temp_directory_path().string();
+    std::cout << std::setw(8) << "taxa" << std::setw(14) << "matrix MiB" << std::setw(14) << "exhaustive s"
+              << std::setw(12) << "rapid s" << std::setw(12) << "spill s" << std::setw(10) << "speedup" << std::endl;
+    for (std::size_t n : sizes) {
+        std::unordered_map<std::string, std::string> sequences;
+        for (std::size_t s = 0; s < n; ++s) {
+            sequences["T" + std::to_string(s)] = "A";
+        }
+
+        // Distancias euclídeas entre puntos aleatorios: con estructura, como
+        // unas distancias reales, y sin empates.
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> coordinate(0.0, 1.0);
+        std::vector<double> points(4 * n);
+        for (double& x : points) {
+            x = coordinate(rng);
+        }
+        DistanceMatrix distances(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < i; ++j) {
+                double sum = 0.0;
+                for (int c = 0; c < 4; ++c) {
+                    const double diff = points[4 * i + c] - points[4 * j + c];
+                    sum += diff * diff;
+                }
+                distances.set(i, j, static_cast<float>(std::sqrt(sum)));
+            }
+        }
+
+        std::string newick[3];
+        double seconds[3];
+        for (int mode = 0; mode < 3; ++mode) {
+            NeighbourJoining nj(sequences);
+            nj.set_rapid_search(mode > 0, mode == 2 ? spill : "");
+            nj.set_distance_matrix(distances);
+            auto start = std::chrono::steady_clock::now();
+            NeighbourJoining::Node* root = nj.construct_tree();
+            auto end = std::chrono::steady_clock::now();
+            seconds[mode] = std::chrono::duration<double>(end - start).count();
+            newick[mode] = nj.generate_newick_format(root);
+        }
+        if (newick[1] != newick[0] || newick[2] != newick[0]) {
+            std::cerr << "Trees differ with " << n << " taxa" << std::endl;
+            return 1;
+        }
+
+        std::cout << std::fixed << std::setprecision(2) << std::setw(8) << n
+                  << std::setw(14) << distances.size_bytes() / (1024.0 * 1024.0) << std::setw(14) << seconds[0]
+                  << std::setw(12) << seconds[1] << std::setw(12) << seconds[2]
+                  << std::setw(10) << seconds[0] / seconds[1] << std::endl;
+    }
+    return 0;
+}
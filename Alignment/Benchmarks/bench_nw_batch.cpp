@@ -0,0 +1,96 @@
+// bench_nw_batch.cpp
+//
+// Rendimiento de las puntuaciones de Needleman-Wunsch todos contra todos
+// sobre lecturas cortas: score_only() pareja a pareja frente al núcleo
+// vectorizado entre secuencias (nw_batch.h) con cada ISA disponible.
+//
+// Uso: benchNWBatch [número de lecturas] [longitud]
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "needleman_wunsch.h"
+
+namespace {
+
+std::string random_dna(std::size_t length, std::mt19937& rng) {
+    static const char bases[] = "ACGT";
+    std::uniform_int_distribution<int> pick(0, 3);
+    std::string seq(length, 'A');
+    for (char& c : seq) {
+        c = bases[pick(rng)];
+    }
+    return seq;
+}
+
+template <typename F>
+double time_seconds(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t num_reads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 400;
+    const std::size_t length = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 150;
+
+    // Longitudes entre length / 2 y length, como lecturas recortadas.
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> pick_length(length / 2, length);
+    std::vector<std::string> reads(num_reads);
+    double cells = 0.0;
+    for (std::string& read : reads) {
+        read = random_dna(pick_length(rng), rng);
+    }
+    for (std::size_t i = 0; i < num_reads; ++i) {
+        for (std::size_t j = i + 1; j < num_reads; ++j) {
+            cells += static_cast<double>(reads[i].size()) * reads[j].size();
+        }
+    }
+    const ScoringScheme scheme = ScoringScheme::dna(3, -1, -2);
+
+    std::vector<int> reference;
+    double pairwise = time_seconds([&] {
+        for (std::size_t i = 0; i < num_reads; ++i) {
+            for (std::size_t j = i + 1; j < num_reads; ++j) {
+                reference.push_back(NeedlemanWunsch(reads[i], reads[j], scheme).score_only());
+            }
+        }
+    });
+
+    std::cout << num_reads << " reads, " << reference.size() << " pairs" << std::endl;
+    std::cout << std::setw(12) << "kernel" << std::setw(12) << "seconds"
+              << std::setw(10) << "GCUPS" << std::setw(10) << "speedup" << std::endl;
+    std::cout << std::fixed << std::setprecision(3)
+              << std::setw(12) << "pairwise" << std::setw(12) << pairwise
+              << std::setw(10) << cells / pairwise / 1e9 << std::setw(10) << 1.0 << std::endl;
+
+    for (int level = SIMD_SCALAR; level <= detect_simd_level(); ++level) {
+        std::vector<int> scores;
+        double seconds = time_seconds([&] {
+            for (std::size_t i = 0; i < num_reads; ++i) {
+                std::vector<std::string> targets(reads.begin() + i + 1, reads.end());
+                std::vector<int> row = NeedlemanWunsch::score_batch(reads[i], targets, scheme,
+                                                                    static_cast<SimdLevel>(level));
+                scores.insert(scores.end(), row.begin(), row.end());
+            }
+        });
+        if (scores != reference) {
+            std::cerr << "Score mismatch with " << simd_level_name(static_cast<SimdLevel>(level)) << std::endl;
+            return 1;
+        }
+        std::cout << std::setw(12) << simd_level_name(static_cast<SimdLevel>(level))
+                  << std::setw(12) << seconds << std::setw(10) << cells / seconds / 1e9
+                  << std::setw(10) << pairwise / seconds << std::endl;
+    }
+
+    return 0;
+}
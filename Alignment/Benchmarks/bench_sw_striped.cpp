@@ -0,0 +1,78 @@
+// bench_sw_striped.cpp
+//
+// Rendimiento del núcleo striped de Smith-Waterman en GCUPS (miles de
+// millones de celdas por segundo) para cada juego de instrucciones que
+// soporta la CPU, frente a la referencia escalar.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include "sw_striped.h"
+
+namespace {
+
+std::vector<std::uint8_t> random_codes(std::size_t length, std::mt19937& rng) {
+    std::uniform_int_distribution<int> pick(0, 3);
+    std::vector<std::uint8_t> codes(length);
+    for (std::uint8_t& c : codes) {
+        c = static_cast<std::uint8_t>(pick(rng));
+    }
+    return codes;
+}
+
+} // namespace
+
+int main() {
+    // Misma tabla que SmithWaterman(…, 5, -3, -4): transiciones a +3.
+    const int table[16] = {
+         5, -3,  3, -3,
+        -3,  5, -3,  3,
+         3, -3,  5, -3,
+        -3,  3, -3,  5,
+    };
+    const int gap = -4;
+
+    std::mt19937 rng(1234);
+    const std::size_t target_length = 100000;
+    const std::size_t query_lengths[] = {100, 400, 1600};
+    std::vector<std::uint8_t> target = random_codes(target_length, rng);
+
+    std::cout << "CPU: " << simd_level_name(detect_simd_level()) << std::endl;
+    std::cout << std::setw(8) << "query" << std::setw(10) << "ISA"
+              << std::setw(12) << "score" << std::setw(12) << "ms"
+              << std::setw(10) << "GCUPS" << std::endl;
+
+    for (std::size_t query_length : query_lengths) {
+        std::vector<std::uint8_t> query = random_codes(query_length, rng);
+        int reference = -1;
+
+        for (int level = SIMD_SCALAR; level <= detect_simd_level(); ++level) {
+            SimdLevel simd = static_cast<SimdLevel>(level);
+            auto start = std::chrono::steady_clock::now();
+            int score = striped_smith_waterman_score(query.data(), query.size(), target.data(), target.size(),
+                                                     table, 4, gap, simd);
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - start).count();
+
+            if (level == SIMD_SCALAR) {
+                reference = score;
+            } else if (score != reference) {
+                std::cerr << "Score mismatch for " << simd_level_name(simd) << ": "
+                          << score << " vs " << reference << std::endl;
+                return 1;
+            }
+
+            double cells = static_cast<double>(query_length) * static_cast<double>(target_length);
+            std::cout << std::fixed << std::setprecision(2)
+                      << std::setw(8) << query_length << std::setw(10) << simd_level_name(simd)
+                      << std::setw(12) << score << std::setw(12) << seconds * 1000.0
+                      << std::setw(10) << cells / seconds / 1e9 << std::endl;
+        }
+    }
+
+    return 0;
+}
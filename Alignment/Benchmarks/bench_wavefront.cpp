@@ -0,0 +1,100 @@
+// bench_wavefront.cpp
+//
+// Escalado del frente de onda por bloques (wavefront.h) para un único
+// alineamiento largo: score_only() secuencial frente a score_only_wavefront()
+// con 1, 2, 4... hilos, en NeedlemanWunsch y SmithWaterman. Comprueba además
+// que las puntuaciones son idénticas.
+//
+// Uso: benchWavefront [longitud] [hilos máximos]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include "needleman_wunsch.h"
+#include "smith_waterman.h"
+
+namespace {
+
+std::string random_dna(std::size_t length, std::mt19937& rng) {
+    static const char bases[] = "ACGT";
+    std::uniform_int_distribution<int> pick(0, 3);
+    std::string seq(length, 'A');
+    for (char& c : seq) {
+        c = bases[pick(rng)];
+    }
+    return seq;
+}
+
+template <typename F>
+double time_seconds(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+void print_row(const char* name, unsigned threads, double seconds, double serial, double cells) {
+    std::cout << std::fixed << std::setprecision(3)
+              << std::setw(12) << name << std::setw(8) << threads << std::setw(12) << seconds
+              << std::setw(10) << cells / seconds / 1e9 << std::setw(10) << serial / seconds << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t length = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    unsigned max_threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : std::thread::hardware_concurrency();
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+
+    std::mt19937 rng(42);
+    const std::string a = random_dna(length, rng);
+    const std::string b = random_dna(length, rng);
+    const double cells = static_cast<double>(length) * length;
+
+    std::cout << std::setw(12) << "kernel" << std::setw(8) << "threads" << std::setw(12) << "seconds"
+              << std::setw(10) << "GCUPS" << std::setw(10) << "speedup" << std::endl;
+
+    NeedlemanWunsch nw(a, b, 3, -1, -2);
+    int nw_score = 0;
+    const double nw_serial = time_seconds([&] { nw_score = nw.score_only(); });
+    print_row("NW serial", 1, nw_serial, nw_serial, cells);
+    for (unsigned threads = 1; ; threads = std::min(threads * 2, max_threads)) {
+        int score = 0;
+        double seconds = time_seconds([&] { score = nw.score_only_wavefront(threads); });
+        if (score != nw_score) {
+            std::cerr << "NW score mismatch with " << threads << " threads" << std::endl;
+            return 1;
+        }
+        print_row("NW tiles", threads, seconds, nw_serial, cells);
+        if (threads >= max_threads) {
+            break;
+        }
+    }
+
+    SmithWaterman sw(a, b, 5, -3, -4);
+    SmithWaterman::LocalScore sw_hit{0, 0, 0};
+    const double sw_serial = time_seconds([&] { sw_hit = sw.score_only(); });
+    print_row("SW serial", 1, sw_serial, sw_serial, cells);
+    for (unsigned threads = 1; ; threads = std::min(threads * 2, max_threads)) {
+        SmithWaterman::LocalScore hit{0, 0, 0};
+        double seconds = time_seconds([&] { hit = sw.score_only_wavefront(threads); });
+        if (hit.score != sw_hit.score || hit.end_a != sw_hit.end_a || hit.end_b != sw_hit.end_b) {
+            std::cerr << "SW result mismatch with " << threads << " threads" << std::endl;
+            return 1;
+        }
+        print_row("SW tiles", threads, seconds, sw_serial, cells);
+        if (threads >= max_threads) {
+            break;
+        }
+    }
+
+    return 0;
+}
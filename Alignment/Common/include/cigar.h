@@ -0,0 +1,119 @@
+// cigar.h
+
+#ifndef CIGAR_H
+#define CIGAR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Operaciones CIGAR, tomando A como consulta y B como referencia:
+//   M  alinea un símbolo de A con uno de B (coincidencia o sustitución),
+//   I  símbolo de A frente a un gap en B (traza "arriba"),
+//   D  gap en A frente a un símbolo de B (traza "izquierda").
+enum CigarOp : char {
+    CIGAR_MATCH = 'M',
+    CIGAR_INSERTION = 'I',
+    CIGAR_DELETION = 'D'
+};
+
+// Alineamiento compacto como rachas de operaciones, p. ej. 12M2I30M. El
+// trazado añade las operaciones del final hacia el principio con push_back()
+// y llama a reverse() una sola vez al terminar.
+class Cigar {
+public:
+    struct Run {
+        std::uint32_t length;
+        char op;
+
+        bool operator==(const Run& other) const { return length == other.length && op == other.op; }
+    };
+
+    void clear() { runs.clear(); }
+
+    // Añade `length` operaciones `op`, fusionándolas con la última racha si
+    // es del mismo tipo.
+    void push_back(char op, std::uint32_t length = 1) {
+        if (length == 0) {
+            return;
+        }
+        if (!runs.empty() && runs.back().op == op) {
+            runs.back().length += length;
+        } else {
+            runs.push_back(Run{length, op});
+        }
+    }
+
+    void append(const Cigar& other) {
+        for (const Run& run : other.runs) {
+            push_back(run.op, run.length);
+        }
+    }
+
+    void reverse() { std::reverse(runs.begin(), runs.end()); }
+
+    std::size_t size() const { return runs.size(); }
+    bool empty() const { return runs.empty(); }
+    const Run& operator[](std::size_t k) const { return runs[k]; }
+    std::vector<Run>::const_iterator begin() const { return runs.begin(); }
+    std::vector<Run>::const_iterator end() const { return runs.end(); }
+
+    // Símbolos de A (M + I) y de B (M + D) que cubre el alineamiento.
+    std::size_t length_a() const { return count('M') + count('I'); }
+    std::size_t length_b() const { return count('M') + count('D'); }
+
+    std::string to_string() const {
+        std::string text;
+        for (const Run& run : runs) {
+            text += std::to_string(run.length);
+            text += run.op;
+        }
+        return text;
+    }
+
+    // Reconstruye las dos cadenas con gaps a partir de a[begin_a] y b[begin_b].
+    void expand(const std::string& a, std::size_t begin_a, const std::string& b, std::size_t begin_b,
+                std::string& aligned_a, std::string& aligned_b) const {
+        std::size_t columns = 0;
+        for (const Run& run : runs) {
+            columns += run.length;
+        }
+        aligned_a.clear();
+        aligned_b.clear();
+        aligned_a.reserve(columns);
+        aligned_b.reserve(columns);
+
+        for (const Run& run : runs) {
+            if (run.op != CIGAR_DELETION) {
+                aligned_a.append(a, begin_a, run.length);
+                begin_a += run.length;
+            } else {
+                aligned_a.append(run.length, '-');
+            }
+            if (run.op != CIGAR_INSERTION) {
+                aligned_b.append(b, begin_b, run.length);
+                begin_b += run.length;
+            } else {
+                aligned_b.append(run.length, '-');
+            }
+        }
+    }
+
+    bool operator==(const Cigar& other) const { return runs == other.runs; }
+    bool operator!=(const Cigar& other) const { return !(*this == other); }
+
+private:
+    std::size_t count(char op) const {
+        std::size_t total = 0;
+        for (const Run& run : runs) {
+            total += run.op == op ? run.length : 0;
+        }
+        return total;
+    }
+
+    std::vector<Run> runs;
+};
+
+#endif // CIGAR_H
@@ -0,0 +1,27 @@
+// cpu_features.h
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include <cstddef>
+
+// Niveles de instrucciones SIMD para los núcleos vectorizados, de menor a
+// mayor anchura. El orden permite comparar niveles con < y >.
+enum SimdLevel {
+    SIMD_SCALAR = 0,
+    SIMD_SSE41 = 1,
+    SIMD_AVX2 = 2,
+    SIMD_AVX512 = 3
+};
+
+// Nivel más ancho que soportan la CPU y el sistema operativo. Se detecta una
+// sola vez y se cachea.
+SimdLevel detect_simd_level();
+
+const char* simd_level_name(SimdLevel level);
+
+// Tamaño en bytes de la caché L1 de datos (32 KiB si el sistema no lo indica).
+// Se consulta una sola vez y se cachea.
+std::size_t l1_data_cache_size();
+
+#endif // CPU_FEATURES_H
@@ -0,0 +1,113 @@
+// dp_matrix.h
+
+#ifndef DP_MATRIX_H
+#define DP_MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Matriz de programación dinámica almacenada en un único bloque contiguo,
+// fila a fila (row-major). Cada fila ocupa `stride()` elementos: el ancho real
+// se redondea a un múltiplo de 64 bytes para que cada fila empiece alineada
+// respecto al bloque y el acceso (i, j) sea un simple data[i * stride + j].
+template <typename T>
+class DPMatrix {
+public:
+    DPMatrix() = default;
+    DPMatrix(std::size_t rows, std::size_t cols) { resize(rows, cols); }
+
+    // Redimensiona la matriz y pone todas las celdas a T(). Reutiliza la
+    // reserva existente si es suficientemente grande.
+    void resize(std::size_t rows, std::size_t cols) {
+        const std::size_t lane = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+        n_rows = rows;
+        n_cols = cols;
+        row_stride = (cols + lane - 1) / lane * lane;
+        data.assign(n_rows * row_stride, T());
+    }
+
+    T* row(std::size_t i) { return data.data() + i * row_stride; }
+    const T* row(std::size_t i) const { return data.data() + i * row_stride; }
+
+    T& operator()(std::size_t i, std::size_t j) { return data[i * row_stride + j]; }
+    const T& operator()(std::size_t i, std::size_t j) const { return data[i * row_stride + j]; }
+
+    std::size_t rows() const { return n_rows; }
+    std::size_t cols() const { return n_cols; }
+    std::size_t stride() const { return row_stride; }
+    std::size_t size_bytes() const { return data.size() * sizeof(T); }
+
+private:
+    std::vector<T> data;
+    std::size_t n_rows = 0;
+    std::size_t n_cols = 0;
+    std::size_t row_stride = 0;
+};
+
+// Códigos de traza de 2 bits: sustituyen a los caracteres 'D', 'U' y 'L'.
+enum TraceCode : std::uint8_t {
+    TRACE_DIAG = 0,  // Diagonal
+    TRACE_UP = 1,    // Arriba (gap en la secuencia B)
+    TRACE_LEFT = 2   // Izquierda (gap en la secuencia A)
+};
+
+// Bits adicionales de la traza con gaps afines (Gotoh): además del origen de
+// H (2 bits), indican si F (vertical) y E (horizontal) extienden un gap
+// existente en vez de abrir uno nuevo desde H.
+enum AffineTraceBits : std::uint8_t {
+    AFFINE_F_EXTEND = 4,
+    AFFINE_E_EXTEND = 8
+};
+
+inline char trace_code_to_char(std::uint8_t code) {
+    static const char symbols[] = {'D', 'U', 'L', '?'};
+    return symbols[code & 3];
+}
+
+// Matriz de códigos de `Bits` bits (1, 2 o 4) empaquetados en bytes sobre un
+// DPMatrix<uint8_t>: 8 / Bits celdas por byte.
+template <unsigned Bits>
+class PackedCodeMatrix {
+public:
+    static_assert(Bits == 1 || Bits == 2 || Bits == 4, "Bits must be 1, 2 or 4");
+
+    PackedCodeMatrix() = default;
+    PackedCodeMatrix(std::size_t rows, std::size_t cols) { resize(rows, cols); }
+
+    void resize(std::size_t rows, std::size_t cols) {
+        n_cols = cols;
+        packed.resize(rows, (cols + per_byte - 1) / per_byte);
+    }
+
+    std::uint8_t get(std::size_t i, std::size_t j) const {
+        const unsigned shift = static_cast<unsigned>(j % per_byte) * Bits;
+        return static_cast<std::uint8_t>((packed(i, j / per_byte) >> shift) & mask);
+    }
+
+    void set(std::size_t i, std::size_t j, std::uint8_t code) {
+        const unsigned shift = static_cast<unsigned>(j % per_byte) * Bits;
+        std::uint8_t& cell = packed(i, j / per_byte);
+        cell = static_cast<std::uint8_t>((cell & ~(mask << shift)) | ((code & mask) << shift));
+    }
+
+    std::size_t rows() const { return packed.rows(); }
+    std::size_t cols() const { return n_cols; }
+    std::size_t size_bytes() const { return packed.size_bytes(); }
+
+private:
+    static const unsigned per_byte = 8 / Bits;
+    static const unsigned mask = (1u << Bits) - 1;
+
+    DPMatrix<std::uint8_t> packed;
+    std::size_t n_cols = 0;
+};
+
+// Traza lineal: cuatro celdas por byte, una cuarta parte que la antigua
+// std::vector<std::vector<char>>.
+typedef PackedCodeMatrix<2> PackedTraceMatrix;
+
+// Traza afín: origen de H más los bits AFFINE_*_EXTEND, dos celdas por byte.
+typedef PackedCodeMatrix<4> AffineTraceMatrix;
+
+#endif // DP_MATRIX_H
@@ -0,0 +1,77 @@
+// scoring_scheme.h
+
+#ifndef SCORING_SCHEME_H
+#define SCORING_SCHEME_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "substitution_matrices.h"
+
+// Esquema de puntuación por instancia: tabla de sustitución densa sobre un
+// alfabeto pequeño más la penalización de gap lineal. Las secuencias se
+// codifican una sola vez como índices del alfabeto, de modo que el bucle
+// interno de la programación dinámica es un simple acceso row[code].
+class ScoringScheme {
+public:
+    static const int MAX_ALPHABET = 32;
+
+    // Construye el esquema a partir de una tabla constante. La fila y la
+    // columna del símbolo '-' valen gap_penalty.
+    template <typename Alphabet>
+    ScoringScheme(const SubstitutionTable<Alphabet>& substitution, int gap_penalty);
+
+    // ADN con los parámetros clásicos de NeedlemanWunsch/SmithWaterman.
+    static ScoringScheme dna(int match, int mismatch, int gap_penalty);
+    static ScoringScheme blosum62(int gap_penalty);
+    static ScoringScheme pam250(int gap_penalty);
+
+    // Codifica una secuencia (mayúsculas o minúsculas). Lanza
+    // std::invalid_argument si algún símbolo no pertenece al alfabeto.
+    std::vector<std::uint8_t> encode(std::string_view sequence) const;
+    // Igual, reutilizando la capacidad de `codes`.
+    void encode(std::string_view sequence, std::vector<std::uint8_t>& codes) const;
+
+    int score(std::uint8_t a, std::uint8_t b) const { return table[a * alphabet_size + b]; }
+    const int* row(std::uint8_t a) const { return table + a * alphabet_size; }
+    // Tabla completa (size() x size(), por filas).
+    const int* data() const { return table; }
+
+    int size() const { return alphabet_size; }
+    int gap() const { return gap_penalty; }
+    std::uint8_t gap_code() const { return static_cast<std::uint8_t>(alphabet_size - 1); }
+    char symbol(std::uint8_t code) const { return symbols[code]; }
+
+private:
+    int alphabet_size;
+    int gap_penalty;
+    int table[MAX_ALPHABET * MAX_ALPHABET];
+    char symbols[MAX_ALPHABET];
+    std::int8_t codes[256];
+};
+
+template <typename Alphabet>
+ScoringScheme::ScoringScheme(const SubstitutionTable<Alphabet>& substitution, int gap_penalty)
+    : alphabet_size(Alphabet::size), gap_penalty(gap_penalty) {
+    static_assert(Alphabet::size <= MAX_ALPHABET, "alphabet too large for ScoringScheme");
+    static_assert(Alphabet::symbol(Alphabet::size - 1) == '-', "the last symbol must be the gap");
+
+    for (int c = 0; c < 256; ++c) {
+        codes[c] = -1;
+    }
+    for (int x = 0; x < alphabet_size; ++x) {
+        const char c = Alphabet::symbol(x);
+        symbols[x] = c;
+        codes[static_cast<unsigned char>(c)] = static_cast<std::int8_t>(x);
+        if (c >= 'A' && c <= 'Z') {
+            codes[static_cast<unsigned char>(c - 'A' + 'a')] = static_cast<std::int8_t>(x);
+        }
+        for (int y = 0; y < alphabet_size; ++y) {
+            const bool is_gap = x == alphabet_size - 1 || y == alphabet_size - 1;
+            table[x * alphabet_size + y] = is_gap ? gap_penalty : substitution.score[x][y];
+        }
+    }
+}
+
+#endif // SCORING_SCHEME_H
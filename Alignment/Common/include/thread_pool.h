@@ -0,0 +1,70 @@
+// thread_pool.h
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Grupo de hilos con robo de trabajo (work stealing). Cada hilo tiene su
+// propia cola: toma tareas por delante de la suya y, cuando se queda sin
+// trabajo, roba por detrás de la de otro. El hilo que llama a parallel_for()
+// también trabaja, así que ThreadPool(1) no crea ningún hilo adicional.
+class ThreadPool {
+public:
+    // num_threads == 0 usa std::thread::hardware_concurrency().
+    explicit ThreadPool(unsigned num_threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return num_threads; }
+
+    // Ejecuta task(k) para k en [0, count) y espera a que terminen todas.
+    // Las tareas se reparten en orden entre las colas (k va a la cola
+    // k % size()), de modo que si el llamante las ordena de mayor a menor
+    // coste cada hilo empieza por las más caras y los robos equilibran el
+    // final. Si alguna tarea lanza una excepción, se relanza aquí la primera.
+    // No admite llamadas anidadas desde dentro de una tarea.
+    void parallel_for(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    // Igual, pero task(k, worker) recibe también el índice [0, size()) del
+    // hilo que la ejecuta, para que el llamante pueda mantener un espacio de
+    // trabajo por hilo y reutilizarlo entre tareas.
+    void parallel_for_worker(std::size_t count, const std::function<void(std::size_t, unsigned)>& task);
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+
+    void worker_loop(unsigned worker);
+    void run_tasks(unsigned worker);
+    bool pop_task(unsigned worker, std::size_t& index);
+
+    unsigned num_threads;
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> threads;
+
+    // Estado del parallel_for en curso.
+    std::mutex state_mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    const std::function<void(std::size_t, unsigned)>* current_task = nullptr;
+    unsigned long generation = 0;
+    unsigned busy_workers = 0;
+    bool stopping = false;
+    std::atomic<std::size_t> pending{0};
+    std::exception_ptr first_error;
+};
+
+#endif // THREAD_POOL_H
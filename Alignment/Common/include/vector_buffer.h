@@ -0,0 +1,45 @@
+// vector_buffer.h
+
+#ifndef VECTOR_BUFFER_H
+#define VECTOR_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Bloque de vectores SIMD alineados, inicializados a cero, para los núcleos
+// que se compilan una vez por juego de instrucciones. Ops::vec es el tipo del
+// registro y Ops::elem el de cada carril.
+//
+// Esos núcleos instancian sus plantillas con tipos locales de un espacio de
+// nombres anónimo, así que tienen enlace interno. Por eso aquí no se usan
+// plantillas de la biblioteca estándar (vector, swap...): sus instanciaciones
+// son comunes a todo el programa y el enlazador podría quedarse con una copia
+// compilada para AVX-512.
+template <typename Ops>
+class VectorBuffer {
+public:
+    typedef typename Ops::vec vec;
+
+    explicit VectorBuffer(std::size_t count) : storage(std::calloc(count + 1, sizeof(vec))) {
+        if (!storage) {
+            throw std::bad_alloc();
+        }
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(storage);
+        address = (address + sizeof(vec) - 1) & ~static_cast<std::uintptr_t>(sizeof(vec) - 1);
+        vectors = reinterpret_cast<vec*>(address);
+    }
+    ~VectorBuffer() { std::free(storage); }
+    VectorBuffer(const VectorBuffer&) = delete;
+    VectorBuffer& operator=(const VectorBuffer&) = delete;
+
+    vec* data() { return vectors; }
+    typename Ops::elem* elements() { return reinterpret_cast<typename Ops::elem*>(vectors); }
+
+private:
+    void* storage;
+    vec* vectors;
+};
+
+#endif // VECTOR_BUFFER_H
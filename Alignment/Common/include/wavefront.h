@@ -0,0 +1,78 @@
+// wavefront.h
+
+#ifndef WAVEFRONT_H
+#define WAVEFRONT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "cpu_features.h"
+#include "thread_pool.h"
+
+// Frente de onda por bloques (tiles) para una matriz de programación dinámica
+// de filas [1, n] y columnas [1, m] (la fila y la columna 0 son el borde). El
+// bloque (ti, tj) depende sólo de (ti - 1, tj), (ti, tj - 1) y (ti - 1, tj - 1),
+// así que todos los bloques de una misma antidiagonal ti + tj se calculan en
+// paralelo.
+//
+// Los bordes entre bloques se guardan en tres vectores compartidos:
+//   top[j]     valor de la columna j en la última fila calculada de su columna
+//              de bloques (al principio, la fila 0),
+//   left[i]    valor de la fila i en la última columna calculada de su fila de
+//              bloques (al principio, la columna 0),
+//   corner     valor de la esquina superior izquierda (r0 - 1, c0 - 1) de cada
+//              bloque, que escribe el bloque de su diagonal anterior.
+// Dentro de una antidiagonal los bloques ocupan filas y columnas distintas,
+// así que nunca escriben en las mismas posiciones de top y left.
+class WavefrontGrid {
+public:
+    // `tile` debe ser múltiplo de 64: así cada bloque empieza en un byte
+    // distinto de una matriz de trazas empaquetada.
+    WavefrontGrid(std::size_t n, std::size_t m, std::size_t tile)
+        : n(n), m(m), tile(tile),
+          tile_rows(n / tile + 1), tile_cols(m / tile + 1),
+          top(m + 1), left(n + 1), corners((tile_rows + 1) * (tile_cols + 1)) {}
+
+    std::size_t row_begin(std::size_t ti) const { return std::max<std::size_t>(1, ti * tile); }
+    std::size_t row_end(std::size_t ti) const { return std::min(n + 1, (ti + 1) * tile); }
+    std::size_t col_begin(std::size_t tj) const { return std::max<std::size_t>(1, tj * tile); }
+    std::size_t col_end(std::size_t tj) const { return std::min(m + 1, (tj + 1) * tile); }
+
+    int& corner(std::size_t ti, std::size_t tj) { return corners[ti * (tile_cols + 1) + tj]; }
+
+    // Tamaño de bloque: la fila de trabajo de un bloque (enteros) ocupa como
+    // mucho una cuarta parte de la L1 de datos, pero con al menos cuatro
+    // bloques por hilo en la dimensión mayor para que haya paralelismo.
+    static std::size_t choose_tile(std::size_t n, std::size_t m, unsigned threads) {
+        const std::size_t by_cache = l1_data_cache_size() / (4 * sizeof(int));
+        const std::size_t by_threads = std::max(n, m) / (4 * static_cast<std::size_t>(threads));
+        const std::size_t tile = std::min(by_cache, by_threads) / 64 * 64;
+        return std::max<std::size_t>(tile, 64);
+    }
+
+    // Ejecuta tile_fn(ti, tj) para todos los bloques, antidiagonal a
+    // antidiagonal.
+    template <typename TileFn>
+    void run(ThreadPool& pool, TileFn tile_fn) const {
+        for (std::size_t d = 0; d + 1 < tile_rows + tile_cols; ++d) {
+            const std::size_t ti_begin = d >= tile_cols ? d - tile_cols + 1 : 0;
+            const std::size_t ti_end = std::min(d, tile_rows - 1);
+            pool.parallel_for(ti_end - ti_begin + 1, [&](std::size_t k) {
+                tile_fn(ti_begin + k, d - ti_begin - k);
+            });
+        }
+    }
+
+    const std::size_t n;
+    const std::size_t m;
+    const std::size_t tile;
+    const std::size_t tile_rows;
+    const std::size_t tile_cols;
+    std::vector<int> top;
+    std::vector<int> left;
+
+private:
+    std::vector<int> corners;
+};
+
+#endif // WAVEFRONT_H
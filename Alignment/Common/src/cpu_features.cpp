@@ -0,0 +1,54 @@
+// cpu_features.cpp
+#include "cpu_features.h"
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+SimdLevel query_simd_level() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return SIMD_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return SIMD_SSE41;
+    }
+#endif
+    return SIMD_SCALAR;
+}
+
+std::size_t query_l1_data_cache_size() {
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+    const long size = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    if (size > 0) {
+        return static_cast<std::size_t>(size);
+    }
+#endif
+    return 32 * 1024;
+}
+
+} // namespace
+
+SimdLevel detect_simd_level() {
+    static const SimdLevel level = query_simd_level();
+    return level;
+}
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SIMD_SSE41: return "SSE4.1";
+        case SIMD_AVX2: return "AVX2";
+        case SIMD_AVX512: return "AVX-512";
+        default: return "scalar";
+    }
+}
+
+std::size_t l1_data_cache_size() {
+    static const std::size_t size = query_l1_data_cache_size();
+    return size;
+}
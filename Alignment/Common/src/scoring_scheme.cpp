@@ -0,0 +1,46 @@
+// scoring_scheme.cpp
+#include <stdexcept>
+#include "scoring_scheme.h"
+
+ScoringScheme ScoringScheme::dna(int match, int mismatch, int gap_penalty) {
+    ScoringScheme scheme(DNA_PAIR_KINDS, gap_penalty);
+    for (int x = 0; x < DnaAlphabet::size; ++x) {
+        for (int y = 0; y < DnaAlphabet::size; ++y) {
+            int value = gap_penalty;
+            switch (DNA_PAIR_KINDS.score[x][y]) {
+                case DNA_MATCH: value = match; break;
+                case DNA_MISMATCH: value = mismatch; break;
+                case DNA_TRANSITION: value = -mismatch; break;
+                default: break;
+            }
+            scheme.table[x * DnaAlphabet::size + y] = value;
+        }
+    }
+    return scheme;
+}
+
+ScoringScheme ScoringScheme::blosum62(int gap_penalty) {
+    return ScoringScheme(BLOSUM62, gap_penalty);
+}
+
+ScoringScheme ScoringScheme::pam250(int gap_penalty) {
+    return ScoringScheme(PAM250, gap_penalty);
+}
+
+std::vector<std::uint8_t> ScoringScheme::encode(std::string_view sequence) const {
+    std::vector<std::uint8_t> result;
+    encode(sequence, result);
+    return result;
+}
+
+void ScoringScheme::encode(std::string_view sequence, std::vector<std::uint8_t>& result) const {
+    result.resize(sequence.size());
+    for (std::size_t k = 0; k < sequence.size(); ++k) {
+        const std::int8_t code = codes[static_cast<unsigned char>(sequence[k])];
+        if (code < 0) {
+            throw std::invalid_argument(std::string("ScoringScheme: símbolo '") + sequence[k] +
+                                        "' fuera del alfabeto");
+        }
+        result[k] = static_cast<std::uint8_t>(code);
+    }
+}
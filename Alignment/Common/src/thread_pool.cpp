@@ -0,0 +1,129 @@
+// thread_pool.cpp
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(unsigned requested_threads)
+    : num_threads(requested_threads ? requested_threads : std::thread::hardware_concurrency()) {
+    if (num_threads == 0) {
+        num_threads = 1;
+    }
+    for (unsigned w = 0; w < num_threads; ++w) {
+        queues.emplace_back(new WorkQueue());
+    }
+    // La cola 0 es la del hilo que llama a parallel_for().
+    for (unsigned w = 1; w < num_threads; ++w) {
+        threads.emplace_back(&ThreadPool::worker_loop, this, w);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::parallel_for(std::size_t count, const std::function<void(std::size_t)>& task) {
+    parallel_for_worker(count, [&task](std::size_t k, unsigned) { task(k); });
+}
+
+void ThreadPool::parallel_for_worker(std::size_t count,
+                                     const std::function<void(std::size_t, unsigned)>& task) {
+    if (count == 0) {
+        return;
+    }
+
+    for (std::size_t k = 0; k < count; ++k) {
+        queues[k % num_threads]->tasks.push_back(k);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        current_task = &task;
+        first_error = nullptr;
+        pending = count;
+        busy_workers = num_threads - 1;
+        ++generation;
+    }
+    work_ready.notify_all();
+
+    run_tasks(0);
+
+    // Esperar también a que los demás hilos suelten la referencia a `task`.
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(state_mutex);
+        work_done.wait(lock, [this] { return busy_workers == 0; });
+        current_task = nullptr;
+        error = first_error;
+        first_error = nullptr;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::worker_loop(unsigned worker) {
+    unsigned long seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(state_mutex);
+            work_ready.wait(lock, [&] { return stopping || generation != seen_generation; });
+            if (stopping) {
+                return;
+            }
+            seen_generation = generation;
+        }
+
+        run_tasks(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            if (--busy_workers == 0) {
+                work_done.notify_all();
+            }
+        }
+    }
+}
+
+void ThreadPool::run_tasks(unsigned worker) {
+    std::size_t index;
+    while (pending > 0 && pop_task(worker, index)) {
+        try {
+            (*current_task)(index, worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            if (!first_error) {
+                first_error = std::current_exception();
+            }
+        }
+        --pending;
+    }
+}
+
+bool ThreadPool::pop_task(unsigned worker, std::size_t& index) {
+    {
+        WorkQueue& own = *queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            index = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    // Robar la tarea más barata (la última) de la siguiente cola con trabajo.
+    for (unsigned offset = 1; offset < num_threads; ++offset) {
+        WorkQueue& victim = *queues[(worker + offset) % num_threads];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            index = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,75 @@
+// distance_matrix.h
+
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Matriz de distancias simétrica guardada de forma condensada: sólo el
+// triángulo inferior estricto, fila a fila, en un único bloque de floats
+// (n·(n-1)/2 celdas, la mitad de memoria que la matriz completa y la mitad
+// otra vez que con double). La fila i ocupa las celdas (i, 0..i-1) a partir
+// de i·(i-1)/2, de modo que la matriz de n-1 elementos es un prefijo de la de
+// n: quitar un elemento (remove()) no reserva ni mueve memoria salvo una fila.
+class DistanceMatrix {
+public:
+    DistanceMatrix() = default;
+    explicit DistanceMatrix(std::size_t n) { resize(n); }
+
+    // Redimensiona la matriz y pone todas las distancias a 0.
+    void resize(std::size_t n) {
+        num_elements = n;
+        cells.assign(n > 1 ? n * (n - 1) / 2 : 0, 0.0f);
+    }
+
+    std::size_t size() const { return num_elements; }
+    std::size_t size_bytes() const { return cells.capacity() * sizeof(float); }
+
+    float operator()(std::size_t i, std::size_t j) const {
+        return i == j ? 0.0f : cells[index(i, j)];
+    }
+
+    void set(std::size_t i, std::size_t j, float distance) {
+        cells[index(i, j)] = distance;
+    }
+
+    // Distancias (i, 0..i-1), contiguas.
+    float* row(std::size_t i) { return cells.data() + i * (i - 1) / 2; }
+    const float* row(std::size_t i) const { return cells.data() + i * (i - 1) / 2; }
+
+    // Quita el elemento k moviendo el último a su posición: las distancias
+    // del último pasan a ser las de k y la matriz pierde una fila. El llamante
+    // debe reflejar el mismo cambio de índices en sus propias tablas.
+    void remove(std::size_t k) {
+        const std::size_t last = num_elements - 1;
+        if (k != last) {
+            for (std::size_t j = 0; j < last; ++j) {
+                if (j != k) {
+                    set(k, j, (*this)(last, j));
+                }
+            }
+        }
+        num_elements = last;
+        cells.resize(last > 1 ? last * (last - 1) / 2 : 0);
+    }
+
+    bool operator==(const DistanceMatrix& other) const {
+        return num_elements == other.num_elements && cells == other.cells;
+    }
+    bool operator!=(const DistanceMatrix& other) const { return !(*this == other); }
+
+private:
+    static std::size_t index(std::size_t i, std::size_t j) {
+        if (i < j) {
+            std::swap(i, j);
+        }
+        return i * (i - 1) / 2 + j;
+    }
+
+    std::vector<float> cells;
+    std::size_t num_elements = 0;
+};
+
+#endif // DISTANCE_MATRIX_H
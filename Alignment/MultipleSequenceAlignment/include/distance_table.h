@@ -0,0 +1,22 @@
+// distance_table.h
+
+#ifndef DISTANCE_TABLE_H
+#define DISTANCE_TABLE_H
+
+#include <string>
+#include <vector>
+#include "distance_matrix.h"
+
+// Lee una tabla de distancias por parejas en el formato CSV que escribe
+// kmer_genetic_distance/scripts/kmer_counter.py (cabecera
+// "Org_1,Org_2,Measure,Value", una fila por pareja y medida) y devuelve la
+// matriz de la medida `measure`. `ids` recibe los nombres en el orden de las
+// filas de la matriz, según aparecen en el fichero. Las medidas de similitud
+// ("Pearson Correlation") se convierten en distancias como 1 - r.
+//
+// Lanza std::runtime_error si no se puede leer el fichero y
+// std::invalid_argument si falta alguna pareja de la medida pedida.
+DistanceMatrix read_distance_table(const std::string& path, const std::string& measure,
+                                   std::vector<std::string>& ids);
+
+#endif // DISTANCE_TABLE_H
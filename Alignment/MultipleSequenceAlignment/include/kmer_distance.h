@@ -0,0 +1,45 @@
+// kmer_distance.h
+
+#ifndef KMER_DISTANCE_H
+#define KMER_DISTANCE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "distance_matrix.h"
+
+// Medidas de distancia sin alineamiento entre dos secuencias de ADN.
+enum KmerMeasure {
+    KMER_MASH,       // Distancia de Mash a partir de la Jaccard estimada con esbozos MinHash (k-meros canónicos)
+    KMER_EUCLIDEAN,  // Euclídea entre los perfiles de frecuencias de k-meros
+    KMER_MANHATTAN,  // Manhattan entre los perfiles de frecuencias
+    KMER_PEARSON     // 1 - correlación de Pearson entre los perfiles de frecuencias
+};
+
+struct KmerDistanceOptions {
+    KmerMeasure measure = KMER_MASH;
+    unsigned k = 21;                 // Longitud de los k-meros, de 1 a 31
+    std::size_t sketch_size = 1000;  // Hashes de cada esbozo MinHash (sólo KMER_MASH)
+    unsigned num_threads = 0;        // 0 = hardware concurrency
+};
+
+// Matriz de distancias entre `sequences` calculada a partir de sus k-meros,
+// sin alinearlas: cada secuencia se resume una sola vez (en paralelo) y cada
+// pareja se compara en tiempo proporcional al tamaño de los resúmenes, no al
+// producto de las longitudes como en la programación dinámica.
+//
+// Con KMER_MASH el resumen es el esbozo "bottom-s" (los `sketch_size` hashes
+// menores de los k-meros canónicos) y la distancia la de Mash (Ondov et al.,
+// 2016), D = -ln(2j / (1 + j)) / k, acotada a 1 cuando no hay k-meros en
+// común. Las demás medidas usan el perfil completo de frecuencias de cada
+// secuencia (apariciones / (longitud - k + 1), k-meros en la hebra directa)
+// sobre la unión de los k-meros de las dos, como
+// kmer_genetic_distance/scripts/kmer_counter.py, aunque sin descartar las
+// frecuencias menores de 1e-4.
+//
+// Los símbolos que no son A, C, G o T (en mayúsculas o minúsculas) cortan
+// los k-meros que los contienen. El resultado no depende del número de hilos.
+// Lanza std::invalid_argument si k no está en [1, 31] o sketch_size es 0.
+DistanceMatrix kmer_distance_matrix(const std::vector<std::string>& sequences, const KmerDistanceOptions& options);
+
+#endif // KMER_DISTANCE_H
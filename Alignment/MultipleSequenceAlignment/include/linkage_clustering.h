@@ -0,0 +1,40 @@
+// linkage_clustering.h
+
+#ifndef LINKAGE_CLUSTERING_H
+#define LINKAGE_CLUSTERING_H
+
+#include <cstddef>
+#include <vector>
+#include "distance_matrix.h"
+
+// Criterio de distancia entre un grupo recién formado (a ∪ b) y otro k, en
+// forma de Lance-Williams.
+enum LinkageMethod {
+    LINKAGE_UPGMA,     // Media de todas las parejas: (|a| d(a, k) + |b| d(b, k)) / (|a| + |b|)
+    LINKAGE_WPGMA,     // Media de los dos grupos: (d(a, k) + d(b, k)) / 2
+    LINKAGE_SINGLE,    // Mínimo: min(d(a, k), d(b, k))
+    LINKAGE_COMPLETE   // Máximo: max(d(a, k), d(b, k))
+};
+
+// Una unión del agrupamiento. Los grupos se numeran como en scipy: 0..n-1 son
+// los elementos originales y n + k el formado por la unión k.
+struct ClusterMerge {
+    std::size_t first;
+    std::size_t second;
+    double distance;   // Distancia entre los dos grupos al unirlos
+    std::size_t size;  // Elementos del nuevo grupo
+};
+
+// Agrupamiento jerárquico aglomerativo con cadenas de vecinos más cercanos
+// (nearest-neighbour chain): O(n^2) en tiempo en vez de O(n^3), válido para
+// los cuatro criterios porque todos son reducibles. Trabaja sobre `distances`
+// en el sitio, compactándola como NeighbourJoining (al terminar queda con un
+// único elemento), así que no necesita memoria adicional de orden n^2.
+//
+// Devuelve las n - 1 uniones en el orden en que se encuentran, que no es
+// necesariamente el de distancia creciente; cada unión sólo usa grupos de
+// uniones anteriores. Sin empates el resultado es la misma jerarquía que la
+// del algoritmo ingenuo que une siempre la pareja más cercana.
+std::vector<ClusterMerge> linkage_clustering(DistanceMatrix& distances, LinkageMethod method);
+
+#endif // LINKAGE_CLUSTERING_H
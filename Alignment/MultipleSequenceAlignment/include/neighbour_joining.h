@@ -5,7 +5,23 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include "distance_matrix.h"
+#include "kmer_distance.h"
+#include "linkage_clustering.h"
+#include "rapid_nj_search.h"
 #include "needleman_wunsch.h"
+#include "scoring_scheme.h"
+
+struct MultipleAlignment;  // progressive_alignment.h
+
+// Tree-building strategies for NeighbourJoining::construct_tree()
+enum TreeMethod {
+    TREE_NEIGHBOUR_JOINING,  // Additive tree from the NJ Q-criterion (default), O(n^3) or RapidNJ
+    TREE_UPGMA,              // Ultrametric trees from linkage_clustering(), O(n^2)
+    TREE_WPGMA,
+    TREE_SINGLE_LINKAGE,
+    TREE_COMPLETE_LINKAGE
+};
 
 class NeighbourJoining {
 public:
@@ -15,28 +31,67 @@ public:
         Node* right_child = nullptr;  // Pointer to the right child in the tree
         std::string sequence;  // The DNA or protein sequence represented by this node
         int depth = 0;  // Depth of the node in the tree, useful for visual representation
+        double branch_length = 0.0;  // Length of the edge to the parent node
         bool active = true;  // Flag to indicate if the node is active in the current context
     };
 
     NeighbourJoining(const std::unordered_map<std::string, std::string>& sequence_map);
-    void calculate_distance_matrix();  // Computes the pairwise distance matrix using Needleman-Wunsch
+    // Same, with the scoring scheme used for every pairwise alignment (DNA 3/-1/-2 by default)
+    NeighbourJoining(const std::unordered_map<std::string, std::string>& sequence_map,
+                     const ScoringScheme& scoring_scheme);
+    ~NeighbourJoining();
+    NeighbourJoining(const NeighbourJoining&) = delete;
+    NeighbourJoining& operator=(const NeighbourJoining&) = delete;
+    // Use banded alignment (adaptive, starting at initial_width) for the distance step; 0 = full DP
+    void set_band_width(size_t initial_width);
+    // Threads used by the distance matrix calculations and align_sequences(); 0 = hardware concurrency (default)
+    void set_num_threads(unsigned num_threads);
+    // Tree-building strategy used by construct_tree() and build_tree() (NJ by default)
+    void set_tree_method(TreeMethod method);
+    // Find each join with a RapidNJ-style bounded search over sorted rows (same tree as the exhaustive
+    // search, much faster on large inputs). A non-empty spill_directory keeps the sorted rows in a
+    // memory-mapped temporary file there instead of in RAM
+    void set_rapid_search(bool enabled, const std::string& spill_directory = "");
+    // Computes the pairwise distance matrix using Needleman-Wunsch, in parallel. Scores are turned
+    // into distances as d(a, b) = (s(a, a) + s(b, b)) / 2 - s(a, b), clamped at 0
+    void calculate_distance_matrix();
+    // Alignment-free alternative: distances from k-mer profiles or MinHash sketches (see
+    // kmer_distance_matrix()), with the threads given to set_num_threads()
+    void calculate_kmer_distance_matrix(const KmerDistanceOptions& options);
+    // Uses precomputed distances instead (one row per sequence, in the order of get_sequence_ids())
+    void set_distance_matrix(const DistanceMatrix& distances);
+    const DistanceMatrix& get_distance_matrix() const;  // Current (shrinking) distance matrix
+    std::vector<std::string> get_sequence_ids() const;  // Leaf ids, in distance matrix order
     void print_distance_matrix() const;  // Outputs the current distance matrix to the console
-    void join_smallest_distance_nodes();  // Merges the two nodes with the smallest distance
-    void build_tree();  // Constructs the phylogenetic tree by iteratively merging nodes
+    void join_smallest_distance_nodes();  // Merges the pair of active nodes that minimises the NJ Q-criterion
+    Node* construct_tree();  // Joins nodes until one is left and returns the root (owned by this object)
+    void build_tree();  // Constructs, prints and aligns the phylogenetic tree
+    // Progressive multiple alignment of the leaves along the tree rooted at root (see progressive_alignment())
+    MultipleAlignment align_sequences(const Node* root) const;
     std::vector<Node*> get_alignment_order(Node* node);  // Returns the order of nodes for alignment
+    std::string generate_newick_format(Node* node);  // Generates a Newick format string for the tree
 
 private:
+    ScoringScheme scoring;  // Scoring scheme shared by all pairwise alignments
+    size_t band_width = 0;  // Initial band for the distance alignments (0 = full DP)
+    unsigned num_threads = 0;  // Threads for the distance and alignment steps (0 = hardware concurrency)
+    TreeMethod tree_method = TREE_NEIGHBOUR_JOINING;  // Strategy used by construct_tree()
+    bool rapid_search = false;  // Use RapidNJSearch instead of the exhaustive Q scan
+    std::string spill_directory;  // Where RapidNJSearch keeps its sorted rows ("" = memory)
+    std::unique_ptr<RapidNJSearch> rapid;  // Sorted rows of the joins in progress, if rapid_search
+    bool has_distances = false;  // Whether distance_matrix holds the initial distances
     std::vector<std::string> sequences;  // Stores the original sequences
-    std::unique_ptr<std::vector<std::vector<int>>> distance_matrix;  // Matrix of distances between sequences
-    std::vector<Node*> nodes;  // Vector of nodes corresponding to the sequences
-    std::vector<Node*> active_nodes;  // Nodes that are currently active and part of the ongoing tree construction
-    void update_active_nodes();  // Updates the list of active nodes after a merging event
-    std::pair<int, int> find_smallest_distance_pair();  // Finds the indices of the closest pair of nodes
-    void create_new_node(int min_i, int min_j);  // Creates a new node by merging two nodes
-    std::unique_ptr<std::vector<std::vector<int>>> create_new_distance_matrix(int min_i, int min_j);  // Creates a new distance matrix post node merging
+    std::vector<std::string> sequence_ids;  // Identifier of each sequence, same order
+    DistanceMatrix distance_matrix;  // Distances between active nodes, compacted in place on every join
+    std::vector<double> row_sums;  // Sum of each row of distance_matrix, kept up to date on every join
+    std::vector<Node*> nodes;  // Every node created so far (leaves first)
+    std::vector<Node*> active_nodes;  // Node held by each row of distance_matrix
+    void start_joining();  // Creates the active node list and the row sums for a fresh matrix
+    std::pair<size_t, size_t> find_min_q_pair() const;  // Rows (i > j) that minimise the Q-criterion
+    void join_rows(size_t i, size_t j);  // Merges rows i and j into a new node, updating the matrix in place
+    Node* create_parent(Node* left, Node* right, double left_length, double right_length);  // New internal node
+    void build_linkage_tree();  // Builds the whole tree with linkage_clustering() (non-NJ methods)
     void print_tree(Node* node, std::string prefix = "", bool is_left = false);  // Helper function to print the tree for debugging
-    std::string align_sequences();  // Function to perform the final sequence alignment
-    std::string generate_newick_format(Node* node);  // Generates a Newick format string for the tree
 };
 
 #endif // NEIGHBOUR_JOINING_H
@@ -0,0 +1,40 @@
+// progressive_alignment.h
+
+#ifndef PROGRESSIVE_ALIGNMENT_H
+#define PROGRESSIVE_ALIGNMENT_H
+
+#include <string>
+#include <vector>
+#include "neighbour_joining.h"
+#include "scoring_scheme.h"
+
+// Alineamiento múltiple: una fila por secuencia, todas de la misma longitud,
+// con '-' en los huecos.
+struct MultipleAlignment {
+    std::vector<std::string> ids;
+    std::vector<std::string> rows;
+};
+
+// Alineamiento múltiple progresivo a lo largo de un árbol guía: cada nodo
+// interno alinea los perfiles de sus dos hijos con programación dinámica
+// perfil-perfil y el resultado es el perfil del nodo. Un perfil guarda, por
+// columna, la frecuencia de cada símbolo (gap incluido); la puntuación de dos
+// columnas es la media de las de todas las parejas de símbolos, con la tabla
+// de `scoring` y 0 para gap frente a gap (suma de parejas). Los huecos que se
+// abren en un perfil se propagan a todas sus secuencias ("once a gap, always
+// a gap"). Con dos secuencias la puntuación es la de NeedlemanWunsch.
+//
+// Los nodos se procesan por niveles (altura en el árbol) y los de un mismo
+// nivel, independientes entre sí, en paralelo con `num_threads` hilos
+// (0 = hardware concurrency). El resultado no depende del número de hilos.
+// Las hojas toman la secuencia de Node::sequence, sin los '-' que ya traiga
+// (se vuelve a alinear entera).
+MultipleAlignment progressive_alignment(const NeighbourJoining::Node* root, const ScoringScheme& scoring,
+                                        unsigned num_threads = 0);
+
+// Puntuación de suma de parejas de un alineamiento múltiple: símbolo frente a
+// símbolo según la tabla, símbolo frente a gap la penalización de gap y gap
+// frente a gap 0.
+long long sum_of_pairs_score(const MultipleAlignment& alignment, const ScoringScheme& scoring);
+
+#endif // PROGRESSIVE_ALIGNMENT_H
@@ -0,0 +1,86 @@
+// rapid_nj_search.h
+
+#ifndef RAPID_NJ_SEARCH_H
+#define RAPID_NJ_SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "distance_matrix.h"
+
+// Búsqueda acotada del mínimo de Q para Neighbour Joining, al estilo de
+// RapidNJ (Simonsen, Mailund y Pedersen, 2008). Cada fila guarda, ordenadas
+// de menor a mayor distancia, sus distancias a los nodos que ya existían
+// cuando se creó (así cada pareja aparece una sola vez). Como
+//
+//     Q(i, j) = (n - 2) d(i, j) - r(i) - r(j) >= (n - 2) d(i, j) - r(i) - max r,
+//
+// al recorrer la fila i en orden se puede parar en cuanto esa cota supera el
+// mínimo encontrado: normalmente sólo se miran las primeras entradas de cada
+// fila, y la primera entrada de cada una, guardada aparte, permite saltarse
+// filas enteras sin leerlas. Las entradas de nodos ya unidos se descartan al
+// pasar y se eliminan de golpe cuando el espacio reservado se llena.
+//
+// El resultado es exactamente el de la búsqueda exhaustiva de
+// NeighbourJoining, empates incluidos: Q se calcula con las mismas
+// operaciones y el orden entre parejas es el mismo (ver find_min_q()).
+//
+// Las filas ordenadas ocupan unas 1,5 veces n^2 / 2 entradas de 8 bytes, el
+// triple que la matriz condensada. Con `spill_directory` no vacío se guardan
+// en un fichero temporal de ese directorio proyectado en memoria (mmap), de
+// modo que el sistema puede llevarlas a disco en vez de agotar la RAM.
+class RapidNJSearch {
+public:
+    explicit RapidNJSearch(const std::string& spill_directory = "");
+    ~RapidNJSearch();
+    RapidNJSearch(const RapidNJSearch&) = delete;
+    RapidNJSearch& operator=(const RapidNJSearch&) = delete;
+
+    // Prepara las filas ordenadas a partir de la matriz inicial.
+    void build(const DistanceMatrix& distances);
+
+    // Filas (i > j) de la matriz que minimizan Q. No es const porque de paso
+    // descarta las entradas muertas del principio de cada fila.
+    std::pair<std::size_t, std::size_t> find_min_q(const DistanceMatrix& distances,
+                                                   const std::vector<double>& row_sums);
+
+    // Refleja una unión ya aplicada a la matriz: el nuevo nodo ocupa la fila
+    // j y la antigua última fila ha pasado a la i.
+    void join(const DistanceMatrix& distances, std::size_t i, std::size_t j);
+
+    // Entradas examinadas por la última llamada a find_min_q().
+    std::size_t last_visited() const { return visited; }
+
+private:
+    struct Entry {
+        float distance;
+        std::uint32_t node;
+    };
+
+    void allocate(std::size_t capacity);
+    void release();
+    void append_row(std::size_t slot, const DistanceMatrix& distances);
+    void compact();
+    void update_head(std::size_t slot);
+
+    std::string spill_directory;
+    Entry* entries = nullptr;  // Todas las filas, una tras otra
+    std::size_t capacity = 0;
+    std::size_t used = 0;
+    std::vector<Entry> memory;  // Almacenamiento sin fichero
+    void* mapping = nullptr;  // Almacenamiento con fichero
+    std::size_t mapping_bytes = 0;
+
+    std::vector<std::uint32_t> slot_node;  // Nodo de cada fila de la matriz
+    std::vector<std::size_t> row_begin;  // Primera entrada de cada fila
+    std::vector<std::size_t> row_length;  // Entradas de cada fila, vivas o no
+    std::vector<float> head_distance;  // Distancia de la primera entrada de cada fila
+    std::vector<std::uint32_t> head_node;  // Nodo de la primera entrada de cada fila
+    std::vector<std::int64_t> node_slot;  // Fila de cada nodo, -1 si ya se unió
+    std::uint32_t next_node = 0;  // Los nodos 0..n-1 son las hojas; cada unión crea el siguiente
+    std::size_t visited = 0;
+};
+
+#endif // RAPID_NJ_SEARCH_H
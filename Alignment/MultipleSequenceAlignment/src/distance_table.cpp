@@ -0,0 +1,72 @@
+// distance_table.cpp
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include "distance_table.h"
+
+DistanceMatrix read_distance_table(const std::string& path, const std::string& measure,
+                                   std::vector<std::string>& ids) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("read_distance_table: no se pudo abrir " + path);
+    }
+
+    struct Pair {
+        std::size_t first;
+        std::size_t second;
+        double value;
+    };
+    std::vector<Pair> pairs;
+    std::unordered_map<std::string, std::size_t> index;
+    ids.clear();
+    auto id_index = [&](const std::string& id) {
+        auto found = index.find(id);
+        if (found != index.end()) {
+            return found->second;
+        }
+        index.emplace(id, ids.size());
+        ids.push_back(id);
+        return ids.size() - 1;
+    };
+
+    const bool similarity = measure == "Pearson Correlation";
+    std::string line;
+    std::getline(file, line);  // Cabecera
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::istringstream fields(line);
+        std::string first, second, row_measure, value;
+        if (!std::getline(fields, first, ',') || !std::getline(fields, second, ',') ||
+            !std::getline(fields, row_measure, ',') || !std::getline(fields, value)) {
+            continue;
+        }
+        // Todos los nombres cuentan, aunque la fila sea de otra medida.
+        const std::size_t i = id_index(first);
+        const std::size_t j = id_index(second);
+        if (row_measure == measure) {
+            const double v = std::stod(value);
+            pairs.push_back(Pair{i, j, similarity ? 1.0 - v : v});
+        }
+    }
+
+    DistanceMatrix distances(ids.size());
+    std::vector<char> seen(ids.size() * ids.size(), 0);
+    for (const Pair& p : pairs) {
+        if (p.first != p.second) {
+            distances.set(p.first, p.second, static_cast<float>(p.value));
+            seen[p.first * ids.size() + p.second] = seen[p.second * ids.size() + p.first] = 1;
+        }
+    }
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            if (!seen[i * ids.size() + j]) {
+                throw std::invalid_argument("read_distance_table: falta la distancia " + measure + " entre " +
+                                            ids[i] + " y " + ids[j]);
+            }
+        }
+    }
+    return distances;
+}
@@ -0,0 +1,227 @@
+// kmer_distance.cpp
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include "kmer_distance.h"
+#include "thread_pool.h"
+
+namespace {
+
+// Código de 2 bits de cada base; 4 para el resto de símbolos.
+std::uint8_t base_code(char c) {
+    switch (c) {
+        case 'A': case 'a': return 0;
+        case 'C': case 'c': return 1;
+        case 'G': case 'g': return 2;
+        case 'T': case 't': return 3;
+        default: return 4;
+    }
+}
+
+// Llama a emit(directo, complementario inverso) con los códigos de 2 bits de
+// cada k-mero válido de la secuencia.
+template <typename Emit>
+void for_each_kmer(const std::string& sequence, unsigned k, Emit emit) {
+    const std::uint64_t mask = (std::uint64_t(1) << (2 * k)) - 1;
+    const unsigned reverse_shift = 2 * (k - 1);
+    std::uint64_t forward = 0;
+    std::uint64_t reverse = 0;
+    unsigned valid = 0;
+    for (char c : sequence) {
+        const std::uint8_t code = base_code(c);
+        if (code > 3) {
+            valid = 0;
+            continue;
+        }
+        forward = ((forward << 2) | code) & mask;
+        reverse = (reverse >> 2) | (std::uint64_t(3 - code) << reverse_shift);
+        if (++valid >= k) {
+            emit(forward, reverse);
+        }
+    }
+}
+
+// Mezcla de 64 bits (finalizador de splitmix64): reparte uniformemente los
+// códigos de los k-meros para que los menores hashes sean una muestra al azar.
+std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Los `size` hashes menores y distintos de los k-meros canónicos, ordenados.
+std::vector<std::uint64_t> sketch(const std::string& sequence, unsigned k, std::size_t size) {
+    std::vector<std::uint64_t> hashes;
+    std::uint64_t threshold = std::numeric_limits<std::uint64_t>::max();
+    bool full = false;
+    auto shrink = [&]() {
+        std::sort(hashes.begin(), hashes.end());
+        hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+        if (hashes.size() >= size) {
+            hashes.resize(size);
+            threshold = hashes.back();
+            full = true;
+        }
+    };
+    for_each_kmer(sequence, k, [&](std::uint64_t forward, std::uint64_t reverse) {
+        const std::uint64_t hash = mix(std::min(forward, reverse));
+        if (!full || hash < threshold) {
+            hashes.push_back(hash);
+            if (hashes.size() >= 4 * size) {
+                shrink();
+            }
+        }
+    });
+    shrink();
+    return hashes;
+}
+
+// Jaccard estimada como en Mash: de los `size` hashes menores de la unión
+// de los dos esbozos, fracción de los que están en ambos.
+double jaccard(const std::vector<std::uint64_t>& a, const std::vector<std::uint64_t>& b, std::size_t size) {
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t shared = 0;
+    std::size_t seen = 0;
+    // Sin ramas en el bucle: el orden de los hashes es aleatorio y los saltos
+    // se predecirían mal.
+    while (seen < size && i < a.size() && j < b.size()) {
+        const std::uint64_t x = a[i];
+        const std::uint64_t y = b[j];
+        shared += x == y;
+        i += x <= y;
+        j += y <= x;
+        ++seen;
+    }
+    // Agotado uno de los dos, el resto de la unión no tiene hashes comunes.
+    seen += std::min(size - seen, (a.size() - i) + (b.size() - j));
+    return seen == 0 ? 1.0 : static_cast<double>(shared) / static_cast<double>(seen);
+}
+
+double mash_distance(double j, unsigned k) {
+    if (j <= 0.0) {
+        return 1.0;
+    }
+    return std::min(1.0, -std::log(2.0 * j / (1.0 + j)) / static_cast<double>(k));
+}
+
+// Perfil de frecuencias: k-meros presentes, ordenados por código.
+struct Profile {
+    std::vector<std::uint64_t> kmers;
+    std::vector<double> frequencies;
+};
+
+Profile frequency_profile(const std::string& sequence, unsigned k) {
+    std::vector<std::uint64_t> codes;
+    codes.reserve(sequence.size());
+    for_each_kmer(sequence, k, [&](std::uint64_t forward, std::uint64_t) { codes.push_back(forward); });
+    std::sort(codes.begin(), codes.end());
+
+    Profile profile;
+    const double total = sequence.size() >= k ? static_cast<double>(sequence.size() - k + 1) : 1.0;
+    for (std::size_t begin = 0; begin < codes.size();) {
+        std::size_t end = begin;
+        while (end < codes.size() && codes[end] == codes[begin]) {
+            ++end;
+        }
+        profile.kmers.push_back(codes[begin]);
+        profile.frequencies.push_back(static_cast<double>(end - begin) / total);
+        begin = end;
+    }
+    return profile;
+}
+
+// Compara dos perfiles recorriendo la unión de sus k-meros en orden.
+double profile_distance(const Profile& a, const Profile& b, KmerMeasure measure) {
+    double squares = 0.0;
+    double absolute = 0.0;
+    double sum_a = 0.0;
+    double sum_b = 0.0;
+    double sum_aa = 0.0;
+    double sum_bb = 0.0;
+    double sum_ab = 0.0;
+    std::size_t count = 0;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < a.kmers.size() || j < b.kmers.size()) {
+        double x = 0.0;
+        double y = 0.0;
+        if (j == b.kmers.size() || (i < a.kmers.size() && a.kmers[i] < b.kmers[j])) {
+            x = a.frequencies[i++];
+        } else if (i == a.kmers.size() || b.kmers[j] < a.kmers[i]) {
+            y = b.frequencies[j++];
+        } else {
+            x = a.frequencies[i++];
+            y = b.frequencies[j++];
+        }
+        squares += (x - y) * (x - y);
+        absolute += std::abs(x - y);
+        sum_a += x;
+        sum_b += y;
+        sum_aa += x * x;
+        sum_bb += y * y;
+        sum_ab += x * y;
+        ++count;
+    }
+
+    switch (measure) {
+        case KMER_EUCLIDEAN:
+            return std::sqrt(squares);
+        case KMER_MANHATTAN:
+            return absolute;
+        case KMER_PEARSON:
+        default: {
+            const double n = static_cast<double>(count);
+            const double covariance = sum_ab - sum_a * sum_b / n;
+            const double variance_a = sum_aa - sum_a * sum_a / n;
+            const double variance_b = sum_bb - sum_b * sum_b / n;
+            if (count < 2 || variance_a <= 0.0 || variance_b <= 0.0) {
+                return 1.0;  // Correlación indefinida: se trata como r = 0
+            }
+            return 1.0 - covariance / std::sqrt(variance_a * variance_b);
+        }
+    }
+}
+
+} // namespace
+
+DistanceMatrix kmer_distance_matrix(const std::vector<std::string>& sequences, const KmerDistanceOptions& options) {
+    if (options.k < 1 || options.k > 31) {
+        throw std::invalid_argument("kmer_distance_matrix: k debe estar entre 1 y 31");
+    }
+    if (options.measure == KMER_MASH && options.sketch_size == 0) {
+        throw std::invalid_argument("kmer_distance_matrix: el esbozo no puede estar vacío");
+    }
+
+    const std::size_t n = sequences.size();
+    DistanceMatrix distances(n);
+    ThreadPool pool(options.num_threads);
+
+    // Como en calculate_distance_matrix(), las filas más largas primero.
+    if (options.measure == KMER_MASH) {
+        std::vector<std::vector<std::uint64_t>> sketches(n);
+        pool.parallel_for(n, [&](std::size_t i) { sketches[i] = sketch(sequences[i], options.k, options.sketch_size); });
+        pool.parallel_for(n, [&](std::size_t t) {
+            const std::size_t i = n - 1 - t;
+            for (std::size_t j = 0; j < i; ++j) {
+                const double j_estimate = jaccard(sketches[i], sketches[j], options.sketch_size);
+                distances.set(i, j, static_cast<float>(mash_distance(j_estimate, options.k)));
+            }
+        });
+    } else {
+        std::vector<Profile> profiles(n);
+        pool.parallel_for(n, [&](std::size_t i) { profiles[i] = frequency_profile(sequences[i], options.k); });
+        pool.parallel_for(n, [&](std::size_t t) {
+            const std::size_t i = n - 1 - t;
+            for (std::size_t j = 0; j < i; ++j) {
+                distances.set(i, j, static_cast<float>(profile_distance(profiles[i], profiles[j], options.measure)));
+            }
+        });
+    }
+    return distances;
+}
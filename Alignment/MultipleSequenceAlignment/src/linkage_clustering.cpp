@@ -0,0 +1,108 @@
+// linkage_clustering.cpp
+#include <algorithm>
+#include <limits>
+#include "linkage_clustering.h"
+
+namespace {
+
+double lance_williams(LinkageMethod method, double d_ak, double d_bk, std::size_t size_a, std::size_t size_b) {
+    switch (method) {
+        case LINKAGE_UPGMA:
+            return (static_cast<double>(size_a) * d_ak + static_cast<double>(size_b) * d_bk) /
+                   static_cast<double>(size_a + size_b);
+        case LINKAGE_WPGMA:
+            return 0.5 * (d_ak + d_bk);
+        case LINKAGE_SINGLE:
+            return std::min(d_ak, d_bk);
+        case LINKAGE_COMPLETE:
+        default:
+            return std::max(d_ak, d_bk);
+    }
+}
+
+} // namespace
+
+std::vector<ClusterMerge> linkage_clustering(DistanceMatrix& distances, LinkageMethod method) {
+    const std::size_t n = distances.size();
+    const std::size_t none = std::numeric_limits<std::size_t>::max();
+    std::vector<ClusterMerge> merges;
+    merges.reserve(n > 0 ? n - 1 : 0);
+
+    // Grupo y tamaño de cada fila de la matriz.
+    std::vector<std::size_t> slot_cluster(n);
+    std::vector<std::size_t> slot_size(n, 1);
+    for (std::size_t s = 0; s < n; ++s) {
+        slot_cluster[s] = s;
+    }
+
+    // Cadena de vecinos más cercanos: cada elemento es el vecino más cercano
+    // del anterior. Cuando los dos últimos son vecinos mutuos se unen; con un
+    // criterio reducible el resto de la cadena sigue siendo válido.
+    std::vector<std::size_t> chain;
+    chain.reserve(n);
+    while (distances.size() > 1) {
+        if (chain.empty()) {
+            chain.push_back(0);
+        }
+        const std::size_t a = chain.back();
+        const std::size_t previous = chain.size() >= 2 ? chain[chain.size() - 2] : none;
+
+        // En caso de empate gana el elemento anterior de la cadena; si no, la
+        // cadena podría no terminar nunca.
+        std::size_t b = previous;
+        float nearest = previous != none ? distances(a, previous) : std::numeric_limits<float>::infinity();
+        const float* row = distances.row(a);
+        for (std::size_t k = 0; k < a; ++k) {
+            if (row[k] < nearest) {
+                nearest = row[k];
+                b = k;
+            }
+        }
+        for (std::size_t k = a + 1; k < distances.size(); ++k) {
+            const float d = distances(a, k);
+            if (d < nearest) {
+                nearest = d;
+                b = k;
+            }
+        }
+
+        if (b != previous) {
+            chain.push_back(b);
+            continue;
+        }
+        chain.pop_back();
+        chain.pop_back();
+
+        const std::size_t size = slot_size[a] + slot_size[b];
+        merges.push_back(ClusterMerge{std::min(slot_cluster[a], slot_cluster[b]),
+                                      std::max(slot_cluster[a], slot_cluster[b]), nearest, size});
+
+        // El nuevo grupo ocupa la fila menor; la mayor desaparece y la última
+        // pasa a su lugar.
+        const std::size_t low = std::min(a, b);
+        const std::size_t high = std::max(a, b);
+        for (std::size_t k = 0; k < distances.size(); ++k) {
+            if (k != a && k != b) {
+                distances.set(low, k, static_cast<float>(lance_williams(method, distances(a, k), distances(b, k),
+                                                                        slot_size[a], slot_size[b])));
+            }
+        }
+        slot_cluster[low] = n + merges.size() - 1;
+        slot_size[low] = size;
+
+        const std::size_t last = distances.size() - 1;
+        distances.remove(high);
+        if (high != last) {
+            slot_cluster[high] = slot_cluster[last];
+            slot_size[high] = slot_size[last];
+            for (std::size_t& element : chain) {
+                if (element == last) {
+                    element = high;
+                }
+            }
+        }
+        slot_cluster.pop_back();
+        slot_size.pop_back();
+    }
+    return merges;
+}
@@ -3,13 +3,22 @@
 #include <string>
 #include <unordered_map>  // Add this line
 #include "../include/neighbour_joining.h"
+#include "nw_batch.h"
+#include "progressive_alignment.h"
+#include "thread_pool.h"
 #include <limits>
 #include <algorithm>
+#include <stdexcept>
 
-NeighbourJoining::NeighbourJoining(const std::unordered_map<std::string, std::string>& sequence_map) {
+NeighbourJoining::NeighbourJoining(const std::unordered_map<std::string, std::string>& sequence_map)
+    : NeighbourJoining(sequence_map, ScoringScheme::dna(3, -1, -2)) {
+}
+
+NeighbourJoining::NeighbourJoining(const std::unordered_map<std::string, std::string>& sequence_map,
+                                   const ScoringScheme& scoring_scheme)
+    : scoring(scoring_scheme) {
     int num_sequences = sequence_map.size();
-    distance_matrix = std::make_unique<std::vector<std::vector<int>>>(num_sequences, std::vector<int>(num_sequences, 0));
-    nodes.reserve(num_sequences);
+    nodes.reserve(2 * num_sequences);
 
     for (const auto& entry : sequence_map) {
         const std::string& seq_id = entry.first;
@@ -23,161 +32,382 @@ NeighbourJoining::NeighbourJoining(const std::unordered_map<std::string, std::st
         nodes.push_back(leaf_node);
 
         sequences.push_back(sequence);
+        sequence_ids.push_back(seq_id);
+    }
+}
+
+NeighbourJoining::~NeighbourJoining() {
+    for (Node* node : nodes) {
+        delete node;
     }
 }
 
+void NeighbourJoining::set_band_width(size_t initial_width) {
+    band_width = initial_width;
+}
+
+void NeighbourJoining::set_num_threads(unsigned threads) {
+    num_threads = threads;
+}
+
+void NeighbourJoining::set_tree_method(TreeMethod method) {
+    tree_method = method;
+}
+
+void NeighbourJoining::set_rapid_search(bool enabled, const std::string& directory) {
+    rapid_search = enabled;
+    spill_directory = directory;
+}
+
 void NeighbourJoining::calculate_distance_matrix() {
     int num_sequences = sequences.size();
-    distance_matrix = std::make_unique<std::vector<std::vector<int>>>(num_sequences, std::vector<int>(num_sequences, 0));
+    distance_matrix.resize(num_sequences);
+    has_distances = true;
+
+    // Puntuación de cada secuencia consigo misma, para pasar de puntuaciones
+    // (similitud) a distancias.
+    std::vector<std::vector<uint8_t>> codes(num_sequences);
+    std::vector<double> self_scores(num_sequences, 0.0);
+    for (int i = 0; i < num_sequences; ++i) {
+        scoring.encode(sequences[i], codes[i]);
+        for (uint8_t c : codes[i]) {
+            self_scores[i] += scoring.score(c, c);
+        }
+    }
+    auto to_distance = [&](int i, int j, int score) {
+        return static_cast<float>(std::max(0.0, 0.5 * (self_scores[i] + self_scores[j]) - score));
+    };
+
+    ThreadPool pool(num_threads);
+
+    // Cada tarea escribe sólo sus propias celdas, así que el resultado no
+    // depende del número de hilos ni del orden de ejecución. Las tareas se
+    // ordenan de mayor a menor coste: el grupo de hilos las reparte en ese
+    // orden y los robos equilibran el final.
+    if (band_width == 0) {
+        // Sin banda, una tarea por fila: la secuencia i frente a todas las
+        // j > i a la vez con el núcleo vectorizado entre secuencias.
+        std::vector<unsigned long long> cost(num_sequences, 0);
+        unsigned long long remaining = 0;
+        for (int i = num_sequences - 1; i >= 0; --i) {
+            cost[i] = static_cast<unsigned long long>(sequences[i].size()) * remaining;
+            remaining += sequences[i].size();
+        }
+        std::vector<int> rows(num_sequences);
+        for (int i = 0; i < num_sequences; ++i) {
+            rows[i] = i;
+        }
+        std::stable_sort(rows.begin(), rows.end(), [&](int x, int y) { return cost[x] > cost[y]; });
+
+        pool.parallel_for(rows.size(), [&](size_t k) {
+            const int i = rows[k];
+            std::vector<int> scores = needleman_wunsch_batch_scores(codes[i], codes.data() + i + 1,
+                                                                    num_sequences - i - 1, scoring.data(),
+                                                                    scoring.size(), scoring.gap());
+            for (int j = i + 1; j < num_sequences; ++j) {
+                distance_matrix.set(i, j, to_distance(i, j, scores[j - i - 1]));
+            }
+        });
+        return;
+    }
+
+    // Con banda, una tarea por pareja, por producto de longitudes.
+    std::vector<std::pair<int, int>> pairs;
+    pairs.reserve(static_cast<size_t>(num_sequences) * (num_sequences - 1) / 2);
     for (int i = 0; i < num_sequences; ++i) {
         for (int j = i + 1; j < num_sequences; ++j) {
-            NeedlemanWunsch nw(sequences[i], sequences[j], 3, -1, -2);
-            nw.align();
-            int alignment_score = nw.get_alignment_score();
-            (*distance_matrix)[i][j] = alignment_score;
-            (*distance_matrix)[j][i] = alignment_score;
+            pairs.emplace_back(i, j);
         }
     }
+    auto cost = [this](const std::pair<int, int>& p) {
+        return static_cast<unsigned long long>(sequences[p.first].size()) * sequences[p.second].size();
+    };
+    std::stable_sort(pairs.begin(), pairs.end(), [&](const std::pair<int, int>& x, const std::pair<int, int>& y) {
+        return cost(x) > cost(y);
+    });
+
+    // Un alineador por hilo, reutilizado entre parejas para no reservar
+    // memoria en cada una.
+    std::vector<NeedlemanWunsch> aligners(pool.size(), NeedlemanWunsch(scoring));
+    pool.parallel_for_worker(pairs.size(), [&](size_t k, unsigned worker) {
+        const int i = pairs[k].first;
+        const int j = pairs[k].second;
+        // Secuencias parecidas cuestan O(n * w) en vez de O(n * m).
+        NeedlemanWunsch& nw = aligners[worker];
+        nw.set_sequences(sequences[i], sequences[j]);
+        distance_matrix.set(i, j, to_distance(i, j, nw.score_only_adaptive_band(band_width)));
+    });
+}
+
+void NeighbourJoining::calculate_kmer_distance_matrix(const KmerDistanceOptions& options) {
+    KmerDistanceOptions threaded = options;
+    threaded.num_threads = num_threads;
+    distance_matrix = kmer_distance_matrix(sequences, threaded);
+    has_distances = true;
+}
+
+void NeighbourJoining::set_distance_matrix(const DistanceMatrix& distances) {
+    if (distances.size() != sequences.size()) {
+        throw std::invalid_argument("NeighbourJoining: la matriz de distancias no tiene una fila por secuencia");
+    }
+    distance_matrix = distances;
+    has_distances = true;
+}
+
+const DistanceMatrix& NeighbourJoining::get_distance_matrix() const {
+    return distance_matrix;
+}
+
+std::vector<std::string> NeighbourJoining::get_sequence_ids() const {
+    return sequence_ids;
 }
 
 void NeighbourJoining::print_distance_matrix() const {
-    int num_sequences = distance_matrix->size();
+    size_t num_nodes = distance_matrix.size();
     std::cout << "Current distance matrix:" << std::endl;
-    for (int i = 0; i < num_sequences; ++i) {
-        for (int j = 0; j < num_sequences; ++j) {
-            std::cout << (*distance_matrix)[i][j] << " ";
+    for (size_t i = 0; i < num_nodes; ++i) {
+        for (size_t j = 0; j < num_nodes; ++j) {
+            std::cout << distance_matrix(i, j) << " ";
         }
         std::cout << std::endl;
     }
 }
 
-void NeighbourJoining::join_smallest_distance_nodes() {
-    int num_nodes = distance_matrix->size();
-    update_active_nodes();
-
-    std::pair<int, int> smallest_distance_pair = find_smallest_distance_pair();
-    int min_i = smallest_distance_pair.first;
-    int min_j = smallest_distance_pair.second;
-
-    // Crear un nuevo nodo y actualizar la matriz de distancias
-    create_new_node(min_i, min_j);
-    // Contar solo los nodos activos
-    int new_num_nodes = std::count_if(nodes.begin(), nodes.end(), [](const Node* n) { return n->active; });
-    // Crear una nueva matriz de distancias
-    auto new_distance_matrix = create_new_distance_matrix(min_i, min_j);
-    distance_matrix = std::move(new_distance_matrix);
+/*
+Neighbour Joining sobre la matriz condensada: cada unión escribe las
+distancias del nuevo nodo en la fila de uno de los dos nodos unidos y mueve la
+última fila a la del otro, así que la matriz nunca se vuelve a reservar. Las
+sumas por fila r(i) se actualizan en O(n) en cada unión, de modo que buscar el
+mínimo de Q(i, j) = (n - 2) d(i, j) - r(i) - r(j) cuesta O(n^2) y el árbol
+completo O(n^3) en tiempo y n^2 / 2 floats de memoria.
+*/
+void NeighbourJoining::start_joining() {
+    active_nodes.assign(nodes.begin(), nodes.begin() + sequences.size());
+    for (Node* node : active_nodes) {
+        node->active = true;
+    }
+    row_sums.assign(distance_matrix.size(), 0.0);
+    for (size_t i = 0; i < distance_matrix.size(); ++i) {
+        const float* row = distance_matrix.row(i);
+        for (size_t j = 0; j < i; ++j) {
+            row_sums[i] += row[j];
+            row_sums[j] += row[j];
+        }
+    }
+    has_distances = false;
+
+    rapid.reset();
+    if (rapid_search && active_nodes.size() > 2) {
+        rapid = std::make_unique<RapidNJSearch>(spill_directory);
+        rapid->build(distance_matrix);
+    }
 }
 
-void NeighbourJoining::update_active_nodes() {
-    active_nodes.clear();  // Limpiar la lista anterior de nodos activos
-    for (Node* node : nodes) {
-        if (node->active) {
-            active_nodes.push_back(node);  // Añadir solo nodos activos a la lista
-        }
+void NeighbourJoining::join_smallest_distance_nodes() {
+    if (has_distances) {
+        start_joining();
+    }
+    if (active_nodes.size() < 2) {
+        return;
+    }
+
+    std::pair<size_t, size_t> pair = rapid ? rapid->find_min_q(distance_matrix, row_sums) : find_min_q_pair();
+    join_rows(pair.first, pair.second);
+    if (rapid && active_nodes.size() > 2) {
+        rapid->join(distance_matrix, pair.first, pair.second);
+    } else {
+        rapid.reset();
     }
 }
 
-std::pair<int, int> NeighbourJoining::find_smallest_distance_pair() {
-    int min_i = -1;
-    int min_j = -1;
-    int min_distance = std::numeric_limits<int>::max();
-    
-    for (int i = 0; i < active_nodes.size(); ++i) {
-        for (int j = i + 1; j < active_nodes.size(); ++j) {
-            if (active_nodes[i] && active_nodes[j]) { // Verificar que los punteros son válidos
-                int distance = (*distance_matrix)[i][j];
-                if (distance < min_distance) {
-                    min_distance = distance;
-                    min_i = i;
-                    min_j = j;
+std::pair<size_t, size_t> NeighbourJoining::find_min_q_pair() const {
+    const size_t num_nodes = active_nodes.size();
+    const double factor = static_cast<double>(num_nodes) - 2.0;
+    size_t min_i = 1;
+    size_t min_j = 0;
+    const double infinity = std::numeric_limits<double>::infinity();
+    double min_q = infinity;
+
+    // En caso de empate gana la fila i menor y, dentro de la fila, el menor
+    // (n - 2) d(i, j) - r(j) y después la j menor (RapidNJSearch respeta el
+    // mismo orden). El mínimo de cada fila se busca primero sin guardar su posición, con cuatro
+    // mínimos parciales independientes para no encadenar las comparaciones;
+    // sólo las filas que mejoran el mínimo global se recorren otra vez para
+    // localizarlo.
+    const double* sums = row_sums.data();
+    for (size_t i = 1; i < num_nodes; ++i) {
+        const float* row = distance_matrix.row(i);
+        double m0 = infinity, m1 = infinity, m2 = infinity, m3 = infinity;
+        size_t j = 0;
+        for (; j + 4 <= i; j += 4) {
+            m0 = std::min(m0, factor * row[j] - sums[j]);
+            m1 = std::min(m1, factor * row[j + 1] - sums[j + 1]);
+            m2 = std::min(m2, factor * row[j + 2] - sums[j + 2]);
+            m3 = std::min(m3, factor * row[j + 3] - sums[j + 3]);
+        }
+        for (; j < i; ++j) {
+            m0 = std::min(m0, factor * row[j] - sums[j]);
+        }
+        const double row_min = std::min(std::min(m0, m1), std::min(m2, m3));
+        const double q_i = row_min - sums[i];
+        if (q_i < min_q) {
+            min_q = q_i;
+            min_i = i;
+            double best = infinity;
+            for (size_t k = 0; k < i; ++k) {
+                const double q = factor * row[k] - sums[k];
+                if (q < best) {
+                    best = q;
+                    min_j = k;
                 }
             }
         }
     }
-
-    if (min_i == -1 || min_j == -1) {
-        std::cout << "No valid pairs found to merge." << std::endl;
-        return std::make_pair(-1, -1);
-    }
-
     return std::make_pair(min_i, min_j);
 }
 
+void NeighbourJoining::join_rows(size_t i, size_t j) {
+    const size_t num_nodes = active_nodes.size();
+    const double d_ij = distance_matrix(i, j);
+
+    // Longitudes de las ramas hacia el nuevo nodo. Con distancias no aditivas
+    // pueden salir negativas: se recortan a 0 y la otra rama toma d(i, j).
+    const double delta = num_nodes > 2 ? (row_sums[i] - row_sums[j]) / (num_nodes - 2) : 0.0;
+    double length_i = 0.5 * (d_ij + delta);
+    length_i = std::min(std::max(length_i, 0.0), d_ij);
+    const double length_j = d_ij - length_i;
+
+    Node* new_node = create_parent(active_nodes[j], active_nodes[i], length_j, length_i);
 
+    // Distancias del nuevo nodo, en la fila j.
+    double new_row_sum = 0.0;
+    for (size_t k = 0; k < num_nodes; ++k) {
+        if (k == i || k == j) {
+            continue;
+        }
+        const float d_ik = distance_matrix(i, k);
+        const float d_jk = distance_matrix(j, k);
+        const float d_uk = static_cast<float>(0.5 * (static_cast<double>(d_ik) + d_jk - d_ij));
+        row_sums[k] += static_cast<double>(d_uk) - d_ik - d_jk;
+        new_row_sum += d_uk;
+        distance_matrix.set(j, k, d_uk);
+    }
+    row_sums[j] = new_row_sum;
+    active_nodes[j] = new_node;
+
+    // La fila i desaparece: la última ocupa su lugar.
+    distance_matrix.remove(i);
+    row_sums[i] = row_sums.back();
+    row_sums.pop_back();
+    active_nodes[i] = active_nodes.back();
+    active_nodes.pop_back();
+}
 
-void NeighbourJoining::create_new_node(int min_i, int min_j) {
-    // Hay que usar la lista de nodos activos para la creación del nuevo. 
+NeighbourJoining::Node* NeighbourJoining::create_parent(Node* left, Node* right, double left_length,
+                                                        double right_length) {
     Node* new_node = new Node();
-    new_node->id = active_nodes[min_i]->id + "-" + active_nodes[min_j]->id;
-    new_node->left_child = active_nodes[min_i];
-    new_node->right_child = active_nodes[min_j];
+    new_node->left_child = left;
+    new_node->right_child = right;
+    new_node->id = left->id + "-" + right->id;
     new_node->sequence = "";
     new_node->active = true;
-    new_node->depth = std::max(new_node->left_child->depth, new_node->right_child->depth) + 1;
-
-    // Desactivar los nodos antiguos
-    new_node->left_child->active = false;
-    new_node->right_child->active = false;
-    nodes.push_back(new_node);  // Añadir el nuevo nodo a la lista
-    update_active_nodes(); // Ahora que hemos creado el nuevo nodo, actualizamos la lista.
+    new_node->depth = std::max(left->depth, right->depth) + 1;
+    left->branch_length = left_length;
+    right->branch_length = right_length;
+    left->active = false;
+    right->active = false;
+    nodes.push_back(new_node);
+    return new_node;
 }
 
-std::unique_ptr<std::vector<std::vector<int>>> NeighbourJoining::create_new_distance_matrix(int min_i, int min_j) {
-    int new_num_nodes = active_nodes.size();
-    auto new_distance_matrix = std::make_unique<std::vector<std::vector<int>>>(new_num_nodes, std::vector<int>(new_num_nodes, 0));
-
-    // Rellenar la nueva matriz de distancias
-    for (int i = 0; i < new_num_nodes - 1; ++i) {  // -1 porque el último nodo será el nuevo nodo fusionado
-        for (int j = 0; j < new_num_nodes - 1; ++j) {
-            if (i == min_i || i == min_j || j == min_i || j == min_j) {
-                // No calcular distancias que involucren directamente a los nodos fusionados aquí
-                continue;
-            }
-            // Copiar las distancias existentes entre otros nodos activos
-            (*new_distance_matrix)[i][j] = (*distance_matrix)[i][j];
-        }
+/*
+Árboles ultramétricos (UPGMA, WPGMA, enlace simple y completo): la jerarquía
+sale de linkage_clustering() y cada grupo queda a una altura igual a la mitad
+de la distancia a la que se formó, de modo que la distancia entre dos hojas
+por el árbol es la de su unión.
+*/
+void NeighbourJoining::build_linkage_tree() {
+    LinkageMethod method = LINKAGE_UPGMA;
+    switch (tree_method) {
+        case TREE_WPGMA: method = LINKAGE_WPGMA; break;
+        case TREE_SINGLE_LINKAGE: method = LINKAGE_SINGLE; break;
+        case TREE_COMPLETE_LINKAGE: method = LINKAGE_COMPLETE; break;
+        default: break;
     }
 
-    // Calcular las distancias del nuevo nodo fusionado
-    int new_node_index = new_num_nodes - 1;
-    for (int i = 0; i < new_num_nodes - 1; ++i) {
-        // Utilizando la fórmula de Neighbour Joining para calcular la distancia al nuevo nodo
-        (*new_distance_matrix)[i][new_node_index] = ((*distance_matrix)[i][min_i] + (*distance_matrix)[i][min_j] - (*distance_matrix)[min_i][min_j]) / 2;
-        (*new_distance_matrix)[new_node_index][i] = (*new_distance_matrix)[i][new_node_index];  // Mantener la simetría
+    has_distances = false;
+    rapid.reset();
+    std::vector<ClusterMerge> merges = linkage_clustering(distance_matrix, method);
+
+    // Nodo y altura de cada grupo, con la numeración de linkage_clustering().
+    std::vector<Node*> clusters(nodes.begin(), nodes.begin() + sequences.size());
+    std::vector<double> heights(sequences.size(), 0.0);
+    for (Node* leaf : clusters) {
+        leaf->active = true;
     }
-    distance_matrix.reset();
+    for (const ClusterMerge& merge : merges) {
+        const double height = 0.5 * merge.distance;
+        clusters.push_back(create_parent(clusters[merge.first], clusters[merge.second],
+                                         std::max(0.0, height - heights[merge.first]),
+                                         std::max(0.0, height - heights[merge.second])));
+        heights.push_back(height);
+    }
+    active_nodes.clear();
+    if (!clusters.empty()) {
+        active_nodes.push_back(clusters.back());
+    }
+}
 
-    return new_distance_matrix;
+NeighbourJoining::Node* NeighbourJoining::construct_tree() {
+    if (!has_distances && active_nodes.empty()) {
+        calculate_distance_matrix();
+    }
+    if (tree_method != TREE_NEIGHBOUR_JOINING) {
+        if (has_distances) {
+            build_linkage_tree();
+        }
+        return active_nodes.empty() ? nullptr : active_nodes.front();
+    }
+    if (has_distances) {
+        start_joining();
+    }
+    while (active_nodes.size() > 1) {
+        join_smallest_distance_nodes();
+    }
+    return active_nodes.empty() ? nullptr : active_nodes.front();
 }
 
 /*
 Esta es la función principal, que va creando el árbol
 */
 void NeighbourJoining::build_tree() {
-    calculate_distance_matrix();
-    while (distance_matrix->size() > 1) {
-        print_distance_matrix();
-        join_smallest_distance_nodes();
-    }
+    Node* root = construct_tree();
 
     std::cout << "Construcción del árbol completada." << std::endl;
-    if (!nodes.empty()) {
-        Node* root = nodes.back();  // Asumiendo que el último nodo es la raíz
+    if (root != nullptr) {
         std::cout << "Árbol filogenético:" << std::endl;
         print_tree(root, "", false);
         std::cout << "Árbol filogenético en formato Newick:" << std::endl;
         std::string newick_format = generate_newick_format(root);
         std::cout << newick_format << ";" << std::endl;  // Añade el punto y coma final necesario en formato Newick
         std::cout << "===================" << std::endl;
-        std::string alignment = align_sequences();
+        MultipleAlignment alignment = align_sequences(root);
+        size_t id_width = 0;
+        for (const std::string& id : alignment.ids) {
+            id_width = std::max(id_width, id.size());
+        }
         std::cout << "Alineamiento final:" << std::endl;
-        std::cout << alignment << std::endl;
+        for (size_t r = 0; r < alignment.rows.size(); ++r) {
+            std::cout << alignment.ids[r] << std::string(id_width - alignment.ids[r].size() + 2, ' ')
+                      << alignment.rows[r] << std::endl;
+        }
 
         // Liberar la memoria del árbol después de imprimir y alinear
         for (Node* node : nodes) {
             delete node;
         }
         nodes.clear();
+        active_nodes.clear();
     }
 }
 
@@ -218,22 +448,10 @@ void NeighbourJoining::print_tree(Node* node, std::string prefix, bool is_left)
 }
 
 /*
-Realizar el alineamiento final, en proceso de realización...
+Alineamiento múltiple progresivo siguiendo el árbol guía
 */
-std::string NeighbourJoining::align_sequences() {
-    std::vector<Node*> order = get_alignment_order(nodes.back()); // Asumiendo que el último nodo es la raíz
-    std::string alignment = order[0]->sequence; // Inicia el alineamiento con la secuencia del primer nodo
-
-    for (size_t i = 1; i < order.size(); ++i) {
-        std::string next_sequence = order[i]->sequence;
-        NeedlemanWunsch nw(alignment, next_sequence, 3, -1, -2); 
-        nw.align();
-        auto aligned_sequences = nw.get_alignment();
-        alignment = aligned_sequences.first; // Usa la secuencia alineada de 'alignment' como la nueva secuencia base
-        std::cout << alignment << std::endl;
-    }
-
-    return alignment;
+MultipleAlignment NeighbourJoining::align_sequences(const Node* root) const {
+    return progressive_alignment(root, scoring, num_threads);
 }
 
 /*
@@ -257,8 +475,8 @@ std::string NeighbourJoining::generate_newick_format(Node* node) {
         result += ")";
     }
     result += node->id;
-    // Usa la profundidad dividida por 10 como una estimación de la distancia
-    result += ":" + std::to_string(node->depth / 10.0);
+    // Longitud de la rama hacia el padre (0 en la raíz)
+    result += ":" + std::to_string(node->branch_length);
     return result;
 }
 
@@ -0,0 +1,291 @@
+// progressive_alignment.cpp
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include "cigar.h"
+#include "dp_matrix.h"
+#include "progressive_alignment.h"
+#include "thread_pool.h"
+
+namespace {
+
+typedef NeighbourJoining::Node Node;
+
+// Perfil de un subárbol: sus hojas y sus filas alineadas, codificadas con el
+// alfabeto del esquema (el último código es el gap).
+struct Profile {
+    std::vector<const Node*> leaves;
+    std::vector<std::vector<std::uint8_t>> rows;
+
+    std::size_t length() const { return rows.empty() ? 0 : rows.front().size(); }
+};
+
+// Espacio de trabajo de cada hilo, reutilizado entre nodos.
+struct Workspace {
+    std::vector<float> frequencies_a;
+    std::vector<float> frequencies_b;
+    std::vector<float> expected_a;
+    std::vector<float> gap_b;
+    std::vector<float> prev;
+    std::vector<float> curr;
+    PackedTraceMatrix traces;
+    Cigar cigar;
+};
+
+// Frecuencia de cada símbolo en cada columna, `alphabet_size` por columna.
+void column_frequencies(const Profile& profile, int alphabet_size, std::vector<float>& frequencies) {
+    const std::size_t length = profile.length();
+    frequencies.assign(length * alphabet_size, 0.0f);
+    const float weight = 1.0f / static_cast<float>(profile.rows.size());
+    for (const std::vector<std::uint8_t>& row : profile.rows) {
+        for (std::size_t c = 0; c < length; ++c) {
+            frequencies[c * alphabet_size + row[c]] += weight;
+        }
+    }
+}
+
+// Alinea dos perfiles con programación dinámica (gap lineal) y devuelve el
+// perfil unido.
+Profile align_profiles(const Profile& a, const Profile& b, const std::vector<int>& table, int alphabet_size,
+                       Workspace& work) {
+    const std::size_t n = a.length();
+    const std::size_t m = b.length();
+    const std::size_t alpha = static_cast<std::size_t>(alphabet_size);
+    const std::uint8_t gap = static_cast<std::uint8_t>(alphabet_size - 1);
+    column_frequencies(a, alphabet_size, work.frequencies_a);
+    column_frequencies(b, alphabet_size, work.frequencies_b);
+
+    // expected_a[i][y]: puntuación media de la columna i de A frente al
+    // símbolo y. Así la puntuación de dos columnas es un producto escalar con
+    // las frecuencias de la de B, y la de una columna frente a un hueco es
+    // expected_a[i][gap].
+    work.expected_a.assign(n * alpha, 0.0f);
+    for (std::size_t i = 0; i < n; ++i) {
+        const float* f = &work.frequencies_a[i * alpha];
+        float* e = &work.expected_a[i * alpha];
+        for (std::size_t x = 0; x < alpha; ++x) {
+            if (f[x] != 0.0f) {
+                const int* row = &table[x * alpha];
+                for (std::size_t y = 0; y < alpha; ++y) {
+                    e[y] += f[x] * static_cast<float>(row[y]);
+                }
+            }
+        }
+    }
+    work.gap_b.assign(m, 0.0f);
+    for (std::size_t j = 0; j < m; ++j) {
+        const float* f = &work.frequencies_b[j * alpha];
+        for (std::size_t y = 0; y < alpha; ++y) {
+            work.gap_b[j] += f[y] * static_cast<float>(table[gap * alpha + y]);
+        }
+    }
+
+    std::vector<float>& prev = work.prev;
+    std::vector<float>& curr = work.curr;
+    prev.resize(m + 1);
+    curr.resize(m + 1);
+    PackedTraceMatrix& traces = work.traces;
+    traces.resize(n + 1, m + 1);
+
+    prev[0] = 0.0f;
+    for (std::size_t j = 1; j <= m; ++j) {
+        prev[j] = prev[j - 1] + work.gap_b[j - 1];
+        traces.set(0, j, TRACE_LEFT);
+    }
+    for (std::size_t i = 1; i <= n; ++i) {
+        const float* e = &work.expected_a[(i - 1) * alpha];
+        const float gap_a = e[gap];
+        curr[0] = prev[0] + gap_a;
+        traces.set(i, 0, TRACE_UP);
+        for (std::size_t j = 1; j <= m; ++j) {
+            const float* f = &work.frequencies_b[(j - 1) * alpha];
+            float column_score = 0.0f;
+            for (std::size_t y = 0; y < alpha; ++y) {
+                column_score += e[y] * f[y];
+            }
+            const float match_score = prev[j - 1] + column_score;
+            const float delete_score = prev[j] + gap_a;
+            const float insert_score = curr[j - 1] + work.gap_b[j - 1];
+
+            // Mismo orden de preferencia que NeedlemanWunsch en los empates.
+            if (match_score >= delete_score && match_score >= insert_score) {
+                curr[j] = match_score;
+                traces.set(i, j, TRACE_DIAG);
+            } else if (delete_score >= insert_score) {
+                curr[j] = delete_score;
+                traces.set(i, j, TRACE_UP);
+            } else {
+                curr[j] = insert_score;
+                traces.set(i, j, TRACE_LEFT);
+            }
+        }
+        prev.swap(curr);
+    }
+
+    Cigar& cigar = work.cigar;
+    cigar.clear();
+    std::size_t i = n;
+    std::size_t j = m;
+    while (i > 0 || j > 0) {
+        const std::uint8_t code = traces.get(i, j);
+        if (code == TRACE_DIAG) {
+            cigar.push_back(CIGAR_MATCH);
+            --i;
+            --j;
+        } else if (code == TRACE_UP) {
+            cigar.push_back(CIGAR_INSERTION);
+            --i;
+        } else {
+            cigar.push_back(CIGAR_DELETION);
+            --j;
+        }
+    }
+    cigar.reverse();
+
+    // Perfil unido: las filas de A con huecos donde B avanza sola y
+    // viceversa.
+    Profile merged;
+    merged.leaves = a.leaves;
+    merged.leaves.insert(merged.leaves.end(), b.leaves.begin(), b.leaves.end());
+    merged.rows.reserve(a.rows.size() + b.rows.size());
+    std::size_t length = 0;
+    for (const Cigar::Run& run : cigar) {
+        length += run.length;
+    }
+    for (const Profile* source : {&a, &b}) {
+        const bool is_a = source == &a;
+        for (const std::vector<std::uint8_t>& row : source->rows) {
+            std::vector<std::uint8_t> aligned;
+            aligned.reserve(length);
+            std::size_t k = 0;
+            for (const Cigar::Run& run : cigar) {
+                const bool consumes = run.op == CIGAR_MATCH || (run.op == CIGAR_INSERTION) == is_a;
+                if (consumes) {
+                    aligned.insert(aligned.end(), row.begin() + k, row.begin() + k + run.length);
+                    k += run.length;
+                } else {
+                    aligned.insert(aligned.end(), run.length, gap);
+                }
+            }
+            merged.rows.push_back(std::move(aligned));
+        }
+    }
+    return merged;
+}
+
+} // namespace
+
+MultipleAlignment progressive_alignment(const NeighbourJoining::Node* root, const ScoringScheme& scoring,
+                                        unsigned num_threads) {
+    MultipleAlignment result;
+    if (root == nullptr) {
+        return result;
+    }
+
+    // Tabla del esquema con gap frente a gap a 0.
+    const int alphabet_size = scoring.size();
+    std::vector<int> table(scoring.data(), scoring.data() + alphabet_size * alphabet_size);
+    table[alphabet_size * alphabet_size - 1] = 0;
+
+    // Recorrido en postorden sin recursión (el árbol puede ser muy profundo).
+    // Cada nodo recibe un índice y los internos se agrupan por altura, de modo
+    // que los hijos de un nodo siempre están en niveles anteriores.
+    std::vector<const Node*> order;
+    std::unordered_map<const Node*, std::size_t> index;
+    std::vector<std::pair<const Node*, bool>> stack = {{root, false}};
+    while (!stack.empty()) {
+        const std::pair<const Node*, bool> top = stack.back();
+        stack.pop_back();
+        const Node* node = top.first;
+        const bool is_leaf = node->left_child == nullptr || node->right_child == nullptr;
+        if (top.second || is_leaf) {
+            index[node] = order.size();
+            order.push_back(node);
+        } else {
+            stack.emplace_back(node, true);
+            stack.emplace_back(node->right_child, false);
+            stack.emplace_back(node->left_child, false);
+        }
+    }
+
+    std::vector<Profile> profiles(order.size());
+    std::vector<std::size_t> height(order.size(), 0);
+    std::vector<std::size_t> left_index(order.size(), 0);
+    std::vector<std::size_t> right_index(order.size(), 0);
+    std::vector<std::vector<std::size_t>> levels;
+    // Las hojas se alinean sin los '-' que ya traigan: codificados como gap,
+    // las filas finales no sabrían qué columnas son suyas y cuáles del DP.
+    std::vector<std::string> ungapped(order.size());
+    for (std::size_t k = 0; k < order.size(); ++k) {
+        const Node* node = order[k];
+        if (node->left_child == nullptr || node->right_child == nullptr) {
+            for (char c : node->sequence) {
+                if (c != '-') {
+                    ungapped[k] += c;
+                }
+            }
+            profiles[k].leaves.push_back(node);
+            profiles[k].rows.push_back(scoring.encode(ungapped[k]));
+            continue;
+        }
+        left_index[k] = index[node->left_child];
+        right_index[k] = index[node->right_child];
+        height[k] = std::max(height[left_index[k]], height[right_index[k]]) + 1;
+        if (levels.size() < height[k]) {
+            levels.resize(height[k]);
+        }
+        levels[height[k] - 1].push_back(k);
+    }
+
+    // Los nodos de un nivel sólo leen los perfiles de sus hijos, terminados
+    // en niveles anteriores, y los liberan al acabar.
+    ThreadPool pool(num_threads);
+    std::vector<Workspace> workspaces(pool.size());
+    for (const std::vector<std::size_t>& level : levels) {
+        pool.parallel_for_worker(level.size(), [&](std::size_t t, unsigned worker) {
+            const std::size_t k = level[t];
+            Profile& left = profiles[left_index[k]];
+            Profile& right = profiles[right_index[k]];
+            profiles[k] = align_profiles(left, right, table, alphabet_size, workspaces[worker]);
+            left = Profile();
+            right = Profile();
+        });
+    }
+
+    // Filas finales con los símbolos originales (conservan minúsculas).
+    const Profile& final_profile = profiles.back();
+    const std::uint8_t gap = scoring.gap_code();
+    for (std::size_t r = 0; r < final_profile.rows.size(); ++r) {
+        const Node* leaf = final_profile.leaves[r];
+        const std::string& sequence = ungapped[index[leaf]];
+        std::string row;
+        row.reserve(final_profile.length());
+        std::size_t position = 0;
+        for (std::uint8_t code : final_profile.rows[r]) {
+            row.push_back(code == gap ? '-' : sequence[position++]);
+        }
+        result.ids.push_back(leaf->id);
+        result.rows.push_back(std::move(row));
+    }
+    return result;
+}
+
+long long sum_of_pairs_score(const MultipleAlignment& alignment, const ScoringScheme& scoring) {
+    std::vector<std::vector<std::uint8_t>> codes(alignment.rows.size());
+    for (std::size_t r = 0; r < codes.size(); ++r) {
+        scoring.encode(alignment.rows[r], codes[r]);
+    }
+    const std::uint8_t gap = scoring.gap_code();
+    long long total = 0;
+    for (std::size_t x = 0; x < codes.size(); ++x) {
+        for (std::size_t y = x + 1; y < codes.size(); ++y) {
+            for (std::size_t c = 0; c < codes[x].size(); ++c) {
+                if (codes[x][c] != gap || codes[y][c] != gap) {
+                    total += scoring.score(codes[x][c], codes[y][c]);
+                }
+            }
+        }
+    }
+    return total;
+}
@@ -0,0 +1,263 @@
+// rapid_nj_search.cpp
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "rapid_nj_search.h"
+
+RapidNJSearch::RapidNJSearch(const std::string& directory) : spill_directory(directory) {
+}
+
+RapidNJSearch::~RapidNJSearch() {
+    release();
+}
+
+void RapidNJSearch::allocate(std::size_t entry_count) {
+    release();
+    capacity = entry_count;
+    used = 0;
+    if (spill_directory.empty()) {
+        memory.resize(capacity);
+        entries = memory.data();
+        return;
+    }
+
+    // Fichero temporal borrado nada más crearlo: desaparece al cerrar la
+    // proyección aunque el programa termine de forma abrupta.
+    std::string path = spill_directory + "/rapid_nj_XXXXXX";
+    int fd = mkstemp(&path[0]);
+    if (fd < 0) {
+        throw std::runtime_error("RapidNJSearch: no se pudo crear un fichero temporal en " + spill_directory);
+    }
+    unlink(path.c_str());
+    mapping_bytes = std::max<std::size_t>(capacity * sizeof(Entry), 1);
+    if (ftruncate(fd, static_cast<off_t>(mapping_bytes)) != 0) {
+        close(fd);
+        throw std::runtime_error("RapidNJSearch: no se pudo reservar el fichero temporal");
+    }
+    void* address = mmap(nullptr, mapping_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("RapidNJSearch: no se pudo proyectar el fichero temporal");
+    }
+    mapping = address;
+    entries = static_cast<Entry*>(mapping);
+}
+
+void RapidNJSearch::release() {
+    if (mapping != nullptr) {
+        munmap(mapping, mapping_bytes);
+        mapping = nullptr;
+        mapping_bytes = 0;
+    }
+    std::vector<Entry>().swap(memory);
+    entries = nullptr;
+    capacity = 0;
+    used = 0;
+}
+
+void RapidNJSearch::build(const DistanceMatrix& distances) {
+    const std::size_t n = distances.size();
+
+    // Las n (n - 1) / 2 entradas iniciales y la mitad más para las filas de
+    // los nuevos nodos: así compact() sólo se ejecuta cada O(n) uniones.
+    allocate(n * (n - 1) / 2 + n * (n - 1) / 4 + n);
+
+    slot_node.resize(n);
+    row_begin.resize(n);
+    row_length.resize(n);
+    head_distance.resize(n);
+    head_node.resize(n);
+    node_slot.assign(2 * n, -1);
+    next_node = static_cast<std::uint32_t>(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        slot_node[i] = static_cast<std::uint32_t>(i);
+        node_slot[i] = static_cast<std::int64_t>(i);
+
+        // Fila i: distancias a las filas anteriores, ordenadas.
+        const float* row = distances.row(i);
+        Entry* first = entries + used;
+        for (std::size_t j = 0; j < i; ++j) {
+            first[j].distance = row[j];
+            first[j].node = static_cast<std::uint32_t>(j);
+        }
+        std::sort(first, first + i, [](const Entry& x, const Entry& y) {
+            return x.distance < y.distance || (x.distance == y.distance && x.node < y.node);
+        });
+        row_begin[i] = used;
+        row_length[i] = i;
+        used += i;
+        update_head(i);
+    }
+}
+
+std::pair<std::size_t, std::size_t> RapidNJSearch::find_min_q(const DistanceMatrix& distances,
+                                                              const std::vector<double>& row_sums) {
+    const std::size_t num_nodes = distances.size();
+    visited = 0;
+    if (num_nodes < 3) {
+        return std::make_pair<std::size_t, std::size_t>(1, 0);
+    }
+    const double factor = static_cast<double>(num_nodes) - 2.0;
+    const double max_sum = *std::max_element(row_sums.begin(), row_sums.begin() + num_nodes);
+
+    // Mismo orden que la búsqueda exhaustiva de NeighbourJoining: primero Q,
+    // después la fila mayor i, después (n - 2) d(i, j) - r(j) y por último la
+    // fila menor j. Q se calcula con las mismas operaciones, en el mismo
+    // orden, para obtener exactamente los mismos valores.
+    double best_q = std::numeric_limits<double>::infinity();
+    double best_partial = best_q;
+    std::size_t best_i = 1;
+    std::size_t best_j = 0;
+    auto consider = [&](std::size_t s, std::size_t t, float distance) {
+        const std::size_t i = std::max(s, t);
+        const std::size_t j = std::min(s, t);
+        const double partial = factor * distance - row_sums[j];
+        const double q = partial - row_sums[i];
+        if (q < best_q ||
+            (q == best_q && (i < best_i || (i == best_i && (partial < best_partial ||
+                                                            (partial == best_partial && j < best_j)))))) {
+            best_q = q;
+            best_partial = partial;
+            best_i = i;
+            best_j = j;
+        }
+    };
+
+    // Una primera pareja por fila (la más cercana, si sigue viva) da un buen
+    // mínimo inicial con el que podar desde el principio. Se lee de
+    // head_distance/head_node, contiguos, sin tocar las filas.
+    for (std::size_t s = 0; s < num_nodes; ++s) {
+        if (row_length[s] > 0 && node_slot[head_node[s]] >= 0) {
+            consider(s, static_cast<std::size_t>(node_slot[head_node[s]]), head_distance[s]);
+        }
+    }
+
+    std::size_t count = 0;
+    for (std::size_t s = 0; s < num_nodes; ++s) {
+        // Cota inferior de Q para la entrada k y todas las siguientes. El
+        // margen cubre el redondeo, para no descartar un empate.
+        const double r_s = row_sums[s];
+        auto pruned = [&](float distance) {
+            const double scaled = factor * distance;
+            const double bound = scaled - r_s - max_sum;
+            return bound - best_q > 1e-12 * (std::abs(scaled) + std::abs(r_s) + std::abs(max_sum));
+        };
+        // La primera entrada, viva o no, acota la fila entera.
+        if (row_length[s] == 0 || pruned(head_distance[s])) {
+            continue;
+        }
+
+        // Las entradas muertas del principio de la fila, las más cercanas y
+        // por tanto las que antes se unen, se quitan para no volver a
+        // recorrerlas.
+        while (row_length[s] > 0 && node_slot[entries[row_begin[s]].node] < 0) {
+            ++row_begin[s];
+            --row_length[s];
+        }
+        update_head(s);
+
+        const Entry* row = entries + row_begin[s];
+        const std::size_t length = row_length[s];
+        for (std::size_t k = 0; k < length; ++k) {
+            if (pruned(row[k].distance)) {
+                break;
+            }
+            ++count;
+            const std::int64_t t = node_slot[row[k].node];
+            if (t >= 0) {
+                consider(s, static_cast<std::size_t>(t), row[k].distance);
+            }
+        }
+    }
+    visited = count;
+    return std::make_pair(best_i, best_j);
+}
+
+void RapidNJSearch::join(const DistanceMatrix& distances, std::size_t i, std::size_t j) {
+    const std::size_t last = distances.size();
+    node_slot[slot_node[i]] = -1;
+    node_slot[slot_node[j]] = -1;
+
+    // Misma permutación que la matriz: la última fila pasa a la i.
+    if (i != last) {
+        slot_node[i] = slot_node[last];
+        row_begin[i] = row_begin[last];
+        row_length[i] = row_length[last];
+        head_distance[i] = head_distance[last];
+        head_node[i] = head_node[last];
+        node_slot[slot_node[i]] = static_cast<std::int64_t>(i);
+    }
+    slot_node.pop_back();
+    row_begin.pop_back();
+    row_length.pop_back();
+    head_distance.pop_back();
+    head_node.pop_back();
+
+    const std::uint32_t new_node = next_node++;
+    slot_node[j] = new_node;
+    node_slot[new_node] = static_cast<std::int64_t>(j);
+    row_begin[j] = used;
+    row_length[j] = 0;
+    append_row(j, distances);
+}
+
+void RapidNJSearch::append_row(std::size_t slot, const DistanceMatrix& distances) {
+    const std::size_t num_nodes = distances.size();
+    if (used + num_nodes > capacity) {
+        compact();
+        row_begin[slot] = used;
+    }
+
+    Entry* first = entries + used;
+    std::size_t length = 0;
+    for (std::size_t k = 0; k < num_nodes; ++k) {
+        if (k != slot) {
+            first[length].distance = distances(slot, k);
+            first[length].node = slot_node[k];
+            ++length;
+        }
+    }
+    std::sort(first, first + length, [](const Entry& x, const Entry& y) {
+        return x.distance < y.distance || (x.distance == y.distance && x.node < y.node);
+    });
+    row_length[slot] = length;
+    used += length;
+    update_head(slot);
+}
+
+void RapidNJSearch::update_head(std::size_t slot) {
+    if (row_length[slot] > 0) {
+        head_distance[slot] = entries[row_begin[slot]].distance;
+        head_node[slot] = entries[row_begin[slot]].node;
+    }
+}
+
+void RapidNJSearch::compact() {
+    // Recorrer las filas en el orden en que están guardadas: cada una se
+    // copia hacia atrás, sin pisar ninguna que quede por leer. Filtrar
+    // conserva el orden, así que no hace falta volver a ordenar.
+    std::vector<std::size_t> order(slot_node.size());
+    for (std::size_t s = 0; s < order.size(); ++s) {
+        order[s] = s;
+    }
+    std::sort(order.begin(), order.end(), [&](std::size_t x, std::size_t y) { return row_begin[x] < row_begin[y]; });
+
+    std::size_t write = 0;
+    for (std::size_t s : order) {
+        const std::size_t begin = row_begin[s];
+        const std::size_t length = row_length[s];
+        row_begin[s] = write;
+        for (std::size_t k = begin; k < begin + length; ++k) {
+            if (node_slot[entries[k].node] >= 0) {
+                entries[write++] = entries[k];
+            }
+        }
+        row_length[s] = write - row_begin[s];
+        update_head(s);
+    }
+    used = write;
+}
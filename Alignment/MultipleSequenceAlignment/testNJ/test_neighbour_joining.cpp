@@ -1,7 +1,17 @@
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <random>
+#include <set>
 #include <vector>
 #include <string>
+#include "distance_table.h"
+#include "kmer_distance.h"
 #include "neighbour_joining.h"
+#include "progressive_alignment.h"
 #include <unordered_map>
 
 int test_node_fusion() {
@@ -52,6 +62,518 @@ int test_node_fusion() {
     return 0;
 }
 
+// Comprueba que la matriz de distancias no depende del número de hilos y
+// coincide con las puntuaciones de NeedlemanWunsch calculadas en serie,
+// convertidas en distancias con las puntuaciones de cada secuencia consigo misma.
+bool test_parallel_distances() {
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<int> length(1, 150);
+
+    std::unordered_map<std::string, std::string> sequences;
+    for (int s = 0; s < 12; ++s) {
+        std::string seq(length(rng), 'A');
+        for (char& c : seq) c = "ACGT"[base(rng)];
+        sequences["Seq" + std::to_string(s)] = seq;
+    }
+
+    NeighbourJoining serial(sequences);
+    serial.set_num_threads(1);
+    serial.calculate_distance_matrix();
+
+    bool ok = true;
+    for (unsigned threads : {2u, 3u, 8u}) {
+        NeighbourJoining parallel(sequences);
+        parallel.set_num_threads(threads);
+        parallel.calculate_distance_matrix();
+        ok = ok && parallel.get_distance_matrix() == serial.get_distance_matrix();
+    }
+
+    // NeighbourJoining numera las secuencias en el orden de iteración del mapa.
+    std::vector<std::string> ordered;
+    for (const auto& entry : sequences) {
+        ordered.push_back(entry.second);
+    }
+    for (size_t i = 0; i < ordered.size(); ++i) {
+        for (size_t j = i + 1; j < ordered.size(); ++j) {
+            NeedlemanWunsch nw(ordered[i], ordered[j], 3, -1, -2);
+            const double self_scores = 3.0 * ordered[i].size() + 3.0 * ordered[j].size();
+            const float expected = static_cast<float>(std::max(0.0, 0.5 * self_scores - nw.score_only()));
+            ok = ok && serial.get_distance_matrix()(i, j) == expected;
+        }
+    }
+
+    std::cout << "Distancias en paralelo: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Camino de cada hoja a la raíz: cada antepasado con la suma de las ramas
+// desde la hoja hasta él.
+typedef std::vector<std::pair<const void*, double>> LeafPath;
+
+void leaf_paths(const NeighbourJoining::Node* node, std::unordered_map<std::string, LeafPath>& paths,
+                LeafPath& ancestors) {
+    if (node->left_child == nullptr && node->right_child == nullptr) {
+        LeafPath path;
+        double length = node->branch_length;
+        for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+            path.emplace_back(it->first, length);
+            length += it->second;
+        }
+        paths[node->id] = path;
+        return;
+    }
+    ancestors.emplace_back(node, node->branch_length);
+    leaf_paths(node->left_child, paths, ancestors);
+    leaf_paths(node->right_child, paths, ancestors);
+    ancestors.pop_back();
+}
+
+// Con distancias aditivas (las de un árbol), Neighbour Joining reconstruye
+// el árbol exacto: la distancia entre dos hojas por el árbol obtenido, sumando
+// ramas hasta su antepasado común, debe coincidir con la de la matriz.
+bool test_additive_tree() {
+    // Árbol ((A:2,B:3):1,(C:4,(D:1,E:2):3):2,F:5) sin raíz.
+    const char* ids[] = {"A", "B", "C", "D", "E", "F"};
+    const double d[6][6] = {
+        {0, 5, 9, 9, 10, 8},
+        {5, 0, 10, 10, 11, 9},
+        {9, 10, 0, 8, 9, 11},
+        {9, 10, 8, 0, 3, 11},
+        {10, 11, 9, 3, 0, 12},
+        {8, 9, 11, 11, 12, 0}
+    };
+    std::unordered_map<std::string, std::string> sequences;
+    for (const char* id : ids) {
+        sequences[id] = "A";
+    }
+    NeighbourJoining nj(sequences);
+    std::vector<std::string> order = nj.get_sequence_ids();
+    std::vector<int> row(order.size());
+    for (size_t k = 0; k < order.size(); ++k) {
+        row[k] = order[k][0] - 'A';
+    }
+    DistanceMatrix distances(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            distances.set(i, j, static_cast<float>(d[row[i]][row[j]]));
+        }
+    }
+    nj.set_distance_matrix(distances);
+    const NeighbourJoining::Node* root = nj.construct_tree();
+
+    std::unordered_map<std::string, LeafPath> paths;
+    LeafPath ancestors;
+    leaf_paths(root, paths, ancestors);
+
+    bool ok = paths.size() == 6;
+    for (int x = 0; x < 6 && ok; ++x) {
+        for (int y = x + 1; y < 6; ++y) {
+            const auto& px = paths[ids[x]];
+            const auto& py = paths[ids[y]];
+            // Primer antepasado común (los caminos van de la hoja a la raíz).
+            double tree_distance = -1.0;
+            for (const auto& a : px) {
+                for (const auto& b : py) {
+                    if (tree_distance < 0.0 && a.first == b.first) {
+                        tree_distance = a.second + b.second;
+                    }
+                }
+                if (tree_distance >= 0.0) {
+                    break;
+                }
+            }
+            ok = ok && std::abs(tree_distance - d[x][y]) < 1e-4;
+        }
+    }
+
+    std::cout << "Árbol aditivo: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// La búsqueda acotada (en memoria y en fichero) construye el mismo árbol que
+// la exhaustiva, también con distancias enteras llenas de empates.
+bool test_rapid_search() {
+    std::mt19937 rng(19);
+    const std::string spill = std::filesystem::temp_directory_path().string();
+
+    bool ok = true;
+    for (int t = 0; t < 40; ++t) {
+        const int n = 3 + t * 3;
+        std::unordered_map<std::string, std::string> sequences;
+        for (int s = 0; s < n; ++s) {
+            sequences["T" + std::to_string(s)] = "A";
+        }
+        std::uniform_int_distribution<int> integer(1, 6);
+        std::uniform_real_distribution<float> real(0.5f, 10.0f);
+        DistanceMatrix distances(n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < i; ++j) {
+                distances.set(i, j, t % 2 == 0 ? static_cast<float>(integer(rng)) : real(rng));
+            }
+        }
+
+        std::string newick[3];
+        for (int mode = 0; mode < 3; ++mode) {
+            NeighbourJoining nj(sequences);
+            nj.set_rapid_search(mode > 0, mode == 2 ? spill : "");
+            nj.set_distance_matrix(distances);
+            newick[mode] = nj.generate_newick_format(nj.construct_tree());
+        }
+        if (newick[1] != newick[0] || newick[2] != newick[0]) {
+            std::cout << "RapidNJ FAIL (n = " << n << ")" << std::endl;
+            ok = false;
+        }
+    }
+
+    std::cout << "Búsqueda acotada (RapidNJ): " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Jerarquía de un agrupamiento: el conjunto de hojas de cada grupo formado,
+// con la distancia a la que se formó.
+std::map<std::vector<size_t>, double> hierarchy(const std::vector<ClusterMerge>& merges, size_t n) {
+    std::vector<std::vector<size_t>> members(n);
+    for (size_t s = 0; s < n; ++s) {
+        members[s] = {s};
+    }
+    std::map<std::vector<size_t>, double> result;
+    for (const ClusterMerge& merge : merges) {
+        std::vector<size_t> both = members[merge.first];
+        both.insert(both.end(), members[merge.second].begin(), members[merge.second].end());
+        std::sort(both.begin(), both.end());
+        result[both] = merge.distance;
+        members.push_back(both);
+    }
+    return result;
+}
+
+// Agrupamiento ingenuo en O(n^3): une siempre la pareja más cercana.
+std::vector<ClusterMerge> naive_linkage(std::vector<std::vector<double>> d, LinkageMethod method) {
+    const size_t n = d.size();
+    std::vector<size_t> cluster(n), size(n, 1);
+    std::vector<bool> alive(n, true);
+    for (size_t s = 0; s < n; ++s) cluster[s] = s;
+    std::vector<ClusterMerge> merges;
+    for (size_t step = 1; step < n; ++step) {
+        size_t a = 0, b = 0;
+        double best = 1e300;
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = i + 1; j < n; ++j)
+                if (alive[i] && alive[j] && d[i][j] < best) { best = d[i][j]; a = i; b = j; }
+        merges.push_back(ClusterMerge{cluster[a], cluster[b], best, size[a] + size[b]});
+        for (size_t k = 0; k < n; ++k) {
+            if (!alive[k] || k == a || k == b) continue;
+            double v = 0.0;
+            if (method == LINKAGE_UPGMA) v = (size[a] * d[a][k] + size[b] * d[b][k]) / (size[a] + size[b]);
+            if (method == LINKAGE_WPGMA) v = 0.5 * (d[a][k] + d[b][k]);
+            if (method == LINKAGE_SINGLE) v = std::min(d[a][k], d[b][k]);
+            if (method == LINKAGE_COMPLETE) v = std::max(d[a][k], d[b][k]);
+            d[a][k] = d[k][a] = v;
+        }
+        alive[b] = false;
+        size[a] += size[b];
+        cluster[a] = n + step - 1;
+    }
+    return merges;
+}
+
+// linkage_clustering() (cadenas de vecinos más cercanos) da la misma
+// jerarquía que el algoritmo ingenuo con los cuatro criterios; UPGMA sobre
+// distancias ultramétricas reconstruye el árbol exacto; y la tabla CSV de
+// kmer_counter.py se lee con la correlación convertida en distancia.
+bool test_linkage() {
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<float> real(0.5f, 10.0f);
+
+    bool ok = true;
+    for (LinkageMethod method : {LINKAGE_UPGMA, LINKAGE_WPGMA, LINKAGE_SINGLE, LINKAGE_COMPLETE}) {
+        for (size_t n : {1u, 2u, 5u, 17u, 60u}) {
+            DistanceMatrix distances(n);
+            std::vector<std::vector<double>> full(n, std::vector<double>(n, 0.0));
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t j = 0; j < i; ++j) {
+                    distances.set(i, j, real(rng));
+                    full[i][j] = full[j][i] = distances(i, j);
+                }
+            }
+            auto fast = hierarchy(linkage_clustering(distances, method), n);
+            auto slow = hierarchy(naive_linkage(full, method), n);
+            bool same = fast.size() == slow.size() && fast.size() == (n > 0 ? n - 1 : 0);
+            for (const auto& entry : slow) {
+                auto found = fast.find(entry.first);
+                same = same && found != fast.end() && std::abs(found->second - entry.second) < 1e-4;
+            }
+            if (!same) {
+                std::cout << "Linkage FAIL (método " << method << ", n = " << n << ")" << std::endl;
+                ok = false;
+            }
+        }
+    }
+
+    // Árbol ultramétrico ((A:1,B:1):2,(C:2,(D:0.5,E:0.5):1.5):1).
+    const char* ids[] = {"A", "B", "C", "D", "E"};
+    const double d[5][5] = {
+        {0, 2, 6, 6, 6},
+        {2, 0, 6, 6, 6},
+        {6, 6, 0, 4, 4},
+        {6, 6, 4, 0, 1},
+        {6, 6, 4, 1, 0}
+    };
+    std::unordered_map<std::string, std::string> sequences;
+    for (const char* id : ids) {
+        sequences[id] = "A";
+    }
+    NeighbourJoining upgma(sequences);
+    upgma.set_tree_method(TREE_UPGMA);
+    std::vector<std::string> order = upgma.get_sequence_ids();
+    DistanceMatrix distances(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            distances.set(i, j, static_cast<float>(d[order[i][0] - 'A'][order[j][0] - 'A']));
+        }
+    }
+    upgma.set_distance_matrix(distances);
+    std::unordered_map<std::string, LeafPath> paths;
+    LeafPath ancestors;
+    leaf_paths(upgma.construct_tree(), paths, ancestors);
+    for (int x = 0; x < 5; ++x) {
+        // Árbol ultramétrico: todas las hojas a la misma distancia de la raíz.
+        ok = ok && paths[ids[x]].size() >= 1 && std::abs(paths[ids[x]].back().second - 3.0) < 1e-6;
+    }
+
+    const std::string csv = (std::filesystem::temp_directory_path() / "test_distance_table.csv").string();
+    {
+        std::ofstream out(csv);
+        out << "Org_1,Org_2,Measure,Value\n"
+            << "X,Y,Euclidean Distance,0.5\nX,Y,Pearson Correlation,0.75\n"
+            << "X,Z,Euclidean Distance,1.5\nX,Z,Pearson Correlation,0.25\n"
+            << "Y,Z,Euclidean Distance,2.5\nY,Z,Pearson Correlation,0.5\n";
+    }
+    std::vector<std::string> table_ids;
+    DistanceMatrix euclidean = read_distance_table(csv, "Euclidean Distance", table_ids);
+    ok = ok && table_ids == std::vector<std::string>{"X", "Y", "Z"} && euclidean(0, 1) == 0.5f &&
+         euclidean(2, 0) == 1.5f && euclidean(1, 2) == 2.5f;
+    DistanceMatrix pearson = read_distance_table(csv, "Pearson Correlation", table_ids);
+    ok = ok && pearson(0, 1) == 0.25f && pearson(0, 2) == 0.75f && pearson(1, 2) == 0.5f;
+    std::filesystem::remove(csv);
+
+    std::cout << "Agrupamiento jerárquico: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Comprueba el alineamiento múltiple progresivo: filas de igual longitud que
+// sin gaps devuelven las secuencias originales, la puntuación de NeedlemanWunsch
+// con dos secuencias, hojas que ya traen gaps y el mismo resultado con
+// cualquier número de hilos.
+bool test_progressive_alignment() {
+    ScoringScheme scoring = ScoringScheme::dna(3, -1, -2);
+    bool ok = true;
+
+    std::unordered_map<std::string, std::string> pair = {{"P", "GATTACAGATTACA"}, {"Q", "GATCACAGTTAGCA"}};
+    NeighbourJoining pair_tree(pair, scoring);
+    pair_tree.calculate_distance_matrix();
+    MultipleAlignment pair_alignment = pair_tree.align_sequences(pair_tree.construct_tree());
+    NeedlemanWunsch nw(pair.at("P"), pair.at("Q"), scoring);
+    ok = ok && pair_alignment.rows.size() == 2 && sum_of_pairs_score(pair_alignment, scoring) == nw.score_only();
+
+    // Una hoja que ya trae gaps se realinea sin ellos: sus bases no se pierden.
+    std::unordered_map<std::string, std::string> gapped = {{"G", "AC-GT"}, {"H", "ACGT"}};
+    NeighbourJoining gapped_tree(gapped, scoring);
+    gapped_tree.calculate_distance_matrix();
+    MultipleAlignment gapped_alignment = gapped_tree.align_sequences(gapped_tree.construct_tree());
+    ok = ok && gapped_alignment.rows == std::vector<std::string>{"ACGT", "ACGT"};
+
+    // Familia de secuencias con mutaciones, inserciones y deleciones.
+    std::mt19937 rng(31);
+    const char bases[] = "ACGT";
+    std::string ancestor;
+    for (int k = 0; k < 120; ++k) {
+        ancestor += bases[rng() % 4];
+    }
+    std::unordered_map<std::string, std::string> family;
+    for (int s = 0; s < 40; ++s) {
+        std::string sequence;
+        for (char c : ancestor) {
+            const unsigned event = rng() % 100;
+            if (event < 8) {
+                sequence += bases[rng() % 4];
+            } else if (event < 11) {
+                sequence += c;
+                sequence += bases[rng() % 4];
+            } else if (event >= 14) {
+                sequence += c;
+            }
+        }
+        family["S" + std::to_string(s)] = sequence;
+    }
+
+    std::vector<MultipleAlignment> results;
+    for (unsigned threads : {1u, 4u}) {
+        NeighbourJoining nj(family, scoring);
+        nj.set_num_threads(threads);
+        nj.calculate_distance_matrix();
+        results.push_back(nj.align_sequences(nj.construct_tree()));
+    }
+    const MultipleAlignment& alignment = results.front();
+    ok = ok && alignment.rows.size() == family.size();
+    for (size_t r = 0; r < alignment.rows.size(); ++r) {
+        std::string ungapped;
+        for (char c : alignment.rows[r]) {
+            if (c != '-') {
+                ungapped += c;
+            }
+        }
+        ok = ok && alignment.rows[r].size() == alignment.rows[0].size() && ungapped == family.at(alignment.ids[r]);
+    }
+    ok = ok && results[1].ids == alignment.ids && results[1].rows == alignment.rows;
+
+    std::cout << "Alineamiento progresivo: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Comprueba las distancias por k-meros frente a un cálculo directo con los
+// k-meros como cadenas, y que NeighbourJoining puede usarlas.
+bool test_kmer_distances() {
+    const std::vector<std::string> sequences = {"ACGTACGTTGCA", "ACGTTCGTTGCAAC", "GGGTACNACGTAC", "acgtacgttgca"};
+    const unsigned k = 3;
+    auto frequencies = [&](const std::string& sequence) {
+        std::map<std::string, double> profile;
+        for (size_t p = 0; p + k <= sequence.size(); ++p) {
+            std::string kmer = sequence.substr(p, k);
+            std::transform(kmer.begin(), kmer.end(), kmer.begin(), ::toupper);
+            if (kmer.find('N') == std::string::npos) {
+                profile[kmer] += 1.0 / static_cast<double>(sequence.size() - k + 1);
+            }
+        }
+        return profile;
+    };
+
+    bool ok = true;
+    for (KmerMeasure measure : {KMER_EUCLIDEAN, KMER_MANHATTAN, KMER_PEARSON}) {
+        KmerDistanceOptions options;
+        options.measure = measure;
+        options.k = k;
+        DistanceMatrix distances = kmer_distance_matrix(sequences, options);
+        for (size_t i = 0; i < sequences.size(); ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                std::map<std::string, double> a = frequencies(sequences[i]);
+                std::map<std::string, double> b = frequencies(sequences[j]);
+                std::vector<double> x, y;
+                for (const auto& entry : a) {
+                    x.push_back(entry.second);
+                    y.push_back(b.count(entry.first) ? b[entry.first] : 0.0);
+                }
+                for (const auto& entry : b) {
+                    if (!a.count(entry.first)) {
+                        x.push_back(0.0);
+                        y.push_back(entry.second);
+                    }
+                }
+                double squares = 0.0, absolute = 0.0, mean_x = 0.0, mean_y = 0.0;
+                for (size_t c = 0; c < x.size(); ++c) {
+                    squares += (x[c] - y[c]) * (x[c] - y[c]);
+                    absolute += std::abs(x[c] - y[c]);
+                    mean_x += x[c] / x.size();
+                    mean_y += y[c] / y.size();
+                }
+                double covariance = 0.0, variance_x = 0.0, variance_y = 0.0;
+                for (size_t c = 0; c < x.size(); ++c) {
+                    covariance += (x[c] - mean_x) * (y[c] - mean_y);
+                    variance_x += (x[c] - mean_x) * (x[c] - mean_x);
+                    variance_y += (y[c] - mean_y) * (y[c] - mean_y);
+                }
+                const double expected = measure == KMER_EUCLIDEAN ? std::sqrt(squares)
+                                        : measure == KMER_MANHATTAN ? absolute
+                                        : 1.0 - covariance / std::sqrt(variance_x * variance_y);
+                ok = ok && std::abs(distances(i, j) - expected) < 1e-5;
+            }
+        }
+    }
+
+    // Con un esbozo mayor que el número de k-meros la Jaccard es exacta;
+    // la última secuencia es la primera en minúsculas, a distancia 0.
+    KmerDistanceOptions mash;
+    mash.k = k;
+    mash.sketch_size = 1000;
+    DistanceMatrix exact = kmer_distance_matrix(sequences, mash);
+    auto canonical_kmers = [&](const std::string& sequence) {
+        std::set<std::string> kmers;
+        for (size_t p = 0; p + k <= sequence.size(); ++p) {
+            std::string kmer = sequence.substr(p, k);
+            std::transform(kmer.begin(), kmer.end(), kmer.begin(), ::toupper);
+            if (kmer.find('N') != std::string::npos) {
+                continue;
+            }
+            std::string reverse(kmer.rbegin(), kmer.rend());
+            for (char& c : reverse) {
+                c = c == 'A' ? 'T' : c == 'C' ? 'G' : c == 'G' ? 'C' : 'A';
+            }
+            kmers.insert(std::min(kmer, reverse));
+        }
+        return kmers;
+    };
+    for (size_t i = 0; i < sequences.size(); ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            std::set<std::string> a = canonical_kmers(sequences[i]);
+            std::set<std::string> b = canonical_kmers(sequences[j]);
+            size_t shared = 0;
+            for (const std::string& kmer : a) {
+                shared += b.count(kmer);
+            }
+            const double jaccard = static_cast<double>(shared) / (a.size() + b.size() - shared);
+            const double expected = jaccard == 0.0 ? 1.0 : std::min(1.0, -std::log(2 * jaccard / (1 + jaccard)) / k);
+            ok = ok && std::abs(exact(i, j) - expected) < 1e-6;
+        }
+    }
+    ok = ok && exact(3, 0) == 0.0f;
+
+    // Esbozos pequeños sobre secuencias largas: mismo resultado con 1 y 4
+    // hilos, y cada genoma más cerca de los de su familia que de los de la otra.
+    std::mt19937 rng(41);
+    const char bases[] = "ACGT";
+    std::unordered_map<std::string, std::string> genomes;
+    for (int family = 0; family < 2; ++family) {
+        std::string ancestor;
+        for (int p = 0; p < 5000; ++p) {
+            ancestor += bases[rng() % 4];
+        }
+        for (int s = 0; s < 4; ++s) {
+            std::string genome = ancestor;
+            for (char& c : genome) {
+                if (rng() % 100 < 2) {
+                    c = bases[rng() % 4];
+                }
+            }
+            genomes[std::string(1, "FG"[family]) + std::to_string(s)] = genome;
+        }
+    }
+    KmerDistanceOptions sketch_options;
+    sketch_options.sketch_size = 200;
+    std::vector<DistanceMatrix> matrices;
+    for (unsigned threads : {1u, 4u}) {
+        NeighbourJoining nj(genomes);
+        nj.set_num_threads(threads);
+        nj.calculate_kmer_distance_matrix(sketch_options);
+        matrices.push_back(nj.get_distance_matrix());
+        std::vector<std::string> ids = nj.get_sequence_ids();
+        for (size_t i = 0; i < ids.size(); ++i) {
+            for (size_t j = 0; j < ids.size(); ++j) {
+                for (size_t m = 0; m < ids.size(); ++m) {
+                    if (i != j && ids[i][0] == ids[j][0] && ids[i][0] != ids[m][0]) {
+                        ok = ok && matrices.back()(i, j) < matrices.back()(i, m);
+                    }
+                }
+            }
+        }
+        ok = ok && nj.construct_tree() != nullptr;
+    }
+    ok = ok && matrices[0] == matrices[1];
+
+    std::cout << "Distancias por k-meros: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
 int main() {
     // Secuencias de prueba en formato unordered_map
     std::unordered_map<std::string, std::string> sequences = {
@@ -63,6 +585,16 @@ int main() {
     };
     // Crear objeto NeighbourJoining
     NeighbourJoining nj(sequences);
+    nj.calculate_distance_matrix();
+    nj.print_distance_matrix();
     nj.build_tree();
-    return 0;
+
+    std::cout << std::endl;
+    bool ok = test_parallel_distances();
+    ok = test_additive_tree() && ok;
+    ok = test_rapid_search() && ok;
+    ok = test_linkage() && ok;
+    ok = test_progressive_alignment() && ok;
+    ok = test_kmer_distances() && ok;
+    return ok ? 0 : 1;
 }
\ No newline at end of file
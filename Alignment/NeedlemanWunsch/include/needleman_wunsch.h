@@ -3,8 +3,14 @@
 #ifndef NEEDLEMAN_WUNSCH_H
 #define NEEDLEMAN_WUNSCH_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
+#include "cigar.h"
+#include "cpu_features.h"
+#include "dp_matrix.h"
+#include "scoring_scheme.h"
 
 class NeedlemanWunsch {
 public:
@@ -12,11 +18,74 @@ public:
     NeedlemanWunsch(const std::string& seq_a, const std::string& seq_b, 
                     int match_score, int mismatch_penalty, int gap_penalty);
 
+    // Constructor con un esquema de puntuación arbitrario (p. ej. BLOSUM62).
+    NeedlemanWunsch(const std::string& seq_a, const std::string& seq_b,
+                    const ScoringScheme& scoring_scheme);
+
+    // Alineador reutilizable: sin secuencias hasta llamar a set_sequences().
+    explicit NeedlemanWunsch(const ScoringScheme& scoring_scheme);
+
+    // Cambia las secuencias a alinear conservando los buffers del objeto
+    // (secuencias, códigos, filas de trabajo, trazas y CIGAR), que sólo
+    // crecen cuando hace falta. Con un mismo objeto para muchas parejas,
+    // align(), score_only() y los modos en banda y afín no reservan memoria
+    // una vez alcanzado el tamaño máximo. Como los métodos const también usan
+    // esos buffers, un objeto no debe usarse desde varios hilos a la vez.
+    void set_sequences(std::string_view seq_a, std::string_view seq_b);
+
     // Ejecutar el algoritmo de Needleman-Wunsch.
     void align();
 
-    // Obtener el alineamiento óptimo tras ejecutar align().
+    // Variante de Hirschberg (divide y vencerás) en memoria O(n + m). Deja
+    // el resultado en get_alignment() / get_alignment_score() igual que
+    // align(); la puntuación es idéntica y el alineamiento es co-óptimo.
+    void align_hirschberg();
+
+    // Sólo la puntuación óptima, con dos filas rotatorias y sin matriz de
+    // trazas. Para cálculos de distancias donde el alineamiento no se usa.
+    int score_only() const;
+
+    // Igual que align() / score_only(), pero rellenando la matriz por bloques
+    // en frente de onda (ver wavefront.h) con num_threads hilos (0 = todos
+    // los núcleos). Puntuación, trazas y alineamiento son idénticos a los de
+    // la versión secuencial; pensado para alineamientos muy largos.
+    void align_wavefront(unsigned num_threads = 0);
+    int score_only_wavefront(unsigned num_threads = 0) const;
+
+    // Puntuaciones de score_only() de `query` frente a cada una de `targets`,
+    // con el núcleo vectorizado entre secuencias (ver nw_batch.h).
+    static std::vector<int> score_batch(const std::string& query, const std::vector<std::string>& targets,
+                                        const ScoringScheme& scoring_scheme,
+                                        SimdLevel level = detect_simd_level());
+
+    // Gaps afines (Gotoh): un gap de longitud L cuesta gap_open + (L - 1) *
+    // gap_extend (ambos negativos, como gap_penalty). Con gap_open ==
+    // gap_extend el resultado coincide con align(). Tres estados H/E/F con
+    // filas contiguas; la traza usa 4 bits por celda.
+    void align_affine(int gap_open, int gap_extend);
+    int score_only_affine(int gap_open, int gap_extend) const;
+
+    // Alineamiento en banda: sólo se calculan las diagonales j - i en
+    // [min(0, m - n) - band_width, max(0, m - n) + band_width], en O(n * w)
+    // celdas, y la traza se guarda comprimida por filas de la banda. El
+    // resultado es el óptimo entre los caminos que caben en la banda.
+    void align_banded(size_t band_width);
+    int score_only_banded(size_t band_width) const;
+
+    // Banda adaptativa: empieza con initial_width y, si el camino elegido
+    // toca un borde de la banda, la duplica mientras lo toque o la última
+    // ampliación haya mejorado la puntuación, sin pasar de max(n, m), que ya
+    // cubre toda la matriz. Es heurística (un camino muy alejado de la
+    // diagonal podría no verse), pensada para secuencias muy parecidas, donde
+    // suele bastar una banda estrecha.
+    void align_adaptive_band(size_t initial_width = 16);
+    int score_only_adaptive_band(size_t initial_width = 16) const;
+
+    // Obtener el alineamiento óptimo tras ejecutar align(). Las dos cadenas
+    // con gaps se reconstruyen en cada llamada a partir del CIGAR.
     std::pair<std::string, std::string> get_alignment() const;
+    // El mismo alineamiento en forma compacta (A consulta, B referencia).
+    const Cigar& get_cigar() const;
     void print_score_matrix() const;
     void print_trace_matrix() const;
     int get_alignment_score() const;
@@ -26,23 +95,54 @@ private:
     void initialize_matrices();
     void calculate_scores_and_traces();
     void traceback_alignment();
+    // Rellena la programación dinámica con dos filas de puntuación rotatorias.
+    // Si se proporciona `scores`, las filas se escriben directamente en ella.
+    int fill_dp(PackedTraceMatrix* traces, DPMatrix<int>* scores) const;
+    // Última fila de la matriz de puntuación de a[a_begin, a_end) frente a
+    // b[b_begin, b_end), o de ambos tramos invertidos si `reverse` es true.
+    void last_row_scores(size_t a_begin, size_t a_end, size_t b_begin, size_t b_end,
+                         bool reverse, std::vector<int>& row) const;
+    int hirschberg(size_t a_begin, size_t a_end, size_t b_begin, size_t b_end);
+    int fill_wavefront(PackedTraceMatrix* traces, unsigned num_threads) const;
+    int fill_affine(AffineTraceMatrix* traces, int gap_open, int gap_extend) const;
+    void traceback_affine(const AffineTraceMatrix& traces);
+    // Rellena la banda de anchura band_width con filas rotatorias. La traza,
+    // si se pide, tiene una columna por diagonal. touches_edge indica si el
+    // camino elegido pasa por un borde de la banda que recorte la matriz.
+    int fill_banded(size_t band_width, PackedTraceMatrix* traces, bool& touches_edge) const;
+    int fill_adaptive_band(size_t initial_width, PackedTraceMatrix* traces, size_t& band_width) const;
+    void traceback_banded(const PackedTraceMatrix& traces, size_t band_width);
 
-    // Secuencias a alinear.
+    // Secuencias a alinear y su codificación en el alfabeto del esquema.
     std::string sequence_a;
     std::string sequence_b;
+    std::vector<std::uint8_t> codes_a;
+    std::vector<std::uint8_t> codes_b;
 
-    // Matrices de puntuación y traza.
-    std::vector<std::vector<int>> score_matrix;
-    std::vector<std::vector<char>> trace_matrix;
+    // Matriz de trazas empaquetada (2 bits por celda). Se reserva en align(),
+    // no en el constructor, para que align_hirschberg() no la necesite. La
+    // matriz de puntuación completa sólo se reconstruye en print_score_matrix().
+    PackedTraceMatrix trace_matrix;
+    int alignment_score;
 
-    // Puntuaciones y penalizaciones.
-    int match;
-    int mismatch;
+    // Puntuaciones y penalizaciones (propias de cada instancia).
+    ScoringScheme scoring;
     int gap;
 
-    // Alineamientos resultantes.
-    std::string aligned_a;
-    std::string aligned_b;
+    // Alineamiento resultante como CIGAR.
+    Cigar cigar;
+
+    // Buffers de trabajo reutilizados entre llamadas (ver set_sequences()).
+    struct Workspace {
+        std::vector<int> prev;
+        std::vector<int> curr;
+        std::vector<int> extra;
+        std::vector<char> prev_edge;
+        std::vector<char> curr_edge;
+        PackedTraceMatrix band_traces;
+        AffineTraceMatrix affine_traces;
+    };
+    mutable Workspace workspace;
 };
 
 #endif // NEEDLEMAN_WUNSCH_H
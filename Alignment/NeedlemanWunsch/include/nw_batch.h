@@ -0,0 +1,40 @@
+// nw_batch.h
+
+#ifndef NW_BATCH_H
+#define NW_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "cpu_features.h"
+
+// Puntuaciones globales (Needleman-Wunsch, gap lineal) de una consulta frente
+// a muchas secuencias, vectorizando entre secuencias: cada carril de 16 bits
+// de un registro SIMD lleva la matriz de una secuencia distinta (8 carriles
+// con SSE4.1, 16 con AVX2 y 32 con AVX-512) y todas avanzan a la vez, fila a
+// fila de la consulta. Rinde mucho más que los núcleos intra-secuencia cuando
+// las secuencias son cortas.
+//
+// Las secuencias vienen codificadas como índices [0, alphabet_size) en la
+// tabla de sustitución `table` (alphabet_size x alphabet_size, por filas).
+// Se agrupan por longitud para que los carriles de un mismo lote tengan
+// longitudes parecidas; las columnas sobrantes de las secuencias más cortas
+// se calculan pero no se leen. Si un lote pudiera salirse del rango de 16
+// bits se calcula en escalar, así que el resultado coincide siempre con
+// NeedlemanWunsch::score_only().
+//
+// `level` elige el juego de instrucciones; un nivel no soportado por la CPU
+// se rebaja al más ancho disponible.
+std::vector<int> needleman_wunsch_batch_scores(const std::vector<std::uint8_t>& query,
+                                               const std::vector<std::vector<std::uint8_t>>& targets,
+                                               const int* table, int alphabet_size, int gap_penalty,
+                                               SimdLevel level = detect_simd_level());
+
+// Igual, sobre las `count` secuencias consecutivas que empiezan en `targets`,
+// sin copiarlas a un vector aparte.
+std::vector<int> needleman_wunsch_batch_scores(const std::vector<std::uint8_t>& query,
+                                               const std::vector<std::uint8_t>* targets, std::size_t count,
+                                               const int* table, int alphabet_size, int gap_penalty,
+                                               SimdLevel level = detect_simd_level());
+
+#endif // NW_BATCH_H
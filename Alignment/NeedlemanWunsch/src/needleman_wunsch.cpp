@@ -1,43 +1,61 @@
 // needleman_wunsch.cpp
+#include <cstddef>
 #include <iostream>
-#include <unordered_map>
 #include <vector>
 #include <string>
 #include <algorithm>
 #include <iomanip>
+#include <limits>
 #include "needleman_wunsch.h"
+#include "nw_batch.h"
+#include "wavefront.h"
 using namespace std;
 
 NeedlemanWunsch::NeedlemanWunsch(const std::string& seq_a, const std::string& seq_b, 
                                  int match_score, int mismatch_penalty, int gap_penalty): 
-    sequence_a(seq_a),
-    sequence_b(seq_b),
-    match(match_score),
-    mismatch(mismatch_penalty),
-    gap(gap_penalty),
-    score_matrix(seq_a.length() + 1, std::vector<int>(seq_b.length() + 1)),
-    trace_matrix(seq_a.length() + 1, std::vector<char>(seq_b.length() + 1)) {
-    // Inicializar las matrices con sus valores iniciales.
-    initialize_matrices();
+    NeedlemanWunsch(seq_a, seq_b, ScoringScheme::dna(match_score, mismatch_penalty, gap_penalty)) {
+}
+
+NeedlemanWunsch::NeedlemanWunsch(const std::string& seq_a, const std::string& seq_b,
+                                 const ScoringScheme& scoring_scheme):
+    NeedlemanWunsch(scoring_scheme) {
+    set_sequences(seq_a, seq_b);
+}
+
+NeedlemanWunsch::NeedlemanWunsch(const ScoringScheme& scoring_scheme):
+    alignment_score(0),
+    scoring(scoring_scheme),
+    gap(scoring_scheme.gap()) {
+}
+
+void NeedlemanWunsch::set_sequences(std::string_view seq_a, std::string_view seq_b) {
+    // assign() y encode() reutilizan la capacidad que ya tengan los buffers.
+    sequence_a.assign(seq_a.data(), seq_a.size());
+    sequence_b.assign(seq_b.data(), seq_b.size());
+    scoring.encode(seq_a, codes_a);
+    scoring.encode(seq_b, codes_b);
+    alignment_score = 0;
+    cigar.clear();
 }
 
 void NeedlemanWunsch::initialize_matrices() {
+    trace_matrix.resize(sequence_a.length() + 1, sequence_b.length() + 1);
+
     // Inicializar la primera fila.
-    for (size_t j = 0; j < score_matrix[0].size(); ++j) {
-        score_matrix[0][j] = j * gap;
-        //score_matrix[0][j] = 0;
-        trace_matrix[0][j] = 'L';  // Indica que viene de la izquierda (gap en secuencia A).
+    for (size_t j = 0; j < trace_matrix.cols(); ++j) {
+        trace_matrix.set(0, j, TRACE_LEFT);  // Indica que viene de la izquierda (gap en secuencia A).
     }
 
     // Inicializar la primera columna.
-    for (size_t i = 0; i < score_matrix.size(); ++i) {
-        score_matrix[i][0] = i * gap;
-        //score_matrix[i][0] = 0;
-        trace_matrix[i][0] = 'U';  // Indica que viene de arriba (gap en secuencia B).
+    for (size_t i = 0; i < trace_matrix.rows(); ++i) {
+        trace_matrix.set(i, 0, TRACE_UP);  // Indica que viene de arriba (gap en secuencia B).
     }
 }
 
 void NeedlemanWunsch::align() {
+    // Inicializar las matrices con sus valores iniciales.
+    initialize_matrices();
+
     // Calcular las puntuaciones y las trazas para cada celda de la matriz.
     calculate_scores_and_traces();
 
@@ -45,48 +63,510 @@ void NeedlemanWunsch::align() {
     traceback_alignment();
 }
 
+void NeedlemanWunsch::align_hirschberg() {
+    cigar.clear();
+
+    alignment_score = hirschberg(0, sequence_a.length(), 0, sequence_b.length());
+}
+
+int NeedlemanWunsch::score_only() const {
+    std::vector<int>& row = workspace.curr;
+    last_row_scores(0, sequence_a.length(), 0, sequence_b.length(), false, row);
+    return row.back();
+}
+
+void NeedlemanWunsch::align_wavefront(unsigned num_threads) {
+    initialize_matrices();
+    alignment_score = fill_wavefront(&trace_matrix, num_threads);
+    traceback_alignment();
+}
+
+int NeedlemanWunsch::score_only_wavefront(unsigned num_threads) const {
+    return fill_wavefront(nullptr, num_threads);
+}
+
+std::vector<int> NeedlemanWunsch::score_batch(const std::string& query, const std::vector<std::string>& targets,
+                                              const ScoringScheme& scoring_scheme, SimdLevel level) {
+    std::vector<std::vector<std::uint8_t>> encoded(targets.size());
+    for (size_t k = 0; k < targets.size(); ++k) {
+        scoring_scheme.encode(targets[k], encoded[k]);
+    }
+    return needleman_wunsch_batch_scores(scoring_scheme.encode(query), encoded, scoring_scheme.data(),
+                                         scoring_scheme.size(), scoring_scheme.gap(), level);
+}
+
+void NeedlemanWunsch::align_affine(int gap_open, int gap_extend) {
+    AffineTraceMatrix& traces = workspace.affine_traces;
+    traces.resize(sequence_a.length() + 1, sequence_b.length() + 1);
+    alignment_score = fill_affine(&traces, gap_open, gap_extend);
+    traceback_affine(traces);
+}
+
+int NeedlemanWunsch::score_only_affine(int gap_open, int gap_extend) const {
+    return fill_affine(nullptr, gap_open, gap_extend);
+}
+
+void NeedlemanWunsch::align_banded(size_t band_width) {
+    PackedTraceMatrix& traces = workspace.band_traces;
+    bool touches_edge = false;
+    alignment_score = fill_banded(band_width, &traces, touches_edge);
+    traceback_banded(traces, band_width);
+}
+
+int NeedlemanWunsch::score_only_banded(size_t band_width) const {
+    bool touches_edge = false;
+    return fill_banded(band_width, nullptr, touches_edge);
+}
+
+void NeedlemanWunsch::align_adaptive_band(size_t initial_width) {
+    PackedTraceMatrix& traces = workspace.band_traces;
+    size_t band_width = 0;
+    alignment_score = fill_adaptive_band(initial_width, &traces, band_width);
+    traceback_banded(traces, band_width);
+}
+
+int NeedlemanWunsch::score_only_adaptive_band(size_t initial_width) const {
+    size_t band_width = 0;
+    return fill_adaptive_band(initial_width, nullptr, band_width);
+}
+
 // Añadido por necesidad para poder calcular los alineamientos múltiples
 int NeedlemanWunsch::get_alignment_score() const {
-    return score_matrix[sequence_a.length()][sequence_b.length()];
+    return alignment_score;
 }
 
 void NeedlemanWunsch::calculate_scores_and_traces() {
-    // Define la puntuación de similaridad basada en una matriz de puntuación.
-    // Añadido por necesidad para poder calcular los alineamientos múltiples
-    auto s = [this](char a, char b) -> int {
-        // Caso especial para manejar gaps
-        if (a == '-' || b == '-') {
-            return gap; // Retorna el costo de gap cuando se compara con '-'
-        }
-
-        static const std::unordered_map<char, std::unordered_map<char, int>> score_map{
-            {'A', {{'A', match}, {'C', mismatch}, {'G', -mismatch}, {'T', mismatch}}},
-            {'C', {{'A', mismatch}, {'C', match}, {'G', mismatch}, {'T', -mismatch}}},
-            {'G', {{'A', -mismatch}, {'C', mismatch}, {'G', match}, {'T', mismatch}}},
-            {'T', {{'A', mismatch}, {'C', -mismatch}, {'G', mismatch}, {'T', match}}},
-        };
-        return score_map.at(a).at(b);
-    };
+    alignment_score = fill_dp(&trace_matrix, nullptr);
+}
 
-    for (size_t i = 1; i < score_matrix.size(); ++i) {
-        for (size_t j = 1; j < score_matrix[0].size(); ++j) {
-            int match_score = score_matrix[i - 1][j - 1] + s(sequence_a[i - 1], sequence_b[j - 1]);
-            int delete_score = score_matrix[i - 1][j] + gap;
-            int insert_score = score_matrix[i][j - 1] + gap;
+int NeedlemanWunsch::fill_dp(PackedTraceMatrix* traces, DPMatrix<int>* scores) const {
+    const size_t rows = sequence_a.length() + 1;
+    const size_t cols = sequence_b.length() + 1;
+
+    // Sin matriz completa sólo hacen falta la fila anterior y la actual.
+    std::vector<int>& rolling = workspace.prev;
+    rolling.resize(scores ? 0 : 2 * cols);
+    int* prev = scores ? scores->row(0) : rolling.data();
+    for (size_t j = 0; j < cols; ++j) {
+        prev[j] = static_cast<int>(j) * gap;
+    }
+
+    for (size_t i = 1; i < rows; ++i) {
+        int* curr = scores ? scores->row(i) : rolling.data() + (i & 1) * cols;
+        curr[0] = static_cast<int>(i) * gap;
+        const int* substitution = scoring.row(codes_a[i - 1]);
+
+        for (size_t j = 1; j < cols; ++j) {
+            int match_score = prev[j - 1] + substitution[codes_b[j - 1]];
+            int delete_score = prev[j] + gap;
+            int insert_score = curr[j - 1] + gap;
             int max_score = std::max({match_score, delete_score, insert_score});
-            
-            score_matrix[i][j] = max_score;
+
+            curr[j] = max_score;
 
             // Actualizar la matriz de trazas.
+            if (traces) {
+                if (max_score == match_score) {
+                    traces->set(i, j, TRACE_DIAG);  // Diagonal
+                } else if (max_score == delete_score) {
+                    traces->set(i, j, TRACE_UP);  // Arriba
+                } else {
+                    traces->set(i, j, TRACE_LEFT);  // Izquierda
+                }
+            }
+        }
+        prev = curr;
+    }
+
+    return prev[cols - 1];
+}
+
+int NeedlemanWunsch::fill_wavefront(PackedTraceMatrix* traces, unsigned num_threads) const {
+    const size_t n = codes_a.size();
+    const size_t m = codes_b.size();
+    if (n == 0 || m == 0) {
+        return fill_dp(traces, nullptr);
+    }
+
+    ThreadPool pool(num_threads);
+    WavefrontGrid grid(n, m, WavefrontGrid::choose_tile(n, m, pool.size()));
+    for (size_t j = 0; j <= m; ++j) {
+        grid.top[j] = static_cast<int>(j) * gap;
+    }
+    for (size_t i = 0; i <= n; ++i) {
+        grid.left[i] = static_cast<int>(i) * gap;
+    }
+    for (size_t tj = 0; tj < grid.tile_cols; ++tj) {
+        grid.corner(0, tj) = grid.top[grid.col_begin(tj) - 1];
+    }
+    for (size_t ti = 0; ti < grid.tile_rows; ++ti) {
+        grid.corner(ti, 0) = grid.left[grid.row_begin(ti) - 1];
+    }
+
+    grid.run(pool, [&](size_t ti, size_t tj) {
+        const size_t r0 = grid.row_begin(ti);
+        const size_t r1 = grid.row_end(ti);
+        const size_t c0 = grid.col_begin(tj);
+        const size_t width = grid.col_end(tj) - c0;
+
+        // prev[k] es la celda (i - 1, c0 + k - 1); prev[0] es la esquina.
+        std::vector<int> prev(width + 1);
+        std::vector<int> curr(width + 1);
+        prev[0] = grid.corner(ti, tj);
+        std::copy(grid.top.begin() + c0, grid.top.begin() + c0 + width, prev.begin() + 1);
+
+        for (size_t i = r0; i < r1; ++i) {
+            curr[0] = grid.left[i];
+            const int* substitution = scoring.row(codes_a[i - 1]);
+
+            for (size_t k = 1; k <= width; ++k) {
+                const size_t j = c0 + k - 1;
+                int match_score = prev[k - 1] + substitution[codes_b[j - 1]];
+                int delete_score = prev[k] + gap;
+                int insert_score = curr[k - 1] + gap;
+                int max_score = std::max({match_score, delete_score, insert_score});
+
+                curr[k] = max_score;
+
+                // Misma traza que fill_dp().
+                if (traces) {
+                    if (max_score == match_score) {
+                        traces->set(i, j, TRACE_DIAG);
+                    } else if (max_score == delete_score) {
+                        traces->set(i, j, TRACE_UP);
+                    } else {
+                        traces->set(i, j, TRACE_LEFT);
+                    }
+                }
+            }
+            grid.left[i] = curr[width];
+            prev.swap(curr);
+        }
+
+        std::copy(prev.begin() + 1, prev.end(), grid.top.begin() + c0);
+        grid.corner(ti + 1, tj + 1) = prev[width];
+    });
+
+    return grid.top[m];
+}
+
+void NeedlemanWunsch::last_row_scores(size_t a_begin, size_t a_end, size_t b_begin, size_t b_end,
+                                      bool reverse, std::vector<int>& row) const {
+    const size_t n = a_end - a_begin;
+    const size_t m = b_end - b_begin;
+    std::vector<int>& prev = workspace.prev;
+    prev.resize(m + 1);
+    row.assign(m + 1, 0);
+
+    for (size_t j = 0; j <= m; ++j) {
+        prev[j] = static_cast<int>(j) * gap;
+    }
+
+    for (size_t i = 1; i <= n; ++i) {
+        row[0] = static_cast<int>(i) * gap;
+        const int* substitution = scoring.row(reverse ? codes_a[a_end - i] : codes_a[a_begin + i - 1]);
+
+        for (size_t j = 1; j <= m; ++j) {
+            const uint8_t b = reverse ? codes_b[b_end - j] : codes_b[b_begin + j - 1];
+            int match_score = prev[j - 1] + substitution[b];
+            int delete_score = prev[j] + gap;
+            int insert_score = row[j - 1] + gap;
+            row[j] = std::max({match_score, delete_score, insert_score});
+        }
+        prev.swap(row);
+    }
+    row.swap(prev);
+}
+
+int NeedlemanWunsch::hirschberg(size_t a_begin, size_t a_end, size_t b_begin, size_t b_end) {
+    const size_t n = a_end - a_begin;
+    const size_t m = b_end - b_begin;
+
+    // Caso base: subproblemas pequeños (o con una secuencia de longitud <= 1)
+    // se resuelven con la versión cuadrática, cuya memoria es despreciable.
+    const size_t base_case_cells = 4096;
+    if (n <= 1 || m <= 1 || (n + 1) * (m + 1) <= base_case_cells) {
+        NeedlemanWunsch block(sequence_a.substr(a_begin, n), sequence_b.substr(b_begin, m), scoring);
+        block.align();
+        cigar.append(block.cigar);
+        return block.get_alignment_score();
+    }
+
+    // Dividir A por la mitad y buscar la columna de B por la que cruza el
+    // camino óptimo: maximiza la suma de la pasada directa y la inversa.
+    const size_t a_mid = a_begin + n / 2;
+    size_t split = 0;
+    int best = 0;
+    {
+        std::vector<int> forward;
+        std::vector<int> backward;
+        last_row_scores(a_begin, a_mid, b_begin, b_end, false, forward);
+        last_row_scores(a_mid, a_end, b_begin, b_end, true, backward);
+
+        best = forward[0] + backward[m];
+        for (size_t k = 1; k <= m; ++k) {
+            if (forward[k] + backward[m - k] > best) {
+                best = forward[k] + backward[m - k];
+                split = k;
+            }
+        }
+    }
+
+    hirschberg(a_begin, a_mid, b_begin, b_begin + split);
+    hirschberg(a_mid, a_end, b_begin + split, b_end);
+    return best;
+}
+
+int NeedlemanWunsch::fill_affine(AffineTraceMatrix* traces, int gap_open, int gap_extend) const {
+    const size_t n = codes_a.size();
+    const size_t m = codes_b.size();
+    const int minus_infinity = std::numeric_limits<int>::min() / 2;
+
+    // H (fila anterior y actual) y F (gap vertical, uno por columna) en
+    // vectores contiguos; E (gap horizontal) se arrastra a lo largo de la fila.
+    std::vector<int>& h_prev = workspace.prev;
+    std::vector<int>& h = workspace.curr;
+    std::vector<int>& f = workspace.extra;
+    h_prev.resize(m + 1);
+    h.resize(m + 1);
+    f.assign(m + 1, minus_infinity);
+
+    h_prev[0] = 0;
+    for (size_t j = 1; j <= m; ++j) {
+        h_prev[j] = gap_open + static_cast<int>(j - 1) * gap_extend;
+        if (traces) {
+            traces->set(0, j, TRACE_LEFT | (j > 1 ? AFFINE_E_EXTEND : 0));
+        }
+    }
+
+    for (size_t i = 1; i <= n; ++i) {
+        const int* substitution = scoring.row(codes_a[i - 1]);
+        h[0] = gap_open + static_cast<int>(i - 1) * gap_extend;
+        if (traces) {
+            traces->set(i, 0, TRACE_UP | (i > 1 ? AFFINE_F_EXTEND : 0));
+        }
+        int e = minus_infinity;
+
+        for (size_t j = 1; j <= m; ++j) {
+            std::uint8_t code = 0;
+
+            // Ante empate se prefiere abrir: con gap_open == gap_extend el
+            // camino es el mismo que el de la versión lineal.
+            const int e_open = h[j - 1] + gap_open;
+            const int e_extend = e + gap_extend;
+            if (e_extend > e_open) {
+                e = e_extend;
+                code |= AFFINE_E_EXTEND;
+            } else {
+                e = e_open;
+            }
+
+            const int f_open = h_prev[j] + gap_open;
+            const int f_extend = f[j] + gap_extend;
+            if (f_extend > f_open) {
+                f[j] = f_extend;
+                code |= AFFINE_F_EXTEND;
+            } else {
+                f[j] = f_open;
+            }
+
+            // Misma preferencia que la traza lineal: diagonal, arriba, izquierda.
+            int best = h_prev[j - 1] + substitution[codes_b[j - 1]];
+            std::uint8_t source = TRACE_DIAG;
+            if (f[j] > best) {
+                best = f[j];
+                source = TRACE_UP;
+            }
+            if (e > best) {
+                best = e;
+                source = TRACE_LEFT;
+            }
+            h[j] = best;
+
+            if (traces) {
+                traces->set(i, j, code | source);
+            }
+        }
+        h_prev.swap(h);
+    }
+
+    return h_prev[m];
+}
+
+void NeedlemanWunsch::traceback_affine(const AffineTraceMatrix& traces) {
+    enum State { IN_H, IN_E, IN_F };
+    State state = IN_H;
+    size_t i = sequence_a.length();
+    size_t j = sequence_b.length();
+
+    cigar.clear();
+
+    while (i > 0 || j > 0) {
+        const std::uint8_t code = traces.get(i, j);
+        if (state == IN_H) {
+            const std::uint8_t source = code & 3;
+            if (source == TRACE_DIAG) {
+                cigar.push_back(CIGAR_MATCH);
+                --i;
+                --j;
+            } else {
+                state = source == TRACE_UP ? IN_F : IN_E;
+            }
+        } else if (state == IN_F) {
+            cigar.push_back(CIGAR_INSERTION);  // Indica un gap en B.
+            state = (code & AFFINE_F_EXTEND) ? IN_F : IN_H;
+            --i;
+        } else {
+            cigar.push_back(CIGAR_DELETION);  // Indica un gap en A.
+            state = (code & AFFINE_E_EXTEND) ? IN_E : IN_H;
+            --j;
+        }
+    }
+
+    // Las operaciones se han añadido del final al principio.
+    cigar.reverse();
+}
+
+int NeedlemanWunsch::fill_banded(size_t band_width, PackedTraceMatrix* traces, bool& touches_edge) const {
+    const ptrdiff_t n = static_cast<ptrdiff_t>(codes_a.size());
+    const ptrdiff_t m = static_cast<ptrdiff_t>(codes_b.size());
+    const ptrdiff_t w = static_cast<ptrdiff_t>(band_width);
+    const ptrdiff_t lower = std::min<ptrdiff_t>(0, m - n) - w;
+    const ptrdiff_t upper = std::max<ptrdiff_t>(0, m - n) + w;
+    const size_t width = static_cast<size_t>(upper - lower + 1);
+    const int minus_infinity = std::numeric_limits<int>::min() / 2;
+
+    // Un borde sólo cuenta si deja fuera celdas de la matriz.
+    const bool lower_clips = lower > -n;
+    const bool upper_clips = upper < m;
+    auto on_edge = [&](ptrdiff_t i, ptrdiff_t j) {
+        return (lower_clips && j - i == lower) || (upper_clips && j - i == upper);
+    };
+
+    // Filas de la banda con un centinela a cada lado: la celda (i, j) ocupa
+    // la posición j - i - lower + 1. Junto a cada puntuación se arrastra si
+    // su camino ha pasado por un borde.
+    std::vector<int>& prev = workspace.prev;
+    std::vector<int>& curr = workspace.curr;
+    std::vector<char>& prev_edge = workspace.prev_edge;
+    std::vector<char>& curr_edge = workspace.curr_edge;
+    prev.assign(width + 2, minus_infinity);
+    curr.assign(width + 2, minus_infinity);
+    prev_edge.assign(width + 2, 0);
+    curr_edge.assign(width + 2, 0);
+    if (traces) {
+        traces->resize(n + 1, width);
+    }
+
+    for (ptrdiff_t j = 0; j <= std::min(m, upper); ++j) {
+        const size_t k = static_cast<size_t>(j - lower + 1);
+        prev[k] = static_cast<int>(j) * gap;
+        prev_edge[k] = on_edge(0, j);
+        if (traces) {
+            traces->set(0, k - 1, TRACE_LEFT);  // Indica que viene de la izquierda (gap en secuencia A).
+        }
+    }
+
+    for (ptrdiff_t i = 1; i <= n; ++i) {
+        std::fill(curr.begin(), curr.end(), minus_infinity);
+        const ptrdiff_t j_begin = std::max<ptrdiff_t>(0, i + lower);
+        const ptrdiff_t j_end = std::min(m, i + upper);
+        const int* substitution = scoring.row(codes_a[i - 1]);
+
+        for (ptrdiff_t j = j_begin; j <= j_end; ++j) {
+            const size_t k = static_cast<size_t>(j - i - lower + 1);
+            if (j == 0) {
+                curr[k] = static_cast<int>(i) * gap;
+                curr_edge[k] = prev_edge[k + 1] || on_edge(i, j);
+                if (traces) {
+                    traces->set(i, k - 1, TRACE_UP);  // Indica que viene de arriba (gap en secuencia B).
+                }
+                continue;
+            }
+
+            // (i-1, j-1) comparte diagonal; (i-1, j) está una a la derecha
+            // y (i, j-1) una a la izquierda.
+            int match_score = prev[k] + substitution[codes_b[j - 1]];
+            int delete_score = prev[k + 1] + gap;
+            int insert_score = curr[k - 1] + gap;
+            int max_score = std::max({match_score, delete_score, insert_score});
+            curr[k] = max_score;
+
+            // Misma preferencia que fill_dp(): diagonal, arriba, izquierda.
+            TraceCode source;
             if (max_score == match_score) {
-                trace_matrix[i][j] = 'D';  // Diagonal
+                source = TRACE_DIAG;
+                curr_edge[k] = prev_edge[k];
             } else if (max_score == delete_score) {
-                trace_matrix[i][j] = 'U';  // Arriba
+                source = TRACE_UP;
+                curr_edge[k] = prev_edge[k + 1];
             } else {
-                trace_matrix[i][j] = 'L';  // Izquierda
+                source = TRACE_LEFT;
+                curr_edge[k] = curr_edge[k - 1];
+            }
+            curr_edge[k] = curr_edge[k] || on_edge(i, j);
+            if (traces) {
+                traces->set(i, k - 1, source);
             }
         }
+        prev.swap(curr);
+        prev_edge.swap(curr_edge);
     }
+
+    const size_t last = static_cast<size_t>(m - n - lower + 1);
+    touches_edge = prev_edge[last] != 0;
+    return prev[last];
+}
+
+int NeedlemanWunsch::fill_adaptive_band(size_t initial_width, PackedTraceMatrix* traces,
+                                        size_t& band_width) const {
+    // Con anchura 0 el borde inferior pasaría por (0, 0) y siempre se tocaría.
+    // Con anchura max(n, m) la banda ya cubre toda la matriz.
+    const size_t full_width = std::max<size_t>({sequence_a.length(), sequence_b.length(), 1});
+    band_width = std::min(std::max<size_t>(initial_width, 1), full_width);
+    bool touches_edge = false;
+    int score = fill_banded(band_width, traces, touches_edge);
+
+    // Si el camino no toca ningún borde basta con la primera pasada. Si no,
+    // se ensancha mientras lo toque o la última ampliación haya mejorado la
+    // puntuación, hasta cubrir la matriz. La última pasada es la que se
+    // devuelve, así que sus trazas corresponden a band_width.
+    bool improved = touches_edge;
+    while ((touches_edge || improved) && band_width < full_width) {
+        const int previous = score;
+        band_width = std::min(band_width * 2, full_width);
+        score = fill_banded(band_width, traces, touches_edge);
+        improved = score > previous;
+    }
+    return score;
+}
+
+void NeedlemanWunsch::traceback_banded(const PackedTraceMatrix& traces, size_t band_width) {
+    const ptrdiff_t n = static_cast<ptrdiff_t>(sequence_a.length());
+    const ptrdiff_t m = static_cast<ptrdiff_t>(sequence_b.length());
+    const ptrdiff_t lower = std::min<ptrdiff_t>(0, m - n) - static_cast<ptrdiff_t>(band_width);
+    ptrdiff_t i = n;
+    ptrdiff_t j = m;
+
+    cigar.clear();
+
+    while (i > 0 || j > 0) {
+        const std::uint8_t code = traces.get(i, static_cast<size_t>(j - i - lower));
+        if (code == TRACE_DIAG) {
+            cigar.push_back(CIGAR_MATCH);
+            --i;
+            --j;
+        } else if (code == TRACE_UP) {
+            cigar.push_back(CIGAR_INSERTION);  // Indica un gap en B.
+            --i;
+        } else {
+            cigar.push_back(CIGAR_DELETION);  // Indica un gap en A.
+            --j;
+        }
+    }
+
+    // Las operaciones se han añadido del final al principio.
+    cigar.reverse();
 }
 
 void NeedlemanWunsch::traceback_alignment() {
@@ -94,55 +574,60 @@ void NeedlemanWunsch::traceback_alignment() {
     size_t i = sequence_a.length();
     size_t j = sequence_b.length();
 
-    std::string alignA;
-    std::string alignB;
+    cigar.clear();
 
     while (i > 0 || j > 0) {
         // Si es diagonal, ambos índices se decrementan.
-        if (i > 0 && j > 0 && trace_matrix[i][j] == 'D') {
-            alignA = sequence_a[i - 1] + alignA;
-            alignB = sequence_b[j - 1] + alignB;
+        if (i > 0 && j > 0 && trace_matrix.get(i, j) == TRACE_DIAG) {
+            cigar.push_back(CIGAR_MATCH);
             --i;
             --j;
         }
         // Si es arriba, se decrementa solo i.
-        else if (i > 0 && trace_matrix[i][j] == 'U') {
-            alignA = sequence_a[i - 1] + alignA;
-            alignB = '-' + alignB;  // Indica un gap en B.
+        else if (i > 0 && trace_matrix.get(i, j) == TRACE_UP) {
+            cigar.push_back(CIGAR_INSERTION);  // Indica un gap en B.
             --i;
         }
         // Si es izquierda, se decrementa solo j.
         else {
-            alignA = '-' + alignA;  // Indica un gap en A.
-            alignB = sequence_b[j - 1] + alignB;
+            cigar.push_back(CIGAR_DELETION);  // Indica un gap en A.
             --j;
         }
     }
 
-    // Asignar los alineamientos a las variables miembro de la clase.
-    aligned_a = alignA;
-    aligned_b = alignB;
+    // Las operaciones se han añadido del final al principio.
+    cigar.reverse();
 }
 
 
 std::pair<std::string, std::string> NeedlemanWunsch::get_alignment() const {
-    return {aligned_a, aligned_b};
+    std::pair<std::string, std::string> alignment;
+    cigar.expand(sequence_a, 0, sequence_b, 0, alignment.first, alignment.second);
+    return alignment;
+}
+
+const Cigar& NeedlemanWunsch::get_cigar() const {
+    return cigar;
 }
 
 
 void NeedlemanWunsch::print_score_matrix() const {
-    for (const auto& row : score_matrix) {
-        for (const auto& cell : row) {
-            std::cout << std::setw(4) << cell;
+    // La matriz completa sólo se materializa aquí, para depuración y visualización.
+    DPMatrix<int> score_matrix(sequence_a.length() + 1, sequence_b.length() + 1);
+    fill_dp(nullptr, &score_matrix);
+
+    for (size_t i = 0; i < score_matrix.rows(); ++i) {
+        for (size_t j = 0; j < score_matrix.cols(); ++j) {
+            std::cout << std::setw(4) << score_matrix(i, j);
         }
         std::cout << std::endl;
     }
 }
 
 void NeedlemanWunsch::print_trace_matrix() const {
-    for (const auto& row : trace_matrix) {
-        for (const auto& cell : row) {
-            std::cout << std::setw(4) << cell;
+    for (size_t i = 0; i < trace_matrix.rows(); ++i) {
+        for (size_t j = 0; j < trace_matrix.cols(); ++j) {
+            std::cout << std::setw(4) << trace_code_to_char(trace_matrix.get(i, j));
         }
         std::cout << std::endl;
     }
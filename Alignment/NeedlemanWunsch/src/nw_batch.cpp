@@ -0,0 +1,119 @@
+// nw_batch.cpp
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+#include "nw_batch.h"
+#include "nw_batch_kernel.h"
+
+namespace {
+
+// Referencia escalar: misma recurrencia que NeedlemanWunsch::score_only().
+int scalar_needleman_wunsch_score(const std::uint8_t* query, std::size_t n,
+                                  const std::uint8_t* target, std::size_t m,
+                                  const int* table, int alphabet_size, int gap_penalty) {
+    std::vector<int> prev(m + 1);
+    std::vector<int> curr(m + 1);
+    for (std::size_t j = 0; j <= m; ++j) {
+        prev[j] = static_cast<int>(j) * gap_penalty;
+    }
+
+    for (std::size_t i = 1; i <= n; ++i) {
+        const int* row = table + query[i - 1] * alphabet_size;
+        curr[0] = static_cast<int>(i) * gap_penalty;
+        for (std::size_t j = 1; j <= m; ++j) {
+            int match_score = prev[j - 1] + row[target[j - 1]];
+            int delete_score = prev[j] + gap_penalty;
+            int insert_score = curr[j - 1] + gap_penalty;
+            curr[j] = std::max({match_score, delete_score, insert_score});
+        }
+        prev.swap(curr);
+    }
+    return prev[m];
+}
+
+std::size_t batch_lanes(SimdLevel level) {
+    switch (level) {
+        case SIMD_AVX512: return 32;
+        case SIMD_AVX2: return 16;
+        case SIMD_SSE41: return 8;
+        default: return 1;
+    }
+}
+
+} // namespace
+
+std::vector<int> needleman_wunsch_batch_scores(const std::vector<std::uint8_t>& query,
+                                               const std::vector<std::vector<std::uint8_t>>& targets,
+                                               const int* table, int alphabet_size, int gap_penalty,
+                                               SimdLevel level) {
+    return needleman_wunsch_batch_scores(query, targets.data(), targets.size(), table, alphabet_size,
+                                         gap_penalty, level);
+}
+
+std::vector<int> needleman_wunsch_batch_scores(const std::vector<std::uint8_t>& query,
+                                               const std::vector<std::uint8_t>* targets, std::size_t count,
+                                               const int* table, int alphabet_size, int gap_penalty,
+                                               SimdLevel level) {
+    level = std::min(level, detect_simd_level());
+    const std::size_t lanes = batch_lanes(level);
+    const std::size_t n = query.size();
+    std::vector<int> scores(count);
+
+    // Ninguna celda supera en valor absoluto (n + m) * max|puntuación|.
+    int max_abs = std::abs(gap_penalty);
+    for (int k = 0; k < alphabet_size * alphabet_size; ++k) {
+        max_abs = std::max(max_abs, std::abs(table[k]));
+    }
+
+    // Lotes de secuencias de longitud parecida, para no calcular columnas de
+    // relleno de más.
+    std::vector<std::size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t x, std::size_t y) {
+        return targets[x].size() < targets[y].size();
+    });
+
+    std::vector<const std::uint8_t*> batch_targets(lanes);
+    std::vector<std::size_t> batch_lengths(lanes);
+    std::vector<int> batch_scores(lanes);
+
+    for (std::size_t first = 0; first < order.size(); first += lanes) {
+        const std::size_t batch_count = std::min(lanes, order.size() - first);
+        const std::size_t longest = targets[order[first + batch_count - 1]].size();
+        for (std::size_t l = 0; l < batch_count; ++l) {
+            batch_targets[l] = targets[order[first + l]].data();
+            batch_lengths[l] = targets[order[first + l]].size();
+        }
+
+        bool done = false;
+        const long long bound = static_cast<long long>(n + longest) * max_abs;
+        if (lanes > 1 && bound <= 32767) {
+            const std::uint8_t* q = query.data();
+            switch (level) {
+                case SIMD_AVX512:
+                    done = nw_batch_avx512(q, n, batch_targets.data(), batch_lengths.data(), batch_count,
+                                           table, alphabet_size, gap_penalty, batch_scores.data());
+                    break;
+                case SIMD_AVX2:
+                    done = nw_batch_avx2(q, n, batch_targets.data(), batch_lengths.data(), batch_count,
+                                         table, alphabet_size, gap_penalty, batch_scores.data());
+                    break;
+                case SIMD_SSE41:
+                    done = nw_batch_sse41(q, n, batch_targets.data(), batch_lengths.data(), batch_count,
+                                          table, alphabet_size, gap_penalty, batch_scores.data());
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        for (std::size_t l = 0; l < batch_count; ++l) {
+            scores[order[first + l]] = done ? batch_scores[l]
+                                            : scalar_needleman_wunsch_score(query.data(), n, batch_targets[l],
+                                                                            batch_lengths[l], table,
+                                                                            alphabet_size, gap_penalty);
+        }
+    }
+    return scores;
+}
@@ -0,0 +1,36 @@
+// nw_batch_avx512.cpp
+// Instanciación AVX-512 del núcleo entre secuencias (32 carriles de 16 bits). Compilar con -mavx512f -mavx512bw.
+#include "nw_batch_kernel.h"
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#include <immintrin.h>
+
+namespace {
+
+struct Avx512Batch16 {
+    typedef __m512i vec;
+    typedef std::int16_t elem;
+    static const int lanes = 32;
+
+    static vec set1(int v) { return _mm512_set1_epi16(static_cast<short>(v)); }
+    static vec adds(vec a, vec b) { return _mm512_adds_epi16(a, b); }
+    static vec max(vec a, vec b) { return _mm512_max_epi16(a, b); }
+};
+
+} // namespace
+
+bool nw_batch_avx512(const std::uint8_t* query, std::size_t n,
+                     const std::uint8_t* const* targets, const std::size_t* lengths, std::size_t count,
+                     const int* table, int alphabet_size, int gap_penalty, int* scores) {
+    batch_pass<Avx512Batch16>(query, n, targets, lengths, count, table, alphabet_size, gap_penalty, scores);
+    return true;
+}
+
+#else
+
+bool nw_batch_avx512(const std::uint8_t*, std::size_t, const std::uint8_t* const*, const std::size_t*, std::size_t,
+                     const int*, int, int, int*) {
+    return false;
+}
+
+#endif
@@ -0,0 +1,95 @@
+// nw_batch_kernel.h
+//
+// Núcleo genérico de Needleman-Wunsch entre secuencias: un lote de hasta
+// Ops::lanes secuencias se rellena a la vez frente a la misma consulta. Igual
+// que sw_striped_kernel.h, cada unidad de traducción por ISA define sus
+// operaciones en un espacio de nombres anónimo y las instancia aquí, sin
+// plantillas de la biblioteca estándar (ver vector_buffer.h).
+//
+// Cada tipo Ops proporciona:
+//   vec, elem (std::int16_t), lanes
+//   set1(int), adds(a, b) (suma con saturación), max(a, b)
+
+#ifndef NW_BATCH_KERNEL_H
+#define NW_BATCH_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include "vector_buffer.h"
+
+// Rellena el lote targets[0, count) (count <= Ops::lanes) y deja en scores[l]
+// la puntuación global de la consulta frente a targets[l]. El llamante
+// garantiza que ninguna celda se sale del rango de 16 bits.
+template <typename Ops>
+void batch_pass(const std::uint8_t* query, std::size_t n,
+                const std::uint8_t* const* targets, const std::size_t* lengths, std::size_t count,
+                const int* table, int alphabet_size, int gap_penalty, int* scores) {
+    typedef typename Ops::vec vec;
+    typedef typename Ops::elem elem;
+    const std::size_t lanes = Ops::lanes;
+
+    std::size_t m = 0;
+    for (std::size_t l = 0; l < count; ++l) {
+        m = lengths[l] > m ? lengths[l] : m;
+    }
+
+    // Perfil por columnas: para cada símbolo c de la consulta y columna j,
+    // el vector cuyo carril l puntúa c frente a targets[l][j]. Los carriles
+    // vacíos o ya terminados puntúan 0.
+    VectorBuffer<Ops> profile(static_cast<std::size_t>(alphabet_size) * m);
+    elem* profile_elements = profile.elements();
+    for (int c = 0; c < alphabet_size; ++c) {
+        const int* row = table + c * alphabet_size;
+        for (std::size_t j = 0; j < m; ++j) {
+            elem* cell = profile_elements + (c * m + j) * lanes;
+            for (std::size_t l = 0; l < count; ++l) {
+                cell[l] = static_cast<elem>(j < lengths[l] ? row[targets[l][j]] : 0);
+            }
+        }
+    }
+
+    // Una fila de la matriz por carril, actualizada en el sitio.
+    VectorBuffer<Ops> row_buffer(m + 1);
+    vec* h = row_buffer.data();
+    for (std::size_t j = 0; j <= m; ++j) {
+        h[j] = Ops::set1(static_cast<int>(j) * gap_penalty);
+    }
+
+    const vec v_gap = Ops::set1(gap_penalty);
+    for (std::size_t i = 1; i <= n; ++i) {
+        const vec* column_profile = profile.data() + query[i - 1] * m;
+        vec diagonal = h[0];
+        vec left = Ops::set1(static_cast<int>(i) * gap_penalty);
+        h[0] = left;
+
+        for (std::size_t j = 1; j <= m; ++j) {
+            const vec up = h[j];
+            vec best = Ops::adds(diagonal, column_profile[j - 1]);
+            best = Ops::max(best, Ops::adds(up, v_gap));
+            best = Ops::max(best, Ops::adds(left, v_gap));
+            diagonal = up;
+            h[j] = best;
+            left = best;
+        }
+    }
+
+    // Cada carril termina en su propia columna.
+    const elem* final_row = row_buffer.elements();
+    for (std::size_t l = 0; l < count; ++l) {
+        scores[l] = final_row[lengths[l] * lanes + l];
+    }
+}
+
+// Puntos de entrada por ISA, con lotes de 8, 16 y 32 carriles. Si el
+// compilador no admite el ISA, devuelven false sin calcular nada.
+bool nw_batch_sse41(const std::uint8_t* query, std::size_t n,
+                    const std::uint8_t* const* targets, const std::size_t* lengths, std::size_t count,
+                    const int* table, int alphabet_size, int gap_penalty, int* scores);
+bool nw_batch_avx2(const std::uint8_t* query, std::size_t n,
+                   const std::uint8_t* const* targets, const std::size_t* lengths, std::size_t count,
+                   const int* table, int alphabet_size, int gap_penalty, int* scores);
+bool nw_batch_avx512(const std::uint8_t* query, std::size_t n,
+                     const std::uint8_t* const* targets, const std::size_t* lengths, std::size_t count,
+                     const int* table, int alphabet_size, int gap_penalty, int* scores);
+
+#endif // NW_BATCH_KERNEL_H
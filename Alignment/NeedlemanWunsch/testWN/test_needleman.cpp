@@ -1,5 +1,485 @@
 #include "needleman_wunsch.h"
+#include <algorithm>
 #include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Puntuación de un alineamiento ya construido, con la misma tabla que
+// NeedlemanWunsch (match 3, mismatch -1, gap -2).
+int rescore_alignment(const std::string& a, const std::string& b) {
+    auto s = [](char x, char y) -> int {
+        if (x == '-' || y == '-') {
+            return -2;
+        }
+        if (x == y) {
+            return 3;
+        }
+        bool transition = (x == 'A' && y == 'G') || (x == 'G' && y == 'A') ||
+                          (x == 'C' && y == 'T') || (x == 'T' && y == 'C');
+        return transition ? 1 : -1;
+    };
+    int score = 0;
+    for (size_t k = 0; k < a.size(); ++k) {
+        score += s(a[k], b[k]);
+    }
+    return score;
+}
+
+// Igual que rescore_alignment() pero con gaps afines: cada tramo de gaps
+// consecutivos en la misma secuencia cuesta gap_open + (L - 1) * gap_extend.
+int rescore_affine(const std::string& a, const std::string& b, int gap_open, int gap_extend) {
+    int score = 0;
+    for (size_t k = 0; k < a.size(); ++k) {
+        if (a[k] == '-' || b[k] == '-') {
+            bool extends = k > 0 && ((a[k] == '-' && a[k - 1] == '-') || (b[k] == '-' && b[k - 1] == '-'));
+            score += extends ? gap_extend : gap_open;
+        } else {
+            score += rescore_alignment(a.substr(k, 1), b.substr(k, 1));
+        }
+    }
+    return score;
+}
+
+std::string remove_gaps(const std::string& s) {
+    std::string result;
+    for (char c : s) {
+        if (c != '-') {
+            result += c;
+        }
+    }
+    return result;
+}
+
+// Comprueba que align_hirschberg() da la misma puntuación que align() y un
+// alineamiento válido con esa misma puntuación.
+bool test_hirschberg_matches_quadratic() {
+    std::vector<std::pair<std::string, std::string>> cases = {
+        {"GCCAATGAC", "TGGCATTCCGA"},
+        {"", ""},
+        {"ACGT", ""},
+        {"", "ACGT"},
+        {"A", "TTTTTTTTTTA"},
+        {"ACGTACGTACGT", "ACGTACGTACGT"},
+    };
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<int> length(0, 300);
+    for (int t = 0; t < 40; ++t) {
+        std::string a(length(rng), 'A');
+        std::string b(length(rng), 'A');
+        for (char& c : a) c = "ACGT"[base(rng)];
+        for (char& c : b) c = "ACGT"[base(rng)];
+        cases.push_back({a, b});
+    }
+
+    bool ok = true;
+    for (const auto& c : cases) {
+        NeedlemanWunsch quadratic(c.first, c.second, 3, -1, -2);
+        quadratic.align();
+        NeedlemanWunsch linear(c.first, c.second, 3, -1, -2);
+        linear.align_hirschberg();
+
+        auto alignment = linear.get_alignment();
+        bool valid = alignment.first.size() == alignment.second.size() &&
+                     remove_gaps(alignment.first) == c.first &&
+                     remove_gaps(alignment.second) == c.second &&
+                     rescore_alignment(alignment.first, alignment.second) == linear.get_alignment_score();
+
+        if (!valid || linear.get_alignment_score() != quadratic.get_alignment_score()) {
+            std::cout << "Hirschberg FAIL: " << c.first << " / " << c.second << std::endl;
+            ok = false;
+        }
+    }
+    std::cout << "Hirschberg vs cuadrático: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Comprueba que score_only() coincide con la puntuación de align().
+bool test_score_only() {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<int> length(0, 120);
+
+    bool ok = true;
+    for (int t = 0; t < 40; ++t) {
+        std::string a(length(rng), 'A');
+        std::string b(length(rng), 'A');
+        for (char& c : a) c = "ACGT"[base(rng)];
+        for (char& c : b) c = "ACGT"[base(rng)];
+
+        NeedlemanWunsch nw(a, b, 3, -1, -2);
+        int score = nw.score_only();
+        nw.align();
+        if (score != nw.get_alignment_score()) {
+            std::cout << "score_only FAIL: " << a << " / " << b << std::endl;
+            ok = false;
+        }
+    }
+    std::cout << "score_only vs align: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Comprueba que cada instancia usa sus propios parámetros (antes la tabla
+// estática se quedaba con los del primer objeto) y las tablas de proteínas.
+bool test_scoring_scheme() {
+    bool ok = true;
+
+    NeedlemanWunsch first("ACGTAG", "ACGTAG", 3, -1, -2);
+    NeedlemanWunsch second("ACGTAG", "ACGTAG", 7, -5, -6);
+    ok = ok && first.score_only() == 18 && second.score_only() == 42;
+
+    // Transición A/G con mismatch -5: la tabla ADN la puntúa +5.
+    NeedlemanWunsch transition("A", "G", 7, -5, -6);
+    ok = ok && transition.score_only() == 5;
+
+    NeedlemanWunsch blosum("WCHk", "WCHK", ScoringScheme::blosum62(-8));
+    ok = ok && blosum.score_only() == 11 + 9 + 8 + 5;
+
+    NeedlemanWunsch pam("WC", "WC", ScoringScheme::pam250(-8));
+    ok = ok && pam.score_only() == 17 + 12;
+
+    NeedlemanWunsch gaps("WW", "W", ScoringScheme::blosum62(-8));
+    ok = ok && gaps.score_only() == 11 - 8;
+
+    bool rejected = false;
+    try {
+        NeedlemanWunsch invalid("ACGN", "ACGT", 3, -1, -2);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    ok = ok && rejected;
+
+    std::cout << "Esquemas de puntuación: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Comprueba los gaps afines: con gap_open == gap_extend reproduce align()
+// exactamente, score_only_affine() coincide con align_affine() y el
+// alineamiento reconstruido tiene la puntuación declarada.
+bool test_affine() {
+    std::mt19937 rng(13);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<int> length(0, 150);
+
+    bool ok = true;
+    for (int t = 0; t < 40; ++t) {
+        std::string a(length(rng), 'A');
+        std::string b(length(rng), 'A');
+        for (char& c : a) c = "ACGT"[base(rng)];
+        for (char& c : b) c = "ACGT"[base(rng)];
+
+        NeedlemanWunsch linear(a, b, 3, -1, -2);
+        linear.align();
+        NeedlemanWunsch same(a, b, 3, -1, -2);
+        same.align_affine(-2, -2);
+        if (same.get_alignment_score() != linear.get_alignment_score() ||
+            same.get_alignment() != linear.get_alignment()) {
+            std::cout << "affine (lineal) FAIL: " << a << " / " << b << std::endl;
+            ok = false;
+        }
+
+        NeedlemanWunsch affine(a, b, 3, -1, -2);
+        affine.align_affine(-5, -1);
+        auto alignment = affine.get_alignment();
+        bool valid = alignment.first.size() == alignment.second.size() &&
+                     remove_gaps(alignment.first) == a && remove_gaps(alignment.second) == b &&
+                     rescore_affine(alignment.first, alignment.second, -5, -1) == affine.get_alignment_score() &&
+                     affine.score_only_affine(-5, -1) == affine.get_alignment_score();
+        if (!valid) {
+            std::cout << "affine FAIL: " << a << " / " << b << std::endl;
+            ok = false;
+        }
+    }
+
+    // Un único gap de longitud 2: 2 * 3 - 4 - 1.
+    NeedlemanWunsch single_gap("AAAA", "AA", 3, -1, -2);
+    single_gap.align_affine(-4, -1);
+    ok = ok && single_gap.get_alignment_score() == 1;
+
+    std::cout << "Gaps afines: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Comprueba el modo en banda: con una banda que cubre toda la matriz
+// reproduce align(), con una banda estrecha el alineamiento respeta la
+// banda, y la banda adaptativa recupera el óptimo en secuencias parecidas.
+bool test_banded() {
+    std::mt19937 rng(19);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<int> length(0, 200);
+    std::uniform_int_distribution<int> edit(0, 29);
+
+    bool ok = true;
+    for (int t = 0; t < 40; ++t) {
+        std::string a(length(rng), 'A');
+        for (char& c : a) c = "ACGT"[base(rng)];
+
+        // B es A con un 10 % de sustituciones, inserciones y borrados.
+        std::string b;
+        for (char c : a) {
+            int e = edit(rng);
+            if (e == 0) {
+                b += "ACGT"[base(rng)];
+            } else if (e == 1) {
+                b += c;
+                b += "ACGT"[base(rng)];
+            } else if (e != 2) {
+                b += c;
+            }
+        }
+
+        NeedlemanWunsch full(a, b, 3, -1, -2);
+        full.align();
+        NeedlemanWunsch wide(a, b, 3, -1, -2);
+        wide.align_banded(a.size() + b.size());
+        if (wide.get_alignment_score() != full.get_alignment_score() ||
+            wide.get_alignment() != full.get_alignment()) {
+            std::cout << "banded (completa) FAIL: " << a << " / " << b << std::endl;
+            ok = false;
+        }
+
+        NeedlemanWunsch narrow(a, b, 3, -1, -2);
+        narrow.align_banded(2);
+        auto alignment = narrow.get_alignment();
+        long offset = 0;
+        long lower = std::min(0L, static_cast<long>(b.size()) - static_cast<long>(a.size())) - 2;
+        long upper = std::max(0L, static_cast<long>(b.size()) - static_cast<long>(a.size())) + 2;
+        bool inside = true;
+        for (size_t k = 0; k < alignment.first.size(); ++k) {
+            offset += (alignment.first[k] == '-') - (alignment.second[k] == '-');
+            inside = inside && offset >= lower && offset <= upper;
+        }
+        bool valid = inside && remove_gaps(alignment.first) == a && remove_gaps(alignment.second) == b &&
+                     rescore_alignment(alignment.first, alignment.second) == narrow.get_alignment_score() &&
+                     narrow.score_only_banded(2) == narrow.get_alignment_score() &&
+                     narrow.get_alignment_score() <= full.get_alignment_score();
+        if (!valid) {
+            std::cout << "banded (estrecha) FAIL: " << a << " / " << b << std::endl;
+            ok = false;
+        }
+
+        NeedlemanWunsch adaptive(a, b, 3, -1, -2);
+        adaptive.align_adaptive_band(1);
+        if (adaptive.get_alignment_score() != full.get_alignment_score() ||
+            adaptive.score_only_adaptive_band(1) != full.get_alignment_score() ||
+            rescore_alignment(adaptive.get_alignment().first, adaptive.get_alignment().second) !=
+                full.get_alignment_score()) {
+            std::cout << "banded (adaptativa) FAIL: " << a << " / " << b << std::endl;
+            ok = false;
+        }
+    }
+
+    // Un borrado y una inserción de 6 bases llevan el camino óptimo 6
+    // diagonales fuera de la banda inicial. Una banda inicial enorme se
+    // recorta a la matriz completa.
+    std::string x = "ACGTTGCAAGCTTACG", y = "TGACCATGGTACCAGT", z = "GATCCGTAAGCTGCAA";
+    NeedlemanWunsch shifted(x + "GGGGGG" + y + z, x + y + "CCCCCC" + z, 3, -1, -2);
+    ok = ok && shifted.score_only_banded(1) < shifted.score_only() &&
+         shifted.score_only_adaptive_band(1) == shifted.score_only() &&
+         shifted.score_only_adaptive_band(size_t(1) << 40) == shifted.score_only();
+
+    std::cout << "Alineamiento en banda: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Comprueba que score_batch() coincide con score_only() en todos los ISA
+// disponibles: lotes incompletos, secuencias vacías, longitudes muy
+// distintas dentro de un lote y lotes que obligan a pasar a escalar.
+bool test_score_batch() {
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<int> length(0, 200);
+
+    std::vector<std::pair<std::string, std::vector<std::string>>> cases;
+    for (int t = 0; t < 6; ++t) {
+        std::string query(length(rng), 'A');
+        for (char& c : query) c = "ACGT"[base(rng)];
+        std::vector<std::string> targets(t * 13);
+        for (std::string& target : targets) {
+            target.assign(length(rng), 'A');
+            for (char& c : target) c = "ACGT"[base(rng)];
+        }
+        cases.push_back({query, targets});
+    }
+    std::string longest(6000, 'A');
+    for (char& c : longest) c = "ACGT"[base(rng)];
+    cases.push_back({longest, {longest, longest.substr(0, 100), ""}});
+
+    bool ok = true;
+    for (const auto& c : cases) {
+        for (int level = SIMD_SCALAR; level <= detect_simd_level(); ++level) {
+            std::vector<int> scores = NeedlemanWunsch::score_batch(c.first, c.second, ScoringScheme::dna(3, -1, -2),
+                                                                   static_cast<SimdLevel>(level));
+            for (size_t k = 0; k < c.second.size(); ++k) {
+                NeedlemanWunsch nw(c.first, c.second[k], 3, -1, -2);
+                if (scores[k] != nw.score_only()) {
+                    std::cout << "score_batch FAIL (" << simd_level_name(static_cast<SimdLevel>(level)) << "): "
+                              << scores[k] << " != " << nw.score_only() << std::endl;
+                    ok = false;
+                }
+            }
+        }
+    }
+
+    std::vector<std::string> proteins = {"WCHK", "", "MKVLAAGIW", "HHHHHHHH", "W"};
+    std::vector<int> scores = NeedlemanWunsch::score_batch("WCHKV", proteins, ScoringScheme::blosum62(-8));
+    for (size_t k = 0; k < proteins.size(); ++k) {
+        NeedlemanWunsch nw("WCHKV", proteins[k], ScoringScheme::blosum62(-8));
+        ok = ok && scores[k] == nw.score_only();
+    }
+
+    std::cout << "score_batch vs score_only: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Matriz de trazas impresa, para comparar dos instancias celda a celda.
+std::string trace_matrix_text(const NeedlemanWunsch& nw) {
+    std::ostringstream text;
+    std::streambuf* previous = std::cout.rdbuf(text.rdbuf());
+    nw.print_trace_matrix();
+    std::cout.rdbuf(previous);
+    return text.str();
+}
+
+// Comprueba que el frente de onda por bloques da exactamente la misma
+// puntuación, matriz de trazas y alineamiento que align() con cualquier
+// número de hilos.
+bool test_wavefront() {
+    std::mt19937 rng(29);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<int> length(0, 700);
+
+    bool ok = true;
+    for (int t = 0; t < 12; ++t) {
+        std::string a(length(rng), 'A');
+        std::string b(length(rng), 'A');
+        for (char& c : a) c = "ACGT"[base(rng)];
+        for (char& c : b) c = "ACGT"[base(rng)];
+
+        NeedlemanWunsch sequential(a, b, 3, -1, -2);
+        sequential.align();
+        for (unsigned threads : {1u, 3u, 4u}) {
+            NeedlemanWunsch wavefront(a, b, 3, -1, -2);
+            wavefront.align_wavefront(threads);
+            if (wavefront.get_alignment_score() != sequential.get_alignment_score() ||
+                wavefront.score_only_wavefront(threads) != sequential.get_alignment_score() ||
+                wavefront.get_alignment() != sequential.get_alignment() ||
+                trace_matrix_text(wavefront) != trace_matrix_text(sequential)) {
+                std::cout << "wavefront FAIL (" << threads << " hilos): " << a << " / " << b << std::endl;
+                ok = false;
+            }
+        }
+    }
+    std::cout << "Frente de onda vs secuencial: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// CIGAR esperado a partir de las dos cadenas con gaps.
+std::string cigar_from_alignment(const std::string& a, const std::string& b) {
+    std::string text;
+    char op = 0;
+    int length = 0;
+    for (size_t k = 0; k <= a.size(); ++k) {
+        char next = k == a.size() ? 0 : (a[k] == '-' ? 'D' : (b[k] == '-' ? 'I' : 'M'));
+        if (next != op && length > 0) {
+            text += std::to_string(length) + op;
+            length = 0;
+        }
+        op = next;
+        ++length;
+    }
+    return text;
+}
+
+// Comprueba que get_cigar() describe el mismo alineamiento que
+// get_alignment() en todos los modos, y algunos casos conocidos.
+bool test_cigar() {
+    std::mt19937 rng(37);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<int> length(0, 300);
+
+    bool ok = true;
+    for (int t = 0; t < 20; ++t) {
+        std::string a(length(rng), 'A');
+        std::string b(length(rng), 'A');
+        for (char& c : a) c = "ACGT"[base(rng)];
+        for (char& c : b) c = "ACGT"[base(rng)];
+
+        NeedlemanWunsch nw(a, b, 3, -1, -2);
+        for (int mode = 0; mode < 4; ++mode) {
+            if (mode == 0) nw.align();
+            if (mode == 1) nw.align_hirschberg();
+            if (mode == 2) nw.align_affine(-5, -1);
+            if (mode == 3) nw.align_adaptive_band(4);
+            auto alignment = nw.get_alignment();
+            const Cigar& cigar = nw.get_cigar();
+            if (cigar.to_string() != cigar_from_alignment(alignment.first, alignment.second) ||
+                cigar.length_a() != a.size() || cigar.length_b() != b.size()) {
+                std::cout << "CIGAR FAIL (modo " << mode << "): " << a << " / " << b << std::endl;
+                ok = false;
+            }
+        }
+    }
+
+    NeedlemanWunsch same("ACGT", "ACGT", 3, -1, -2);
+    same.align();
+    NeedlemanWunsch only_a("ACGT", "", 3, -1, -2);
+    only_a.align();
+    NeedlemanWunsch only_b("", "AC", 3, -1, -2);
+    only_b.align();
+    ok = ok && same.get_cigar().to_string() == "4M" && only_a.get_cigar().to_string() == "4I" &&
+         only_b.get_cigar().to_string() == "2D";
+
+    std::cout << "CIGAR: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Un mismo alineador reutilizado con set_sequences() (secuencias de longitud
+// creciente y decreciente) da los mismos resultados que un objeto nuevo.
+bool test_reuse() {
+    std::mt19937 rng(41);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<int> length(0, 250);
+    const ScoringScheme scheme = ScoringScheme::dna(3, -1, -2);
+
+    bool ok = true;
+    NeedlemanWunsch reused(scheme);
+    for (int t = 0; t < 30; ++t) {
+        std::string a(length(rng), 'A');
+        std::string b(length(rng), 'A');
+        for (char& c : a) c = "ACGT"[base(rng)];
+        for (char& c : b) c = "ACGT"[base(rng)];
+
+        NeedlemanWunsch fresh(a, b, scheme);
+        reused.set_sequences(a, b);
+        for (int mode = 0; mode < 4; ++mode) {
+            int expected = 0;
+            int got = 0;
+            if (mode == 0) { fresh.align(); reused.align(); }
+            if (mode == 1) { fresh.align_affine(-5, -1); reused.align_affine(-5, -1); }
+            if (mode == 2) { fresh.align_adaptive_band(4); reused.align_adaptive_band(4); }
+            if (mode == 3) {
+                expected = fresh.score_only() + fresh.score_only_banded(8);
+                got = reused.score_only() + reused.score_only_banded(8);
+            } else {
+                expected = fresh.get_alignment_score();
+                got = reused.get_alignment_score();
+            }
+            if (got != expected || reused.get_cigar() != fresh.get_cigar() ||
+                reused.get_alignment() != fresh.get_alignment()) {
+                std::cout << "Reuse FAIL (modo " << mode << "): " << a << " / " << b << std::endl;
+                ok = false;
+            }
+        }
+    }
+
+    std::cout << "Reuse: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
 
 int main() {
     // Secuencias de prueba.
@@ -25,5 +505,16 @@ int main() {
     std::cout << "Sequence A: " << alignment.first << std::endl;
     std::cout << "Sequence B: " << alignment.second << std::endl;
 
-    return 0;
+    std::cout << std::endl;
+    bool ok = test_hirschberg_matches_quadratic();
+    ok = test_score_only() && ok;
+    ok = test_scoring_scheme() && ok;
+    ok = test_affine() && ok;
+    ok = test_banded() && ok;
+    ok = test_score_batch() && ok;
+    ok = test_wavefront() && ok;
+    ok = test_cigar() && ok;
+    ok = test_reuse() && ok;
+
+    return ok ? 0 : 1;
 }
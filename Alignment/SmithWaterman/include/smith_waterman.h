@@ -3,22 +3,67 @@
 #ifndef SMITH_WATERMAN_H
 #define SMITH_WATERMAN_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
+#include "cigar.h"
+#include "dp_matrix.h"
+#include "cpu_features.h"
+#include "scoring_scheme.h"
 
 class SmithWaterman {
 public:
+    // Resultado de score_only(): mejor puntuación local y celda donde termina.
+    // end_a y end_b son posiciones exclusivas, es decir, el alineamiento acaba
+    // en sequence_a[end_a - 1] y sequence_b[end_b - 1] (0 si no hay ninguno).
+    struct LocalScore {
+        int score;
+        size_t end_a;
+        size_t end_b;
+    };
+
     // Constructor que toma las secuencias y los parámetros de puntuación.
     SmithWaterman(const std::string& seq_a, const std::string& seq_b, 
                     int match_score, int mismatch_penalty, int gap_penalty);
 
-    // Ejecutar el algoritmo de Needleman-Wunsch.
+    // Constructor con un esquema de puntuación arbitrario (p. ej. BLOSUM62).
+    SmithWaterman(const std::string& seq_a, const std::string& seq_b,
+                  const ScoringScheme& scoring_scheme);
+
+    // Ejecutar el algoritmo de Smith-Waterman.
     void align();
 
-    // Obtener el alineamiento óptimo tras ejecutar align().
+    // Sólo la mejor puntuación local y sus coordenadas finales, con dos filas
+    // rotatorias y sin matriz de trazas.
+    LocalScore score_only() const;
+
+    // Misma puntuación que score_only().score con el núcleo vectorizado
+    // striped (ver sw_striped.h), usando el juego de instrucciones `level`.
+    int score_simd(SimdLevel level = detect_simd_level()) const;
+
+    // Igual que align() / score_only(), pero rellenando la matriz por bloques
+    // en frente de onda (ver wavefront.h) con num_threads hilos (0 = todos
+    // los núcleos). Puntuación, celda final, trazas y alineamiento son
+    // idénticos a los de la versión secuencial.
+    void align_wavefront(unsigned num_threads = 0);
+    LocalScore score_only_wavefront(unsigned num_threads = 0) const;
+
+    // Gaps afines (Gotoh): un gap de longitud L cuesta gap_open + (L - 1) *
+    // gap_extend. Con gap_open == gap_extend coincide con align() y
+    // score_only().
+    void align_affine(int gap_open, int gap_extend);
+    LocalScore score_only_affine(int gap_open, int gap_extend) const;
+
+    // Obtener el alineamiento óptimo tras ejecutar align(). Las dos cadenas
+    // con gaps se reconstruyen en cada llamada a partir del CIGAR.
     std::pair<std::string, std::string> get_alignment() const;
+    // El mismo alineamiento en forma compacta (A consulta, B referencia) y
+    // las posiciones de A y B donde empieza.
+    const Cigar& get_cigar() const;
+    std::pair<size_t, size_t> get_alignment_begin() const;
     void print_score_matrix() const;
     void print_trace_matrix() const;
+    int get_alignment_score() const;
 
 
 private:
@@ -26,23 +71,40 @@ private:
     void initialize_matrices();
     void calculate_scores_and_traces();
     void traceback_alignment();
+    // Rellena la programación dinámica con dos filas de puntuación rotatorias
+    // y registra la primera celda (en orden de filas) con la puntuación máxima.
+    void fill_dp(PackedTraceMatrix* traces, DPMatrix<int>* scores,
+                 int& best_score, size_t& best_i, size_t& best_j) const;
+    void fill_wavefront(PackedTraceMatrix* traces, unsigned num_threads,
+                        int& best_score, size_t& best_i, size_t& best_j) const;
+    void fill_affine(AffineTraceMatrix* traces, int gap_open, int gap_extend,
+                     int& best_score, size_t& best_i, size_t& best_j) const;
+    void traceback_affine(const AffineTraceMatrix& traces, int gap_open, int gap_extend);
 
-    // Secuencias a alinear.
+    // Secuencias a alinear y su codificación en el alfabeto del esquema.
     std::string sequence_a;
     std::string sequence_b;
+    std::vector<std::uint8_t> codes_a;
+    std::vector<std::uint8_t> codes_b;
+
+    // Matriz de trazas empaquetada (2 bits por celda). Se reserva en align(),
+    // no en el constructor, para que score_only() no la necesite. La matriz
+    // de puntuación completa sólo se reconstruye en print_score_matrix().
+    PackedTraceMatrix trace_matrix;
 
-    // Matrices de puntuación y traza.
-    std::vector<std::vector<int>> score_matrix;
-    std::vector<std::vector<char>> trace_matrix;
+    // Celda de máxima puntuación, punto de partida del trazado.
+    int max_value;
+    size_t max_i;
+    size_t max_j;
 
-    // Puntuaciones y penalizaciones.
-    int match;
-    int mismatch;
+    // Puntuaciones y penalizaciones (propias de cada instancia).
+    ScoringScheme scoring;
     int gap;
 
-    // Alineamientos resultantes.
-    std::string aligned_a;
-    std::string aligned_b;
+    // Alineamiento resultante como CIGAR, desde (begin_a, begin_b).
+    size_t begin_a;
+    size_t begin_b;
+    Cigar cigar;
 };
 
 #endif // SMITH_WATERMAN_H
@@ -0,0 +1,26 @@
+// sw_striped.h
+
+#ifndef SW_STRIPED_H
+#define SW_STRIPED_H
+
+#include <cstddef>
+#include <cstdint>
+#include "cpu_features.h"
+
+// Puntuación de Smith-Waterman con penalización de gap lineal mediante el
+// núcleo vectorizado "striped" de Farrar con perfil de consulta.
+//
+// Las secuencias vienen codificadas como índices [0, alphabet_size) en la
+// tabla de sustitución `table` (alphabet_size x alphabet_size, por filas).
+// El núcleo empieza con carriles de 8 bits con saturación y, si la puntuación
+// satura, repite la pasada con carriles de 16 y después de 32 bits, de modo
+// que el resultado es siempre idéntico al de la versión escalar.
+//
+// `level` elige el juego de instrucciones; un nivel no soportado por la CPU
+// se rebaja al más ancho disponible.
+int striped_smith_waterman_score(const std::uint8_t* query, std::size_t query_length,
+                                 const std::uint8_t* target, std::size_t target_length,
+                                 const int* table, int alphabet_size, int gap_penalty,
+                                 SimdLevel level = detect_simd_level());
+
+#endif // SW_STRIPED_H
@@ -1,144 +1,414 @@
 // needleman_wunsch.cpp
 #include <iostream>
-#include <unordered_map>
 #include <vector>
 #include <string>
 #include <algorithm>
 #include <iomanip>
+#include <limits>
 #include "smith_waterman.h"
+#include "sw_striped.h"
+#include "wavefront.h"
 using namespace std;
 
 SmithWaterman::SmithWaterman(const std::string& seq_a, const std::string& seq_b, 
                                  int match_score, int mismatch_penalty, int gap_penalty): 
+    SmithWaterman(seq_a, seq_b, ScoringScheme::dna(match_score, mismatch_penalty, gap_penalty)) {
+}
+
+SmithWaterman::SmithWaterman(const std::string& seq_a, const std::string& seq_b,
+                             const ScoringScheme& scoring_scheme):
     sequence_a(seq_a),
     sequence_b(seq_b),
-    match(match_score),
-    mismatch(mismatch_penalty),
-    gap(gap_penalty),
-    score_matrix(seq_a.length() + 1, std::vector<int>(seq_b.length() + 1)),
-    trace_matrix(seq_a.length() + 1, std::vector<char>(seq_b.length() + 1)) {
-    // Inicializar las matrices con sus valores iniciales.
-    initialize_matrices();
+    codes_a(scoring_scheme.encode(seq_a)),
+    codes_b(scoring_scheme.encode(seq_b)),
+    max_value(0),
+    max_i(0),
+    max_j(0),
+    scoring(scoring_scheme),
+    gap(scoring_scheme.gap()),
+    begin_a(0),
+    begin_b(0) {
 }
 
 void SmithWaterman::initialize_matrices() {
-    // Inicializar la primera fila.
-    for (size_t j = 0; j < score_matrix[0].size(); ++j) {
-        // score_matrix[0][j] = j * gap;
-        score_matrix[0][j] = 0;
-        trace_matrix[0][j] = 'L';  // Indica que viene de la izquierda (gap en secuencia A).
+    trace_matrix.resize(sequence_a.length() + 1, sequence_b.length() + 1);
+
+    // Inicializar la primera fila. Las puntuaciones del borde son 0 y se
+    // generan directamente en fill_dp().
+    for (size_t j = 0; j < trace_matrix.cols(); ++j) {
+        trace_matrix.set(0, j, TRACE_LEFT);  // Indica que viene de la izquierda (gap en secuencia A).
     }
 
     // Inicializar la primera columna.
-    for (size_t i = 0; i < score_matrix.size(); ++i) {
-        //score_matrix[i][0] = i * gap;
-        score_matrix[i][0] = 0;
-        trace_matrix[i][0] = 'U';  // Indica que viene de arriba (gap en secuencia B).
+    for (size_t i = 0; i < trace_matrix.rows(); ++i) {
+        trace_matrix.set(i, 0, TRACE_UP);  // Indica que viene de arriba (gap en secuencia B).
     }
 }
 
 void SmithWaterman::align() {
+    initialize_matrices();
+
     calculate_scores_and_traces();
 
     traceback_alignment();
 }
 
+SmithWaterman::LocalScore SmithWaterman::score_only() const {
+    LocalScore result;
+    fill_dp(nullptr, nullptr, result.score, result.end_a, result.end_b);
+    return result;
+}
+
+int SmithWaterman::score_simd(SimdLevel level) const {
+    return striped_smith_waterman_score(codes_a.data(), codes_a.size(), codes_b.data(), codes_b.size(),
+                                        scoring.data(), scoring.size(), gap, level);
+}
+
+void SmithWaterman::align_wavefront(unsigned num_threads) {
+    initialize_matrices();
+    fill_wavefront(&trace_matrix, num_threads, max_value, max_i, max_j);
+    traceback_alignment();
+}
+
+SmithWaterman::LocalScore SmithWaterman::score_only_wavefront(unsigned num_threads) const {
+    LocalScore result;
+    fill_wavefront(nullptr, num_threads, result.score, result.end_a, result.end_b);
+    return result;
+}
+
+void SmithWaterman::align_affine(int gap_open, int gap_extend) {
+    AffineTraceMatrix traces(sequence_a.length() + 1, sequence_b.length() + 1);
+    fill_affine(&traces, gap_open, gap_extend, max_value, max_i, max_j);
+    traceback_affine(traces, gap_open, gap_extend);
+}
+
+SmithWaterman::LocalScore SmithWaterman::score_only_affine(int gap_open, int gap_extend) const {
+    LocalScore result;
+    fill_affine(nullptr, gap_open, gap_extend, result.score, result.end_a, result.end_b);
+    return result;
+}
+
+int SmithWaterman::get_alignment_score() const {
+    return max_value;
+}
+
 void SmithWaterman::calculate_scores_and_traces() {
-    // Define la puntuación de similaridad basada en una matriz de puntuación.
-    auto s = [this](char a, char b) -> int {
-        static const std::unordered_map<char, std::unordered_map<char, int>> score_map{
-            {'A', {{'A', match}, {'C', mismatch}, {'G', -mismatch}, {'T', mismatch}}},
-            {'C', {{'A', mismatch}, {'C', match}, {'G', mismatch}, {'T', -mismatch}}},
-            {'G', {{'A', -mismatch}, {'C', mismatch}, {'G', match}, {'T', mismatch}}},
-            {'T', {{'A', mismatch}, {'C', -mismatch}, {'G', mismatch}, {'T', match}}},
-        };
-        return score_map.at(a).at(b);
-    };
-
-    for (size_t i = 1; i < score_matrix.size(); ++i) {
-        for (size_t j = 1; j < score_matrix[i].size(); ++j) {
-            int match_score = score_matrix[i - 1][j - 1] + s(sequence_a[i - 1], sequence_b[j - 1]);
-            int delete_score = score_matrix[i - 1][j] + gap;
-            int insert_score = score_matrix[i][j - 1] + gap;
+    fill_dp(&trace_matrix, nullptr, max_value, max_i, max_j);
+}
+
+void SmithWaterman::fill_dp(PackedTraceMatrix* traces, DPMatrix<int>* scores,
+                            int& best_score, size_t& best_i, size_t& best_j) const {
+    const size_t rows = sequence_a.length() + 1;
+    const size_t cols = sequence_b.length() + 1;
+
+    // Sin matriz completa sólo hacen falta la fila anterior y la actual.
+    std::vector<int> rolling(scores ? 0 : 2 * cols);
+    int* prev = scores ? scores->row(0) : rolling.data();
+    std::fill(prev, prev + cols, 0);
+
+    best_score = 0;
+    best_i = 0;
+    best_j = 0;
+
+    for (size_t i = 1; i < rows; ++i) {
+        int* curr = scores ? scores->row(i) : rolling.data() + (i & 1) * cols;
+        curr[0] = 0;
+        const int* substitution = scoring.row(codes_a[i - 1]);
+
+        for (size_t j = 1; j < cols; ++j) {
+            int match_score = prev[j - 1] + substitution[codes_b[j - 1]];
+            int delete_score = prev[j] + gap;
+            int insert_score = curr[j - 1] + gap;
 
             int max_score = std::max({0, match_score, delete_score, insert_score});  
 
-            score_matrix[i][j] = max_score;
+            curr[j] = max_score;
+
+            // El primer máximo en orden de filas es el punto de partida del trazado.
+            if (max_score > best_score) {
+                best_score = max_score;
+                best_i = i;
+                best_j = j;
+            }
 
             // Actualizar la matriz de trazas.
-            if (max_score == match_score) {
-                trace_matrix[i][j] = 'D';  // Diagonal
-            } else if (max_score == delete_score) {
-                trace_matrix[i][j] = 'U';  // Arriba
+            if (traces) {
+                if (max_score == match_score) {
+                    traces->set(i, j, TRACE_DIAG);  // Diagonal
+                } else if (max_score == delete_score) {
+                    traces->set(i, j, TRACE_UP);  // Arriba
+                } else {
+                    traces->set(i, j, TRACE_LEFT);  // Izquierda
+                }
+            }
+        }
+        prev = curr;
+    }
+}
+
+void SmithWaterman::fill_wavefront(PackedTraceMatrix* traces, unsigned num_threads,
+                                   int& best_score, size_t& best_i, size_t& best_j) const {
+    const size_t n = codes_a.size();
+    const size_t m = codes_b.size();
+    best_score = 0;
+    best_i = 0;
+    best_j = 0;
+    if (n == 0 || m == 0) {
+        return;
+    }
+
+    // El borde de Smith-Waterman vale 0 en todas partes.
+    ThreadPool pool(num_threads);
+    WavefrontGrid grid(n, m, WavefrontGrid::choose_tile(n, m, pool.size()));
+
+    // Mejor celda de cada bloque: la primera en orden de filas dentro del bloque.
+    std::vector<LocalScore> tile_best(grid.tile_rows * grid.tile_cols, LocalScore{0, 0, 0});
+
+    grid.run(pool, [&](size_t ti, size_t tj) {
+        const size_t r0 = grid.row_begin(ti);
+        const size_t r1 = grid.row_end(ti);
+        const size_t c0 = grid.col_begin(tj);
+        const size_t width = grid.col_end(tj) - c0;
+        LocalScore& best = tile_best[ti * grid.tile_cols + tj];
+
+        // prev[k] es la celda (i - 1, c0 + k - 1); prev[0] es la esquina.
+        std::vector<int> prev(width + 1);
+        std::vector<int> curr(width + 1);
+        prev[0] = grid.corner(ti, tj);
+        std::copy(grid.top.begin() + c0, grid.top.begin() + c0 + width, prev.begin() + 1);
+
+        for (size_t i = r0; i < r1; ++i) {
+            curr[0] = grid.left[i];
+            const int* substitution = scoring.row(codes_a[i - 1]);
+
+            for (size_t k = 1; k <= width; ++k) {
+                const size_t j = c0 + k - 1;
+                int match_score = prev[k - 1] + substitution[codes_b[j - 1]];
+                int delete_score = prev[k] + gap;
+                int insert_score = curr[k - 1] + gap;
+                int max_score = std::max({0, match_score, delete_score, insert_score});
+
+                curr[k] = max_score;
+
+                if (max_score > best.score) {
+                    best.score = max_score;
+                    best.end_a = i;
+                    best.end_b = j;
+                }
+
+                // Misma traza que fill_dp().
+                if (traces) {
+                    if (max_score == match_score) {
+                        traces->set(i, j, TRACE_DIAG);
+                    } else if (max_score == delete_score) {
+                        traces->set(i, j, TRACE_UP);
+                    } else {
+                        traces->set(i, j, TRACE_LEFT);
+                    }
+                }
+            }
+            grid.left[i] = curr[width];
+            prev.swap(curr);
+        }
+
+        std::copy(prev.begin() + 1, prev.end(), grid.top.begin() + c0);
+        grid.corner(ti + 1, tj + 1) = prev[width];
+    });
+
+    // Entre bloques, el empate se resuelve también por orden de filas.
+    for (const LocalScore& best : tile_best) {
+        const bool earlier = best.end_a < best_i || (best.end_a == best_i && best.end_b < best_j);
+        if (best.score > best_score || (best.score == best_score && best.score > 0 && earlier)) {
+            best_score = best.score;
+            best_i = best.end_a;
+            best_j = best.end_b;
+        }
+    }
+}
+
+void SmithWaterman::fill_affine(AffineTraceMatrix* traces, int gap_open, int gap_extend,
+                                int& best_score, size_t& best_i, size_t& best_j) const {
+    const size_t n = codes_a.size();
+    const size_t m = codes_b.size();
+    const int minus_infinity = std::numeric_limits<int>::min() / 2;
+
+    // H (fila anterior y actual) y F (gap vertical) en vectores contiguos; E
+    // (gap horizontal) se arrastra a lo largo de la fila. El borde vale 0.
+    std::vector<int> h_prev(m + 1, 0);
+    std::vector<int> h(m + 1, 0);
+    std::vector<int> f(m + 1, minus_infinity);
+
+    best_score = 0;
+    best_i = 0;
+    best_j = 0;
+
+    for (size_t i = 1; i <= n; ++i) {
+        const int* substitution = scoring.row(codes_a[i - 1]);
+        int e = minus_infinity;
+
+        for (size_t j = 1; j <= m; ++j) {
+            std::uint8_t code = 0;
+
+            // Ante empate se prefiere abrir, como en NeedlemanWunsch::fill_affine().
+            const int e_open = h[j - 1] + gap_open;
+            const int e_extend = e + gap_extend;
+            if (e_extend > e_open) {
+                e = e_extend;
+                code |= AFFINE_E_EXTEND;
             } else {
-                trace_matrix[i][j] = 'L';  // Izquierda
+                e = e_open;
+            }
+
+            const int f_open = h_prev[j] + gap_open;
+            const int f_extend = f[j] + gap_extend;
+            if (f_extend > f_open) {
+                f[j] = f_extend;
+                code |= AFFINE_F_EXTEND;
+            } else {
+                f[j] = f_open;
+            }
+
+            int best = h_prev[j - 1] + substitution[codes_b[j - 1]];
+            std::uint8_t source = TRACE_DIAG;
+            if (f[j] > best) {
+                best = f[j];
+                source = TRACE_UP;
+            }
+            if (e > best) {
+                best = e;
+                source = TRACE_LEFT;
+            }
+            h[j] = std::max(best, 0);
+
+            if (h[j] > best_score) {
+                best_score = h[j];
+                best_i = i;
+                best_j = j;
+            }
+
+            if (traces) {
+                traces->set(i, j, code | source);
             }
         }
+        h_prev.swap(h);
     }
 }
 
-void SmithWaterman::traceback_alignment() {
-    std::string alignA;
-    std::string alignB;
-
-    // Encontrar el valor máximo en la matriz para comenzar el trazado
-    int max_value = 0;
-    size_t max_i = 0, max_j = 0;
-    for (size_t i = 0; i < score_matrix.size(); ++i) {
-        for (size_t j = 0; j < score_matrix[i].size(); ++j) {
-            if (score_matrix[i][j] > max_value) {
-                max_value = score_matrix[i][j];
-                max_i = i;
-                max_j = j;
+void SmithWaterman::traceback_affine(const AffineTraceMatrix& traces, int gap_open, int gap_extend) {
+    enum State { IN_H, IN_E, IN_F };
+    State state = IN_H;
+    size_t i = max_i, j = max_j;
+
+    // Igual que en traceback_alignment(), la puntuación del estado actual se
+    // recupera restando la contribución de cada paso; el alineamiento local
+    // empieza donde H vuelve a valer 0.
+    int score = max_value;
+
+    cigar.clear();
+
+    while (i > 0 && j > 0 && (state != IN_H || score > 0)) {
+        const std::uint8_t code = traces.get(i, j);
+        if (state == IN_H) {
+            const std::uint8_t source = code & 3;
+            if (source == TRACE_DIAG) {
+                score -= scoring.score(codes_a[i - 1], codes_b[j - 1]);
+                cigar.push_back(CIGAR_MATCH);
+                --i;
+                --j;
+            } else {
+                state = source == TRACE_UP ? IN_F : IN_E;
             }
+        } else if (state == IN_F) {
+            const bool extend = (code & AFFINE_F_EXTEND) != 0;
+            score -= extend ? gap_extend : gap_open;
+            cigar.push_back(CIGAR_INSERTION);  // Indica un gap en B.
+            state = extend ? IN_F : IN_H;
+            --i;
+        } else {
+            const bool extend = (code & AFFINE_E_EXTEND) != 0;
+            score -= extend ? gap_extend : gap_open;
+            cigar.push_back(CIGAR_DELETION);  // Indica un gap en A.
+            state = extend ? IN_E : IN_H;
+            --j;
         }
     }
 
+    // Las operaciones se han añadido del final al principio.
+    cigar.reverse();
+    begin_a = i;
+    begin_b = j;
+}
+
+void SmithWaterman::traceback_alignment() {
+    cigar.clear();
+
     // Iniciar el trazado desde la posición del valor máximo
     size_t i = max_i, j = max_j;
 
+    // Sin matriz de puntuación, la puntuación de cada celda del camino se
+    // recupera restando la contribución de cada paso: mientras sea positiva,
+    // la traza coincide exactamente con el predecesor que dio el máximo.
+    int score = max_value;
+
     // Continuar el trazado hasta llegar a un valor cero
-    while (i > 0 && j > 0 && score_matrix[i][j] > 0) {
-        if (trace_matrix[i][j] == 'D') {  // Diagonal
-            alignA = sequence_a[i - 1] + alignA;
-            alignB = sequence_b[j - 1] + alignB;
+    while (i > 0 && j > 0 && score > 0) {
+        if (trace_matrix.get(i, j) == TRACE_DIAG) {  // Diagonal
+            score -= scoring.score(codes_a[i - 1], codes_b[j - 1]);
+            cigar.push_back(CIGAR_MATCH);
             --i;
             --j;
-        } else if (trace_matrix[i][j] == 'U') {  // Arriba
-            alignA = sequence_a[i - 1] + alignA;
-            alignB = '-' + alignB;  // Indica un gap en B.
+        } else if (trace_matrix.get(i, j) == TRACE_UP) {  // Arriba
+            score -= gap;
+            cigar.push_back(CIGAR_INSERTION);  // Indica un gap en B.
             --i;
         } else {  // Izquierda
-            alignA = '-' + alignA;  // Indica un gap en A.
-            alignB = sequence_b[j - 1] + alignB;
+            score -= gap;
+            cigar.push_back(CIGAR_DELETION);  // Indica un gap en A.
             --j;
         }
     }
 
-    // Asignar los alineamientos a las variables miembro de la clase.
-    aligned_a = alignA;
-    aligned_b = alignB;
+    // Las operaciones se han añadido del final al principio.
+    cigar.reverse();
+    begin_a = i;
+    begin_b = j;
 }
 
 
 std::pair<std::string, std::string> SmithWaterman::get_alignment() const {
-    return {aligned_a, aligned_b};
+    std::pair<std::string, std::string> alignment;
+    cigar.expand(sequence_a, begin_a, sequence_b, begin_b, alignment.first, alignment.second);
+    return alignment;
+}
+
+const Cigar& SmithWaterman::get_cigar() const {
+    return cigar;
+}
+
+std::pair<size_t, size_t> SmithWaterman::get_alignment_begin() const {
+    return {begin_a, begin_b};
 }
 
 
 void SmithWaterman::print_score_matrix() const {
-    for (const auto& row : score_matrix) {
-        for (const auto& cell : row) {
-            std::cout << std::setw(4) << cell;
+    // La matriz completa sólo se materializa aquí, para depuración y visualización.
+    DPMatrix<int> score_matrix(sequence_a.length() + 1, sequence_b.length() + 1);
+    int best_score;
+    size_t best_i, best_j;
+    fill_dp(nullptr, &score_matrix, best_score, best_i, best_j);
+
+    for (size_t i = 0; i < score_matrix.rows(); ++i) {
+        for (size_t j = 0; j < score_matrix.cols(); ++j) {
+            std::cout << std::setw(4) << score_matrix(i, j);
         }
         std::cout << std::endl;
     }
 }
 
 void SmithWaterman::print_trace_matrix() const {
-    for (const auto& row : trace_matrix) {
-        for (const auto& cell : row) {
-            std::cout << std::setw(4) << cell;
+    for (size_t i = 0; i < trace_matrix.rows(); ++i) {
+        for (size_t j = 0; j < trace_matrix.cols(); ++j) {
+            std::cout << std::setw(4) << trace_code_to_char(trace_matrix.get(i, j));
         }
         std::cout << std::endl;
     }
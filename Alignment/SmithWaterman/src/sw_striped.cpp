@@ -0,0 +1,63 @@
+// sw_striped.cpp
+#include <algorithm>
+#include <vector>
+#include "sw_striped.h"
+#include "sw_striped_kernel.h"
+
+namespace {
+
+// Referencia escalar sobre secuencias codificadas: misma recurrencia que
+// SmithWaterman::score_only(), con dos filas rotatorias.
+int scalar_smith_waterman_score(const std::uint8_t* query, std::size_t n,
+                                const std::uint8_t* target, std::size_t m,
+                                const int* table, int alphabet_size, int gap_penalty) {
+    std::vector<int> prev(m + 1, 0);
+    std::vector<int> curr(m + 1, 0);
+    int best = 0;
+
+    for (std::size_t i = 1; i <= n; ++i) {
+        const int* row = table + query[i - 1] * alphabet_size;
+        for (std::size_t j = 1; j <= m; ++j) {
+            int match_score = prev[j - 1] + row[target[j - 1]];
+            int delete_score = prev[j] + gap_penalty;
+            int insert_score = curr[j - 1] + gap_penalty;
+            curr[j] = std::max({0, match_score, delete_score, insert_score});
+            best = std::max(best, curr[j]);
+        }
+        prev.swap(curr);
+    }
+    return best;
+}
+
+} // namespace
+
+int striped_smith_waterman_score(const std::uint8_t* query, std::size_t query_length,
+                                 const std::uint8_t* target, std::size_t target_length,
+                                 const int* table, int alphabet_size, int gap_penalty,
+                                 SimdLevel level) {
+    level = std::min(level, detect_simd_level());
+
+    // Con gap >= 0 la corrección perezosa de F no converge: sólo escalar.
+    int score = -1;
+    if (gap_penalty < 0) {
+        switch (level) {
+            case SIMD_AVX512:
+                score = sw_striped_avx512(query, query_length, target, target_length, table, alphabet_size, gap_penalty);
+                break;
+            case SIMD_AVX2:
+                score = sw_striped_avx2(query, query_length, target, target_length, table, alphabet_size, gap_penalty);
+                break;
+            case SIMD_SSE41:
+                score = sw_striped_sse41(query, query_length, target, target_length, table, alphabet_size, gap_penalty);
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (score < 0) {
+        score = scalar_smith_waterman_score(query, query_length, target, target_length,
+                                            table, alphabet_size, gap_penalty);
+    }
+    return score;
+}
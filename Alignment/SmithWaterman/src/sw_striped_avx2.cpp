@@ -0,0 +1,102 @@
+// sw_striped_avx2.cpp
+// Instanciación AVX2 del núcleo striped (32/16/8 carriles). Compilar con -mavx2.
+#include "sw_striped_kernel.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace {
+
+// Desplaza el registro completo `bytes` bytes hacia arriba, cruzando la
+// frontera entre las dos mitades de 128 bits.
+template <int bytes>
+__m256i shift_up(__m256i v) {
+    return _mm256_alignr_epi8(v, _mm256_permute2x128_si256(v, v, 0x08), 16 - bytes);
+}
+
+struct Avx2U8 {
+    typedef __m256i vec;
+    typedef std::uint8_t elem;
+    static const int lanes = 32;
+    static const int max_value = 255;
+    static const bool biased = true;
+
+    static vec zero() { return _mm256_setzero_si256(); }
+    static vec set1(int v) { return _mm256_set1_epi8(static_cast<char>(v)); }
+    static vec add_score(vec h, vec p, vec bias) { return _mm256_subs_epu8(_mm256_adds_epu8(h, p), bias); }
+    static vec subs(vec a, vec b) { return _mm256_subs_epu8(a, b); }
+    static vec max(vec a, vec b) { return _mm256_max_epu8(a, b); }
+    static vec shift_lanes(vec v) { return shift_up<1>(v); }
+    static bool any_greater(vec a, vec b) {
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_subs_epu8(a, b), _mm256_setzero_si256())) != -1;
+    }
+    static int hmax(vec v) {
+        __m128i m = _mm_max_epu8(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        m = _mm_max_epu8(m, _mm_srli_si128(m, 8));
+        m = _mm_max_epu8(m, _mm_srli_si128(m, 4));
+        m = _mm_max_epu8(m, _mm_srli_si128(m, 2));
+        m = _mm_max_epu8(m, _mm_srli_si128(m, 1));
+        return _mm_extract_epi8(m, 0);
+    }
+};
+
+struct Avx2I16 {
+    typedef __m256i vec;
+    typedef std::int16_t elem;
+    static const int lanes = 16;
+    static const int max_value = 32767;
+    static const bool biased = false;
+
+    static vec zero() { return _mm256_setzero_si256(); }
+    static vec set1(int v) { return _mm256_set1_epi16(static_cast<short>(v)); }
+    static vec add_score(vec h, vec p, vec) { return _mm256_max_epi16(_mm256_adds_epi16(h, p), _mm256_setzero_si256()); }
+    static vec subs(vec a, vec b) { return _mm256_subs_epi16(a, b); }
+    static vec max(vec a, vec b) { return _mm256_max_epi16(a, b); }
+    static vec shift_lanes(vec v) { return shift_up<2>(v); }
+    static bool any_greater(vec a, vec b) { return _mm256_movemask_epi8(_mm256_cmpgt_epi16(a, b)) != 0; }
+    static int hmax(vec v) {
+        __m128i m = _mm_max_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        m = _mm_max_epi16(m, _mm_srli_si128(m, 8));
+        m = _mm_max_epi16(m, _mm_srli_si128(m, 4));
+        m = _mm_max_epi16(m, _mm_srli_si128(m, 2));
+        return static_cast<std::int16_t>(_mm_extract_epi16(m, 0));
+    }
+};
+
+struct Avx2I32 {
+    typedef __m256i vec;
+    typedef std::int32_t elem;
+    static const int lanes = 8;
+    static const int max_value = 2147483647;
+    static const bool biased = false;
+
+    static vec zero() { return _mm256_setzero_si256(); }
+    static vec set1(int v) { return _mm256_set1_epi32(v); }
+    static vec add_score(vec h, vec p, vec) { return _mm256_max_epi32(_mm256_add_epi32(h, p), _mm256_setzero_si256()); }
+    static vec subs(vec a, vec b) { return _mm256_sub_epi32(a, b); }
+    static vec max(vec a, vec b) { return _mm256_max_epi32(a, b); }
+    static vec shift_lanes(vec v) { return shift_up<4>(v); }
+    static bool any_greater(vec a, vec b) { return _mm256_movemask_epi8(_mm256_cmpgt_epi32(a, b)) != 0; }
+    static int hmax(vec v) {
+        __m128i m = _mm_max_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        m = _mm_max_epi32(m, _mm_srli_si128(m, 8));
+        m = _mm_max_epi32(m, _mm_srli_si128(m, 4));
+        return _mm_cvtsi128_si32(m);
+    }
+};
+
+} // namespace
+
+int sw_striped_avx2(const std::uint8_t* query, std::size_t n, const std::uint8_t* target, std::size_t m,
+                    const int* table, int alphabet_size, int gap_penalty) {
+    return striped_score<Avx2U8, Avx2I16, Avx2I32>(query, n, target, m, table, alphabet_size, gap_penalty);
+}
+
+#else
+
+int sw_striped_avx2(const std::uint8_t*, std::size_t, const std::uint8_t*, std::size_t,
+                    const int*, int, int) {
+    return -1;
+}
+
+#endif
@@ -0,0 +1,116 @@
+// sw_striped_avx512.cpp
+// Instanciación AVX-512 (BW) del núcleo striped (64/32/16 carriles).
+// Compilar con -mavx512f -mavx512bw.
+#include "sw_striped_kernel.h"
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#include <immintrin.h>
+
+namespace {
+
+// Desplaza el registro completo `bytes` bytes hacia arriba: la segunda
+// entrada de alignr es el propio vector movido un bloque de 128 bits.
+template <int bytes>
+__m512i shift_up(__m512i v) {
+    const __m512i previous = _mm512_maskz_shuffle_i32x4(0xFFF0, v, v, _MM_SHUFFLE(2, 1, 0, 0));
+    return _mm512_alignr_epi8(v, previous, 16 - bytes);
+}
+
+// En GCC, _mm512_max_epi32, _mm512_extracti64x4_epi64 y el cast a 256 bits
+// parten de un vector sin inicializar y dan avisos de -Wmaybe-uninitialized
+// desde avx512fintrin.h con -Wall -Wextra. Sus formas maskz con la máscara
+// completa generan el mismo código sin avisos.
+inline __m512i max_epi32(__m512i a, __m512i b) {
+    return _mm512_maskz_max_epi32(0xFFFF, a, b);
+}
+
+struct Avx512U8 {
+    typedef __m512i vec;
+    typedef std::uint8_t elem;
+    static const int lanes = 64;
+    static const int max_value = 255;
+    static const bool biased = true;
+
+    static vec zero() { return _mm512_setzero_si512(); }
+    static vec set1(int v) { return _mm512_set1_epi8(static_cast<char>(v)); }
+    static vec add_score(vec h, vec p, vec bias) { return _mm512_subs_epu8(_mm512_adds_epu8(h, p), bias); }
+    static vec subs(vec a, vec b) { return _mm512_subs_epu8(a, b); }
+    static vec max(vec a, vec b) { return _mm512_max_epu8(a, b); }
+    static vec shift_lanes(vec v) { return shift_up<1>(v); }
+    static bool any_greater(vec a, vec b) { return _mm512_cmpgt_epu8_mask(a, b) != 0; }
+    static int hmax(vec v) {
+        alignas(64) std::uint8_t values[64];
+        _mm512_store_si512(values, v);
+        int best = 0;
+        for (int l = 0; l < lanes; ++l) {
+            best = values[l] > best ? values[l] : best;
+        }
+        return best;
+    }
+};
+
+struct Avx512I16 {
+    typedef __m512i vec;
+    typedef std::int16_t elem;
+    static const int lanes = 32;
+    static const int max_value = 32767;
+    static const bool biased = false;
+
+    static vec zero() { return _mm512_setzero_si512(); }
+    static vec set1(int v) { return _mm512_set1_epi16(static_cast<short>(v)); }
+    static vec add_score(vec h, vec p, vec) { return _mm512_max_epi16(_mm512_adds_epi16(h, p), _mm512_setzero_si512()); }
+    static vec subs(vec a, vec b) { return _mm512_subs_epi16(a, b); }
+    static vec max(vec a, vec b) { return _mm512_max_epi16(a, b); }
+    static vec shift_lanes(vec v) { return shift_up<2>(v); }
+    static bool any_greater(vec a, vec b) { return _mm512_cmpgt_epi16_mask(a, b) != 0; }
+    static int hmax(vec v) {
+        alignas(64) std::int16_t values[32];
+        _mm512_store_si512(values, v);
+        int best = 0;
+        for (int l = 0; l < lanes; ++l) {
+            best = values[l] > best ? values[l] : best;
+        }
+        return best;
+    }
+};
+
+struct Avx512I32 {
+    typedef __m512i vec;
+    typedef std::int32_t elem;
+    static const int lanes = 16;
+    static const int max_value = 2147483647;
+    static const bool biased = false;
+
+    static vec zero() { return _mm512_setzero_si512(); }
+    static vec set1(int v) { return _mm512_set1_epi32(v); }
+    static vec add_score(vec h, vec p, vec) { return max_epi32(_mm512_add_epi32(h, p), _mm512_setzero_si512()); }
+    static vec subs(vec a, vec b) { return _mm512_sub_epi32(a, b); }
+    static vec max(vec a, vec b) { return max_epi32(a, b); }
+    static vec shift_lanes(vec v) { return shift_up<4>(v); }
+    static bool any_greater(vec a, vec b) { return _mm512_cmpgt_epi32_mask(a, b) != 0; }
+    // A mano, como en AVX2 (_mm512_reduce_max_epi32 da los mismos avisos).
+    static int hmax(vec v) {
+        const __m256i half = _mm256_max_epi32(_mm512_maskz_extracti64x4_epi64(0xFF, v, 0),
+                                             _mm512_maskz_extracti64x4_epi64(0xFF, v, 1));
+        __m128i m = _mm_max_epi32(_mm256_castsi256_si128(half), _mm256_extracti128_si256(half, 1));
+        m = _mm_max_epi32(m, _mm_srli_si128(m, 8));
+        m = _mm_max_epi32(m, _mm_srli_si128(m, 4));
+        return _mm_cvtsi128_si32(m);
+    }
+};
+
+} // namespace
+
+int sw_striped_avx512(const std::uint8_t* query, std::size_t n, const std::uint8_t* target, std::size_t m,
+                      const int* table, int alphabet_size, int gap_penalty) {
+    return striped_score<Avx512U8, Avx512I16, Avx512I32>(query, n, target, m, table, alphabet_size, gap_penalty);
+}
+
+#else
+
+int sw_striped_avx512(const std::uint8_t*, std::size_t, const std::uint8_t*, std::size_t,
+                      const int*, int, int) {
+    return -1;
+}
+
+#endif
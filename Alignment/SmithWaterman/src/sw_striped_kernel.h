@@ -0,0 +1,146 @@
+// sw_striped_kernel.h
+//
+// Núcleo genérico de Smith-Waterman "striped" (Farrar, 2007) con gap lineal.
+// Cada unidad de traducción por juego de instrucciones (sw_striped_sse41.cpp,
+// sw_striped_avx2.cpp, sw_striped_avx512.cpp) define sus operaciones
+// vectoriales en un espacio de nombres anónimo y las instancia aquí, de modo
+// que cada instanciación se compila sólo con los flags de su ISA.
+//
+// Como esas instanciaciones dependen de tipos locales, tienen enlace interno.
+// Por eso este núcleo no usa plantillas de la biblioteca estándar (ver
+// vector_buffer.h).
+//
+// Cada tipo Ops proporciona:
+//   vec, elem, lanes, max_value, biased
+//   zero(), set1(int), add_score(h, profile, bias), subs(a, b), max(a, b),
+//   shift_lanes(v) (desplaza un carril hacia arriba metiendo 0),
+//   any_greater(a, b), hmax(v)
+
+#ifndef SW_STRIPED_KERNEL_H
+#define SW_STRIPED_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include "vector_buffer.h"
+
+// Una pasada con el ancho de carril de Ops. Devuelve false si la puntuación
+// puede haber saturado y hay que repetir con carriles más anchos.
+template <typename Ops>
+bool striped_pass(const std::uint8_t* query, std::size_t n,
+                  const std::uint8_t* target, std::size_t m,
+                  const int* table, int alphabet_size, int gap_penalty, int& best) {
+    typedef typename Ops::vec vec;
+    typedef typename Ops::elem elem;
+    const std::size_t lanes = Ops::lanes;
+    const std::size_t seg_len = (n + lanes - 1) / lanes;
+
+    int min_score = 0;
+    int max_score = 0;
+    for (int k = 0; k < alphabet_size * alphabet_size; ++k) {
+        min_score = table[k] < min_score ? table[k] : min_score;
+        max_score = table[k] > max_score ? table[k] : max_score;
+    }
+    const int bias = Ops::biased ? -min_score : 0;
+    const int gap = -gap_penalty;
+    if (max_score + bias >= Ops::max_value || gap >= Ops::max_value) {
+        return false;
+    }
+
+    // Perfil de la consulta: para cada símbolo c hay seg_len vectores cuyo
+    // carril l en el segmento s puntúa query[s + l * seg_len] frente a c. Las
+    // posiciones de relleno (más allá de n) puntúan 0, o -bias con sesgo, y
+    // nunca superan el máximo real.
+    VectorBuffer<Ops> profile(alphabet_size * seg_len);
+    elem* profile_elements = profile.elements();
+    for (int c = 0; c < alphabet_size; ++c) {
+        for (std::size_t s = 0; s < seg_len; ++s) {
+            for (std::size_t l = 0; l < lanes; ++l) {
+                const std::size_t q = s + l * seg_len;
+                const int value = q < n ? table[query[q] * alphabet_size + c] + bias : 0;
+                profile_elements[(c * seg_len + s) * lanes + l] = static_cast<elem>(value);
+            }
+        }
+    }
+
+    VectorBuffer<Ops> h_store_buffer(seg_len);
+    VectorBuffer<Ops> h_load_buffer(seg_len);
+    VectorBuffer<Ops> e_buffer(seg_len);
+    vec* h_store = h_store_buffer.data();
+    vec* h_load = h_load_buffer.data();
+    vec* e = e_buffer.data();
+
+    const vec v_gap = Ops::set1(gap);
+    const vec v_bias = Ops::set1(bias);
+    vec v_max = Ops::zero();
+
+    for (std::size_t j = 0; j < m; ++j) {
+        vec v_f = Ops::zero();
+        vec v_h = Ops::shift_lanes(h_store[seg_len - 1]);
+        vec* swap = h_store;
+        h_store = h_load;
+        h_load = swap;
+        const vec* column_profile = profile.data() + target[j] * seg_len;
+
+        for (std::size_t s = 0; s < seg_len; ++s) {
+            v_h = Ops::add_score(v_h, column_profile[s], v_bias);
+            vec v_e = e[s];
+            v_h = Ops::max(v_h, v_e);
+            v_h = Ops::max(v_h, v_f);
+            v_max = Ops::max(v_max, v_h);
+            h_store[s] = v_h;
+
+            v_h = Ops::subs(v_h, v_gap);
+            e[s] = Ops::max(Ops::subs(v_e, v_gap), v_h);
+            v_f = Ops::max(Ops::subs(v_f, v_gap), v_h);
+            v_h = h_load[s];
+        }
+
+        // Corrección perezosa de F: propaga los gaps verticales que cruzan
+        // de un carril al siguiente mientras todavía mejoren alguna celda.
+        v_f = Ops::shift_lanes(v_f);
+        std::size_t s = 0;
+        while (Ops::any_greater(v_f, h_store[s])) {
+            v_h = Ops::max(h_store[s], v_f);
+            h_store[s] = v_h;
+            v_max = Ops::max(v_max, v_h);
+            e[s] = Ops::max(e[s], Ops::subs(v_h, v_gap));
+            v_f = Ops::subs(v_f, v_gap);
+            if (++s >= seg_len) {
+                s = 0;
+                v_f = Ops::shift_lanes(v_f);
+            }
+        }
+    }
+
+    best = Ops::hmax(v_max);
+    return best + bias < Ops::max_value;
+}
+
+// Escalera de anchos: 8 bits, después 16 y por último 32 bits.
+template <typename Ops8, typename Ops16, typename Ops32>
+int striped_score(const std::uint8_t* query, std::size_t n,
+                  const std::uint8_t* target, std::size_t m,
+                  const int* table, int alphabet_size, int gap_penalty) {
+    int best = 0;
+    if (n == 0 || m == 0) {
+        return 0;
+    }
+    if (striped_pass<Ops8>(query, n, target, m, table, alphabet_size, gap_penalty, best)) {
+        return best;
+    }
+    if (striped_pass<Ops16>(query, n, target, m, table, alphabet_size, gap_penalty, best)) {
+        return best;
+    }
+    striped_pass<Ops32>(query, n, target, m, table, alphabet_size, gap_penalty, best);
+    return best;
+}
+
+// Puntos de entrada por ISA. Si el compilador no admite el ISA, devuelven -1.
+int sw_striped_sse41(const std::uint8_t* query, std::size_t n, const std::uint8_t* target, std::size_t m,
+                     const int* table, int alphabet_size, int gap_penalty);
+int sw_striped_avx2(const std::uint8_t* query, std::size_t n, const std::uint8_t* target, std::size_t m,
+                    const int* table, int alphabet_size, int gap_penalty);
+int sw_striped_avx512(const std::uint8_t* query, std::size_t n, const std::uint8_t* target, std::size_t m,
+                      const int* table, int alphabet_size, int gap_penalty);
+
+#endif // SW_STRIPED_KERNEL_H
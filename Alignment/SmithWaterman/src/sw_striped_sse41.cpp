@@ -0,0 +1,92 @@
+// sw_striped_sse41.cpp
+// Instanciación SSE4.1 del núcleo striped (16/8/4 carriles). Compilar con -msse4.1.
+#include "sw_striped_kernel.h"
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+
+namespace {
+
+struct SseU8 {
+    typedef __m128i vec;
+    typedef std::uint8_t elem;
+    static const int lanes = 16;
+    static const int max_value = 255;
+    static const bool biased = true;
+
+    static vec zero() { return _mm_setzero_si128(); }
+    static vec set1(int v) { return _mm_set1_epi8(static_cast<char>(v)); }
+    static vec add_score(vec h, vec p, vec bias) { return _mm_subs_epu8(_mm_adds_epu8(h, p), bias); }
+    static vec subs(vec a, vec b) { return _mm_subs_epu8(a, b); }
+    static vec max(vec a, vec b) { return _mm_max_epu8(a, b); }
+    static vec shift_lanes(vec v) { return _mm_slli_si128(v, 1); }
+    static bool any_greater(vec a, vec b) {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(a, b), _mm_setzero_si128())) != 0xFFFF;
+    }
+    static int hmax(vec v) {
+        v = _mm_max_epu8(v, _mm_srli_si128(v, 8));
+        v = _mm_max_epu8(v, _mm_srli_si128(v, 4));
+        v = _mm_max_epu8(v, _mm_srli_si128(v, 2));
+        v = _mm_max_epu8(v, _mm_srli_si128(v, 1));
+        return _mm_extract_epi8(v, 0);
+    }
+};
+
+struct SseI16 {
+    typedef __m128i vec;
+    typedef std::int16_t elem;
+    static const int lanes = 8;
+    static const int max_value = 32767;
+    static const bool biased = false;
+
+    static vec zero() { return _mm_setzero_si128(); }
+    static vec set1(int v) { return _mm_set1_epi16(static_cast<short>(v)); }
+    static vec add_score(vec h, vec p, vec) { return _mm_max_epi16(_mm_adds_epi16(h, p), _mm_setzero_si128()); }
+    static vec subs(vec a, vec b) { return _mm_subs_epi16(a, b); }
+    static vec max(vec a, vec b) { return _mm_max_epi16(a, b); }
+    static vec shift_lanes(vec v) { return _mm_slli_si128(v, 2); }
+    static bool any_greater(vec a, vec b) { return _mm_movemask_epi8(_mm_cmpgt_epi16(a, b)) != 0; }
+    static int hmax(vec v) {
+        v = _mm_max_epi16(v, _mm_srli_si128(v, 8));
+        v = _mm_max_epi16(v, _mm_srli_si128(v, 4));
+        v = _mm_max_epi16(v, _mm_srli_si128(v, 2));
+        return static_cast<std::int16_t>(_mm_extract_epi16(v, 0));
+    }
+};
+
+struct SseI32 {
+    typedef __m128i vec;
+    typedef std::int32_t elem;
+    static const int lanes = 4;
+    static const int max_value = 2147483647;
+    static const bool biased = false;
+
+    static vec zero() { return _mm_setzero_si128(); }
+    static vec set1(int v) { return _mm_set1_epi32(v); }
+    static vec add_score(vec h, vec p, vec) { return _mm_max_epi32(_mm_add_epi32(h, p), _mm_setzero_si128()); }
+    static vec subs(vec a, vec b) { return _mm_sub_epi32(a, b); }
+    static vec max(vec a, vec b) { return _mm_max_epi32(a, b); }
+    static vec shift_lanes(vec v) { return _mm_slli_si128(v, 4); }
+    static bool any_greater(vec a, vec b) { return _mm_movemask_epi8(_mm_cmpgt_epi32(a, b)) != 0; }
+    static int hmax(vec v) {
+        v = _mm_max_epi32(v, _mm_srli_si128(v, 8));
+        v = _mm_max_epi32(v, _mm_srli_si128(v, 4));
+        return _mm_cvtsi128_si32(v);
+    }
+};
+
+} // namespace
+
+int sw_striped_sse41(const std::uint8_t* query, std::size_t n, const std::uint8_t* target, std::size_t m,
+                     const int* table, int alphabet_size, int gap_penalty) {
+    return striped_score<SseU8, SseI16, SseI32>(query, n, target, m, table, alphabet_size, gap_penalty);
+}
+
+#else
+
+int sw_striped_sse41(const std::uint8_t*, std::size_t, const std::uint8_t*, std::size_t,
+                     const int*, int, int) {
+    return -1;
+}
+
+#endif
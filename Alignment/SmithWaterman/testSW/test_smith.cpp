@@ -1,5 +1,194 @@
 #include "smith_waterman.h"
 #include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+std::string remove_gaps(const std::string& s) {
+    std::string result;
+    for (char c : s) {
+        if (c != '-') {
+            result += c;
+        }
+    }
+    return result;
+}
+
+// Comprueba que score_only() da la puntuación de align() y que sus
+// coordenadas finales corresponden al alineamiento local reconstruido.
+bool test_score_only() {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<int> length(0, 120);
+
+    bool ok = true;
+    for (int t = 0; t < 40; ++t) {
+        std::string a(length(rng), 'A');
+        std::string b(length(rng), 'A');
+        for (char& c : a) c = "ACGT"[base(rng)];
+        for (char& c : b) c = "ACGT"[base(rng)];
+
+        SmithWaterman sw(a, b, 5, -3, -4);
+        SmithWaterman::LocalScore hit = sw.score_only();
+        sw.align();
+        auto alignment = sw.get_alignment();
+        std::string local_a = remove_gaps(alignment.first);
+        std::string local_b = remove_gaps(alignment.second);
+
+        auto begin = sw.get_alignment_begin();
+        bool valid = hit.score == sw.get_alignment_score() &&
+                     begin.first + sw.get_cigar().length_a() == hit.end_a &&
+                     begin.second + sw.get_cigar().length_b() == hit.end_b &&
+                     hit.end_a >= local_a.size() && hit.end_b >= local_b.size() &&
+                     a.compare(hit.end_a - local_a.size(), local_a.size(), local_a) == 0 &&
+                     b.compare(hit.end_b - local_b.size(), local_b.size(), local_b) == 0;
+        if (!valid) {
+            std::cout << "score_only FAIL: " << a << " / " << b << std::endl;
+            ok = false;
+        }
+    }
+    std::cout << "score_only vs align: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Comprueba que el núcleo striped da la misma puntuación que la versión
+// escalar en todos los ISA disponibles, incluidos los desbordamientos de
+// 8 y 16 bits (secuencias idénticas largas con puntuaciones altas).
+bool test_score_simd() {
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<int> length(0, 300);
+
+    struct Case {
+        std::string a;
+        std::string b;
+        int match;
+    };
+    std::vector<Case> cases;
+    for (int t = 0; t < 30; ++t) {
+        std::string a(length(rng), 'A');
+        std::string b(length(rng), 'A');
+        for (char& c : a) c = "ACGT"[base(rng)];
+        for (char& c : b) c = "ACGT"[base(rng)];
+        cases.push_back({a, b, 5});
+    }
+    std::string repeat(400, 'A');
+    for (char& c : repeat) c = "ACGT"[base(rng)];
+    cases.push_back({repeat.substr(0, 100), repeat.substr(0, 100), 5});
+    cases.push_back({repeat, repeat, 100});
+    cases.push_back({"", "ACGT", 5});
+
+    bool ok = true;
+    for (const Case& c : cases) {
+        SmithWaterman sw(c.a, c.b, c.match, -3, -4);
+        int expected = sw.score_only().score;
+        for (int level = SIMD_SCALAR; level <= detect_simd_level(); ++level) {
+            int score = sw.score_simd(static_cast<SimdLevel>(level));
+            if (score != expected) {
+                std::cout << "score_simd FAIL (" << simd_level_name(static_cast<SimdLevel>(level)) << "): "
+                          << score << " != " << expected << std::endl;
+                ok = false;
+            }
+        }
+    }
+    std::cout << "score_simd vs score_only: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Comprueba los gaps afines: con gap_open == gap_extend reproduce align(),
+// score_only_affine() coincide con align_affine() y el alineamiento local
+// termina en las coordenadas que devuelve.
+bool test_affine() {
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<int> length(0, 150);
+
+    bool ok = true;
+    for (int t = 0; t < 40; ++t) {
+        std::string a(length(rng), 'A');
+        std::string b(length(rng), 'A');
+        for (char& c : a) c = "ACGT"[base(rng)];
+        for (char& c : b) c = "ACGT"[base(rng)];
+
+        SmithWaterman linear(a, b, 5, -3, -4);
+        linear.align();
+        SmithWaterman same(a, b, 5, -3, -4);
+        same.align_affine(-4, -4);
+        if (same.get_alignment_score() != linear.get_alignment_score() ||
+            same.get_alignment() != linear.get_alignment()) {
+            std::cout << "affine (lineal) FAIL: " << a << " / " << b << std::endl;
+            ok = false;
+        }
+
+        SmithWaterman affine(a, b, 5, -3, -4);
+        SmithWaterman::LocalScore hit = affine.score_only_affine(-8, -1);
+        affine.align_affine(-8, -1);
+        auto alignment = affine.get_alignment();
+        std::string local_a = remove_gaps(alignment.first);
+        std::string local_b = remove_gaps(alignment.second);
+        bool valid = hit.score == affine.get_alignment_score() &&
+                     hit.end_a >= local_a.size() && hit.end_b >= local_b.size() &&
+                     a.compare(hit.end_a - local_a.size(), local_a.size(), local_a) == 0 &&
+                     b.compare(hit.end_b - local_b.size(), local_b.size(), local_b) == 0;
+        if (!valid) {
+            std::cout << "affine FAIL: " << a << " / " << b << std::endl;
+            ok = false;
+        }
+    }
+
+    // Con extensión barata un único gap de 4 une ambos tramos: 12 * 5 - 8 - 3.
+    SmithWaterman long_gap("ACGTAGGATCCA", "ACGTAGTTTTGATCCA", 5, -3, -4);
+    long_gap.align_affine(-8, -1);
+    ok = ok && long_gap.get_alignment_score() == 49 &&
+         long_gap.get_alignment().second == "ACGTAGTTTTGATCCA" &&
+         long_gap.get_cigar().to_string() == "6M4D6M" &&
+         long_gap.get_alignment_begin() == std::make_pair<size_t, size_t>(0, 0);
+
+    std::cout << "Gaps afines: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Comprueba que el frente de onda por bloques da exactamente la misma
+// puntuación, celda final y alineamiento que align() con cualquier número de
+// hilos (el empate entre bloques se resuelve en orden de filas).
+bool test_wavefront() {
+    std::mt19937 rng(31);
+    std::uniform_int_distribution<int> base(0, 3);
+    std::uniform_int_distribution<int> length(0, 700);
+
+    std::vector<std::pair<std::string, std::string>> cases;
+    for (int t = 0; t < 12; ++t) {
+        std::string a(length(rng), 'A');
+        std::string b(length(rng), 'A');
+        for (char& c : a) c = "ACGT"[base(rng)];
+        for (char& c : b) c = "ACGT"[base(rng)];
+        cases.push_back({a, b});
+    }
+    // El mismo máximo repetido en varios bloques.
+    std::string repeat(300, 'A');
+    for (char& c : repeat) c = "ACGT"[base(rng)];
+    cases.push_back({repeat + repeat + repeat, repeat});
+
+    bool ok = true;
+    for (const auto& c : cases) {
+        SmithWaterman sequential(c.first, c.second, 5, -3, -4);
+        sequential.align();
+        SmithWaterman::LocalScore expected = sequential.score_only();
+        for (unsigned threads : {1u, 3u, 4u}) {
+            SmithWaterman wavefront(c.first, c.second, 5, -3, -4);
+            wavefront.align_wavefront(threads);
+            SmithWaterman::LocalScore hit = wavefront.score_only_wavefront(threads);
+            if (hit.score != expected.score || hit.end_a != expected.end_a || hit.end_b != expected.end_b ||
+                wavefront.get_alignment_score() != sequential.get_alignment_score() ||
+                wavefront.get_alignment() != sequential.get_alignment()) {
+                std::cout << "wavefront FAIL (" << threads << " hilos): " << c.first << " / " << c.second << std::endl;
+                ok = false;
+            }
+        }
+    }
+    std::cout << "Frente de onda vs secuencial: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
 
 int main() {
     // Secuencias de prueba.
@@ -25,5 +214,11 @@ int main() {
     std::cout << "Sequence A: " << alignment.first << std::endl;
     std::cout << "Sequence B: " << alignment.second << std::endl;
 
-    return 0;
+    std::cout << std::endl;
+    bool ok = test_score_only();
+    ok = test_score_simd() && ok;
+    ok = test_affine() && ok;
+    ok = test_wavefront() && ok;
+
+    return ok ? 0 : 1;
 }
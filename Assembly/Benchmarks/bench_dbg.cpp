@@ -0,0 +1,87 @@
+// bench_dbg.cpp
+//
+// Construcción del grafo de De Bruijn con buildGraph() (nodos y aristas en el
+// heap, unordered_map con claves std::string) frente a CompactGraph (códigos
+// de 2 bits, direccionamiento abierto y máscaras de aristas) sobre lecturas
+// simuladas de un genoma aleatorio con un 0,5 % de errores. La memoria es el
+// crecimiento del conjunto residente del proceso (/proc/self/statm).
+//
+// Uso: benchDBG [longitud del genoma] [cobertura] [k]   (por defecto 500000 20 31)
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+#include "compact_graph.h"
+#include "graph.h"
+
+namespace {
+
+double resident_megabytes() {
+    std::ifstream statm("/proc/self/statm");
+    std::size_t total = 0;
+    std::size_t resident = 0;
+    statm >> total >> resident;
+    return static_cast<double>(resident) * sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t genome_length = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500000;
+    const std::size_t coverage = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20;
+    const int k = argc > 3 ? std::atoi(argv[3]) : 31;
+    const std::size_t read_length = 150;
+
+    std::mt19937 rng(3);
+    const char bases[] = "ACGT";
+    std::string genome(genome_length, 'A');
+    for (char& c : genome) {
+        c = bases[rng() % 4];
+    }
+    std::vector<std::string> reads(genome_length * coverage / read_length);
+    for (std::string& read : reads) {
+        read = genome.substr(rng() % (genome_length - read_length), read_length);
+        for (char& c : read) {
+            if (rng() % 200 == 0) {
+                c = bases[rng() % 4];
+            }
+        }
+    }
+    std::cout << reads.size() << " reads of " << read_length << " bp, k = " << k << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    // CompactGraph primero: medido después de liberar el grafo de buildGraph()
+    // sale varias veces más lento, por el heap que éste deja fragmentado.
+    {
+        auto start = std::chrono::steady_clock::now();
+        CompactGraph graph = buildCompactGraph(reads, k);
+        auto end = std::chrono::steady_clock::now();
+        const double megabytes = graph.memoryBytes() / (1024.0 * 1024.0);
+        std::cout << std::setw(12) << "CompactGraph" << std::setw(10)
+                  << std::chrono::duration<double>(end - start).count() << " s" << std::setw(10) << megabytes << " MB"
+                  << std::setw(10) << static_cast<double>(graph.memoryBytes()) / graph.nodeCount() << " B/node  ("
+                  << graph.nodeCount() << " nodes)" << std::endl;
+    }
+    {
+        const double before = resident_megabytes();
+        auto start = std::chrono::steady_clock::now();
+        std::unordered_map<std::string, Node*> graph = buildGraph(reads, k);
+        auto end = std::chrono::steady_clock::now();
+        const double megabytes = resident_megabytes() - before;
+        std::cout << std::setw(12) << "buildGraph" << std::setw(10) << std::chrono::duration<double>(end - start).count()
+                  << " s" << std::setw(10) << megabytes << " MB" << std::setw(10)
+                  << megabytes * 1024 * 1024 / graph.size() << " B/node  (" << graph.size() << " nodes)" << std::endl;
+        for (auto& entry : graph) {
+            delete entry.second;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+// bench_dbg_parallel.cpp
+//
+// Rendimiento en lecturas por segundo de la construcción del grafo de De
+// Bruijn: buildCompactGraph() en un hilo frente a ParallelGraphBuilder con
+// 1, 2, 4... hilos hasta los del equipo, sobre lecturas simuladas de un
+// genoma aleatorio con un 0,5 % de errores.
+//
+// Uso: benchDBGParallel [longitud del genoma] [cobertura] [k] [hilos máximos]
+//      (por defecto 2000000 30 31 hardware_concurrency)
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "compact_graph.h"
+#include "parallel_graph_builder.h"
+
+namespace {
+
+template <typename Build>
+void measure(const std::string& name, std::size_t num_reads, Build build) {
+    auto start = std::chrono::steady_clock::now();
+    const std::size_t nodes = build();
+    auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << std::setw(14) << name << std::setw(10) << seconds << " s" << std::setw(14)
+              << static_cast<double>(num_reads) / seconds << " reads/s  (" << nodes << " nodes)" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t genome_length = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    const std::size_t coverage = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 30;
+    const int k = argc > 3 ? std::atoi(argv[3]) : 31;
+    const unsigned max_threads = argc > 4 ? static_cast<unsigned>(std::atoi(argv[4])) : std::thread::hardware_concurrency();
+    const std::size_t read_length = 150;
+
+    std::mt19937 rng(3);
+    const char bases[] = "ACGT";
+    std::string genome(genome_length, 'A');
+    for (char& c : genome) {
+        c = bases[rng() % 4];
+    }
+    std::vector<std::string> reads(genome_length * coverage / read_length);
+    for (std::string& read : reads) {
+        read = genome.substr(rng() % (genome_length - read_length), read_length);
+        for (char& c : read) {
+            if (rng() % 200 == 0) {
+                c = bases[rng() % 4];
+            }
+        }
+    }
+    std::cout << reads.size() << " reads of " << read_length << " bp, k = " << k << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    measure("serial", reads.size(), [&] { return buildCompactGraph(reads, k).nodeCount(); });
+    for (unsigned threads = 1; threads <= std::max(1u, max_threads); threads *= 2) {
+        measure(std::to_string(threads) + " threads", reads.size(),
+                [&] { return buildCompactGraphParallel(reads, k, threads).nodeCount(); });
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+// bench_dense_kmer_counter.cpp
+//
+// Recuento de k pequeños sobre un genoma simulado del tamaño de uno
+// bacteriano, como en los perfiles de k = 2..5: KmerCounter (tabla hash) con
+// una pasada por k frente a DenseKmerCounter (tabla de 4^k cuentas) con una
+// pasada por k y con todos los k en una sola pasada. Da millones de bases
+// por segundo de cada uno (contando cada base una vez por pasada).
+//
+// Uso: benchDenseKmerCounter [longitud del genoma] [k mínimo] [k máximo] [repeticiones]
+//      (por defecto 5000000 2 5 5)
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "dense_kmer_counter.h"
+#include "kmer_counter.h"
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t genome_length = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000000;
+    const int min_k = argc > 2 ? std::atoi(argv[2]) : 2;
+    const int max_k = argc > 3 ? std::atoi(argv[3]) : 5;
+    const int repeats = argc > 4 ? std::atoi(argv[4]) : 5;
+
+    std::mt19937 rng(3);
+    const char bases[] = "ACGT";
+    std::string genome(genome_length, 'A');
+    for (char& c : genome) {
+        c = bases[rng() % 4];
+    }
+    std::vector<int> k_values;
+    for (int k = min_k; k <= max_k; ++k) {
+        k_values.push_back(k);
+    }
+    const double mbases = genome_length / 1e6 * repeats;
+    std::cout << genome_length << " bp genome, k = " << min_k << ".." << max_k << ", " << repeats
+              << " passes per counter" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    std::uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int k : k_values) {
+        KmerCounter counter(k, std::size_t(64) << 20);
+        for (int r = 0; r < repeats; ++r) {
+            counter.addSequence(genome);
+        }
+        checksum += counter.totalKmers();
+    }
+    double seconds = seconds_since(start);
+    std::cout << "KmerCounter, one pass per k     " << std::setw(10) << seconds << " s" << std::setw(10)
+              << mbases * k_values.size() / seconds << " Mbases/s" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    for (int k : k_values) {
+        DenseKmerCounter counter(k);
+        for (int r = 0; r < repeats; ++r) {
+            counter.addSequence(genome);
+        }
+        checksum += counter.totalKmers(k);
+    }
+    seconds = seconds_since(start);
+    std::cout << "DenseKmerCounter, one pass per k" << std::setw(10) << seconds << " s" << std::setw(10)
+              << mbases * k_values.size() / seconds << " Mbases/s" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    DenseKmerCounter all(k_values);
+    for (int r = 0; r < repeats; ++r) {
+        all.addSequence(genome);
+    }
+    seconds = seconds_since(start);
+    checksum += all.totalKmers(min_k);
+    std::cout << "DenseKmerCounter, all k at once " << std::setw(10) << seconds << " s" << std::setw(10)
+              << mbases / seconds << " Mbases/s  (" << all.memoryBytes() / 1024 << " KiB of tables, checksum "
+              << checksum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,113 @@
+// bench_disk_kmer_counter.cpp
+//
+// Recuento en dos pasadas con cubos en disco (DiskKmerCounter) de lecturas
+// simuladas, con un límite de memoria menor que el que necesitaría la tabla
+// de KmerCounter para todos los k-meros, frente a ese mismo KmerCounter con
+// memoria de sobra (sólo con k <= 31). Da millones de bases por segundo de
+// cada pasada y los bytes escritos en disco, y comprueba que el pico de RSS
+// de las dos pasadas no pasa del límite (las lecturas se generan sobre la
+// marcha para no contarlas). Sale con 1 si lo pasa.
+//
+// Uso: benchDiskKmerCounter [longitud del genoma] [cobertura] [k] [memoria en MB] [hilos] [cubos]
+//      (por defecto 5000000 20 31 64 0 256)
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <sys/resource.h>
+#include "disk_kmer_counter.h"
+#include "kmer_counter.h"
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Pico de memoria residente del proceso en bytes (ru_maxrss va en kB en Linux).
+std::size_t peak_rss_bytes() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<std::size_t>(usage.ru_maxrss) << 10;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t genome_length = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000000;
+    const std::size_t coverage = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20;
+    const int k = argc > 3 ? std::atoi(argv[3]) : 31;
+    const std::size_t memory_mb = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 64;
+    const unsigned threads = argc > 5 ? static_cast<unsigned>(std::atoi(argv[5])) : 0;
+    const std::size_t buckets = argc > 6 ? std::strtoul(argv[6], nullptr, 10) : 256;
+    const std::size_t read_length = 150;
+
+    std::mt19937 rng(3);
+    const char bases[] = "ACGT";
+    std::string genome(genome_length, 'A');
+    for (char& c : genome) {
+        c = bases[rng() % 4];
+    }
+    // Las mismas lecturas en cada llamada, sin guardarlas.
+    const std::size_t read_count = genome_length * coverage / read_length;
+    auto for_each_read = [&](auto consume) {
+        std::mt19937 read_rng(5);
+        std::string read;
+        for (std::size_t r = 0; r < read_count; ++r) {
+            read = genome.substr(read_rng() % (genome_length - read_length), read_length);
+            for (char& c : read) {
+                if (read_rng() % 200 == 0) {
+                    c = bases[read_rng() % 4];
+                }
+            }
+            consume(read);
+        }
+    };
+    const double mbases = read_count * read_length / 1e6;
+    std::cout << read_count << " reads of " << read_length << " bp, k = " << k << ", " << memory_mb
+              << " MiB, " << buckets << " buckets" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    const std::size_t rss_before = peak_rss_bytes();
+    DiskCounterOptions options;
+    options.k = k;
+    options.maxMemoryBytes = memory_mb << 20;
+    options.numThreads = threads;
+    options.buckets = buckets;
+    DiskKmerCounter counter(options);
+    auto start = std::chrono::steady_clock::now();
+    for_each_read([&](const std::string& read) { counter.addSequence(read); });
+    double seconds = seconds_since(start);
+    std::cout << "pass 1 (buckets) " << std::setw(10) << seconds << " s" << std::setw(10) << mbases / seconds
+              << " Mbases/s  (" << counter.diskBytes() / (1 << 20) << " MiB on disk)" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    std::uint64_t solid = 0;
+    counter.count([&](const std::string&, std::uint32_t count) {
+        solid += count > 1;
+    });
+    seconds = seconds_since(start);
+    std::cout << "pass 2 (count)   " << std::setw(10) << seconds << " s" << std::setw(10) << mbases / seconds
+              << " Mbases/s  (" << counter.distinctKmers() << " distinct canonical k-mers, " << solid
+              << " seen more than once)" << std::endl;
+    const std::size_t rss_used = peak_rss_bytes() - rss_before;
+    const bool within_limit = rss_used <= options.maxMemoryBytes;
+    std::cout << "peak RSS         " << std::setw(10) << rss_used / double(1 << 20) << " MiB of "
+              << memory_mb << " MiB  (" << (within_limit ? "OK" : "OVER THE LIMIT") << ")" << std::endl;
+
+    if (k <= 31) {
+        KmerCounter memory(k, std::size_t(1) << 30);
+        start = std::chrono::steady_clock::now();
+        for_each_read([&](const std::string& read) { memory.addSequence(read); });
+        seconds = seconds_since(start);
+        std::cout << "KmerCounter      " << std::setw(10) << seconds << " s" << std::setw(10) << mbases / seconds
+                  << " Mbases/s  (" << memory.distinctKmers() << " distinct, "
+                  << memory.memoryBytes() / (1 << 20) << " MiB table)" << std::endl;
+    }
+    return within_limit ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+// bench_eulerian.cpp
+//
+// Tiempo de findEulerianPath() (Hierholzer con pila explícita) sobre el grafo
+// de De Bruijn completo de nodos de longitud k - 1: 4^(k-1) nodos con cuatro
+// entradas y cuatro salidas cada uno y un circuito de 4^k aristas. Con k = 14
+// son 2,7 * 10^8 aristas.
+//
+// Uso: benchEulerian [k]   (por defecto 12)
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include "compact_graph.h"
+#include "eulerian_path.h"
+
+int main(int argc, char* argv[]) {
+    const int k = argc > 1 ? std::atoi(argv[1]) : 12;
+    const std::uint64_t nodes = std::uint64_t(1) << (2 * (k - 1));
+
+    auto start = std::chrono::steady_clock::now();
+    CompactGraph graph(k, nodes);
+    for (std::uint64_t node = 0; node < nodes; ++node) {
+        for (std::uint8_t base = 0; base < 4; ++base) {
+            graph.addEdge(node, base);
+        }
+    }
+    auto built = std::chrono::steady_clock::now();
+    EulerianWalk walk = findEulerianPath(graph);
+    auto end = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(end - built).count();
+    std::cout << std::fixed << std::setprecision(3) << "k = " << k << ": " << graph.nodeCount() << " nodes, "
+              << graph.edgeCount() << " edges (built in " << std::chrono::duration<double>(built - start).count()
+              << " s)" << std::endl;
+    std::cout << (walk.kind == EULERIAN_CIRCUIT ? "circuit" : "no circuit") << " of " << walk.nodes.size()
+              << " nodes in " << seconds << " s (" << seconds * 1e9 / graph.edgeCount() << " ns/edge)" << std::endl;
+    return 0;
+}
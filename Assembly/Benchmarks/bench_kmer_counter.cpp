@@ -0,0 +1,81 @@
+// bench_kmer_counter.cpp
+//
+// Recuento de k-meros de lecturas simuladas: el de antes (substr en un
+// unordered_map<string, int>, sobre menos lecturas porque es lento) frente a
+// KmerCounter con códigos de 2 bits, canónicos y una tabla reservada de
+// antemano. Da millones de bases por segundo y memoria de cada uno.
+//
+// Uso: benchKmerCounter [longitud del genoma] [cobertura] [k] [memoria en MB]
+//      (por defecto 5000000 20 21 512)
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "kmer_counter.h"
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t genome_length = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000000;
+    const std::size_t coverage = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20;
+    const int k = argc > 3 ? std::atoi(argv[3]) : 21;
+    const std::size_t memory_mb = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 512;
+    const std::size_t read_length = 150;
+
+    std::mt19937 rng(3);
+    const char bases[] = "ACGT";
+    std::string genome(genome_length, 'A');
+    for (char& c : genome) {
+        c = bases[rng() % 4];
+    }
+    std::vector<std::string> reads(genome_length * coverage / read_length);
+    for (std::string& read : reads) {
+        read = genome.substr(rng() % (genome_length - read_length), read_length);
+        for (char& c : read) {
+            if (rng() % 200 == 0) {
+                c = bases[rng() % 4];
+            }
+        }
+    }
+    std::cout << reads.size() << " reads of " << read_length << " bp, k = " << k << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    const std::size_t map_reads = reads.size() / 10;
+    auto start = std::chrono::steady_clock::now();
+    std::unordered_map<std::string, int> frequency;
+    for (std::size_t r = 0; r < map_reads; ++r) {
+        for (std::size_t i = 0; i + k <= reads[r].size(); ++i) {
+            frequency[reads[r].substr(i, k)]++;
+        }
+    }
+    double seconds = seconds_since(start);
+    std::cout << "unordered_map " << std::setw(10) << seconds << " s" << std::setw(10)
+              << map_reads * read_length / seconds / 1e6 << " Mbases/s  (" << frequency.size()
+              << " distinct k-mers in 10 % of the reads)" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    KmerCounter counter(k, memory_mb << 20);
+    const double allocation = seconds_since(start);
+    start = std::chrono::steady_clock::now();
+    for (const std::string& read : reads) {
+        counter.addSequence(read);
+    }
+    seconds = seconds_since(start);
+    std::cout << "KmerCounter   " << std::setw(10) << seconds << " s" << std::setw(10)
+              << reads.size() * read_length / seconds / 1e6 << " Mbases/s  (" << counter.distinctKmers()
+              << " distinct canonical k-mers, " << counter.droppedKmers() << " dropped, "
+              << counter.memoryBytes() / (1 << 20) << " MiB table reserved in " << allocation << " s)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,60 @@
+// bench_unitigs.cpp
+//
+// Compactación del grafo de De Bruijn en unitigs con 1, 2, 4... hilos sobre
+// lecturas simuladas de un genoma aleatorio con un 0,5 % de errores: tiempo,
+// número de unitigs frente al de nodos y memoria de cada grafo.
+//
+// Uso: benchUnitigs [longitud del genoma] [cobertura] [k] [hilos máximos]
+//      (por defecto 2000000 30 31 hardware_concurrency)
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "parallel_graph_builder.h"
+#include "unitig_graph.h"
+
+int main(int argc, char* argv[]) {
+    const std::size_t genome_length = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    const std::size_t coverage = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 30;
+    const int k = argc > 3 ? std::atoi(argv[3]) : 31;
+    const unsigned max_threads = argc > 4 ? static_cast<unsigned>(std::atoi(argv[4])) : std::thread::hardware_concurrency();
+    const std::size_t read_length = 150;
+
+    std::mt19937 rng(3);
+    const char bases[] = "ACGT";
+    std::string genome(genome_length, 'A');
+    for (char& c : genome) {
+        c = bases[rng() % 4];
+    }
+    std::vector<std::string> reads(genome_length * coverage / read_length);
+    for (std::string& read : reads) {
+        read = genome.substr(rng() % (genome_length - read_length), read_length);
+        for (char& c : read) {
+            if (rng() % 200 == 0) {
+                c = bases[rng() % 4];
+            }
+        }
+    }
+    const CompactGraph graph = buildCompactGraphParallel(reads, k, max_threads);
+    reads.clear();
+    std::cout << "k = " << k << ": " << graph.nodeCount() << " nodes, " << graph.edgeCount() << " edges, "
+              << graph.memoryBytes() / (1 << 20) << " MiB" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    for (unsigned threads = 1; threads <= std::max(1u, max_threads); threads *= 2) {
+        auto start = std::chrono::steady_clock::now();
+        const UnitigGraph unitigs = buildUnitigGraph(graph, threads);
+        auto end = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        std::cout << std::setw(4) << threads << " threads" << std::setw(10) << seconds << " s" << std::setw(12)
+                  << graph.nodeCount() / seconds / 1e6 << " M nodes/s  (" << unitigs.unitigCount() << " unitigs, "
+                  << unitigs.totalBases() << " bases, " << unitigs.memoryBytes() / (1 << 20) << " MiB)" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+// compact_graph.h
+
+#ifndef COMPACT_GRAPH_H
+#define COMPACT_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "kmer_encoding.h"
+
+// Grafo de De Bruijn compacto: los nodos son los (k-1)-meros codificados en
+// 2 bits (kmer_encoding.h) y cada arista, un k-mero, une su prefijo con su
+// sufijo. Como un nodo sólo puede tener cuatro sucesores (uno por base
+// añadida a la derecha) y cuatro predecesores, las aristas se guardan como
+// dos máscaras de 4 bits por nodo en vez de como objetos: el bit b de la
+// máscara de salida de u indica la arista u -> (u << 2 | b), y el de entrada
+// de v la arista (b v) -> v.
+//
+// Cada arista lleva además su cobertura, las veces que su k-mero aparece en
+// las lecturas, y cada nodo la de su (k-1)-mero: los errores de secuenciación
+// dejan aristas de cobertura baja que las pasadas de graph_cleaning.h podan.
+// Las coberturas son de 16 bits y se saturan en MAX_COVERAGE.
+//
+// Los nodos viven en una tabla hash de direccionamiento abierto (sondeo
+// lineal) con arrays paralelos de claves, máscaras y coberturas: 19 bytes
+// por hueco y una ocupación máxima del 75 %, frente a los cientos de bytes
+// por nodo del grafo de graph.h (std::string, Node y Edge en el heap y la
+// entrada del unordered_map). Admite k entre 2 y 32.
+class CompactGraph {
+public:
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+    static const std::uint16_t MAX_COVERAGE = 0xFFFF;
+
+    // Lanza std::invalid_argument si k no está en [2, 32]. `expectedNodes`
+    // reserva espacio de antemano para evitar rehashes.
+    explicit CompactGraph(int k, std::size_t expectedNodes = 0);
+
+    int kmerLength() const { return k; }
+    int nodeLength() const { return k - 1; }
+
+    // Añade los nodos y aristas de una lectura, como buildGraph(), y suma
+    // una a la cobertura de cada uno. Los símbolos que no son A, C, G o T
+    // cortan la lectura.
+    void addRead(const std::string& read);
+    // Añade el nodo si no existía. Devuelve su hueco en la tabla.
+    std::size_t addNode(std::uint64_t node);
+    // Añade la arista from -> successor(from, base) y sus dos nodos, o suma
+    // una a su cobertura si ya estaba. No cambia la cobertura de los nodos.
+    void addEdge(std::uint64_t from, std::uint8_t base);
+    // Quita la arista que sale del hueco con la base dada, si existe. Los
+    // nodos siguen en la tabla aunque se queden sin aristas.
+    void removeEdge(std::size_t fromSlot, std::uint8_t base);
+    // Saca de la tabla los nodos sin aristas y la reconstruye con el tamaño
+    // justo. Cambia los huecos de todos los nodos. Devuelve cuántos quita.
+    std::size_t dropIsolatedNodes();
+
+    std::size_t nodeCount() const { return nodes; }
+    std::size_t edgeCount() const { return edges; }
+    std::size_t memoryBytes() const {
+        return keys.capacity() * sizeof(std::uint64_t) + masks.capacity() +
+               (edgeCounts.capacity() + nodeCounts.capacity()) * sizeof(std::uint16_t);
+    }
+
+    // Hueco del nodo, o npos si no está en el grafo.
+    std::size_t find(std::uint64_t node) const;
+    // Hueco en el que empieza a buscarse el nodo (el suyo, salvo colisiones).
+    std::size_t homeSlot(std::uint64_t node) const { return hashKmer(node) & (keys.size() - 1); }
+    // Pide a la caché el hueco inicial del nodo, para un find() posterior.
+    void prefetch(std::uint64_t node) const;
+    std::uint64_t successor(std::uint64_t node, std::uint8_t base) const { return ((node << 2) | base) & nodeMask; }
+    std::uint64_t predecessor(std::uint64_t node, std::uint8_t base) const {
+        return (node >> 2) | (std::uint64_t(base) << (2 * (k - 2)));
+    }
+
+    // Recorrido de la tabla: los huecos [0, slotCount()) ocupados son los nodos.
+    std::size_t slotCount() const { return keys.size(); }
+    bool occupied(std::size_t slot) const { return keys[slot] != EMPTY; }
+    std::uint64_t node(std::size_t slot) const { return keys[slot]; }
+    std::uint8_t outMask(std::size_t slot) const { return masks[slot] & 0xF; }
+    std::uint8_t inMask(std::size_t slot) const { return masks[slot] >> 4; }
+    std::string nodeString(std::size_t slot) const { return decodeKmer(keys[slot], k - 1); }
+    std::uint16_t nodeCoverage(std::size_t slot) const { return nodeCounts[slot]; }
+    // Cobertura de la arista slot -> successor(node(slot), base); 0 si no existe.
+    std::uint16_t edgeCoverage(std::size_t slot, std::uint8_t base) const { return edgeCounts[4 * slot + base]; }
+
+private:
+    friend class ParallelGraphBuilder;  // Copia su tabla concurrente directamente en los arrays
+
+    static const std::uint64_t EMPTY = ~std::uint64_t(0);  // Ningún (k-1)-mero con k <= 32 usa los 64 bits
+
+    std::size_t probe(std::uint64_t node) const;  // Hueco del nodo o el vacío donde iría
+    void rehash(std::size_t capacity);
+    void link(std::size_t fromSlot, std::size_t toSlot, std::uint8_t base);  // Arista entre dos huecos
+    void addRun(std::size_t begin);  // Nodos readNodes[begin..] de un tramo sin cortes y sus aristas
+
+    int k;
+    std::uint64_t nodeMask;
+    std::vector<std::uint64_t> keys;
+    std::vector<std::uint8_t> masks;  // Salida en los 4 bits bajos, entrada en los 4 altos
+    std::vector<std::uint16_t> edgeCounts;  // 4 por hueco, una por base de salida
+    std::vector<std::uint16_t> nodeCounts;
+    std::size_t nodes = 0;
+    std::size_t edges = 0;
+    std::vector<std::uint64_t> readNodes;  // Nodos de la lectura en curso en addRead()
+};
+
+CompactGraph buildCompactGraph(const std::vector<std::string>& reads, int k);
+
+// Mismo formato que printGraph(), que lee visualize_graph.py.
+void printCompactGraph(const CompactGraph& graph);
+
+#endif // COMPACT_GRAPH_H
@@ -0,0 +1,70 @@
+// dense_kmer_counter.h
+
+#ifndef DENSE_KMER_COUNTER_H
+#define DENSE_KMER_COUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "kmer_encoding.h"
+
+// Contador directo para k pequeño: el código de 2 bits del k-mero es su
+// índice en una tabla de 4^k cuentas (16 kB con k = 6, 64 MB con k = 12), así
+// que contar es un incremento por base, sin hash ni comparaciones. Cuenta a
+// la vez varios k en una sola pasada: todos salen de la misma ventana de 2
+// bits, la del mayor k, y el bucle está instanciado para ese k (de 1 a 12).
+//
+// Siempre se cuenta la hebra directa; con `canonical` las consultas suman
+// cada k-mero con su complementario inverso, que es lo mismo que contar el
+// canónico de cada k-mero y ahorra la ventana inversa. Las tablas son de 32
+// bits y se vuelcan a otras de 64 antes de que puedan desbordarse, así que
+// las cuentas son exactas.
+class DenseKmerCounter {
+public:
+    static const int MAX_K = 12;
+
+    // Lanza std::invalid_argument si kValues está vacío o algún k no está en
+    // [1, MAX_K]. Los k repetidos se cuentan una vez.
+    explicit DenseKmerCounter(const std::vector<int>& kValues, bool canonical = true);
+    explicit DenseKmerCounter(int k, bool canonical = true);
+
+    const std::vector<int>& kmerLengths() const { return lengths; }  // De mayor a menor
+    bool isCanonical() const { return canonical; }
+
+    // Cuenta los k-meros de la secuencia para todos los k. Los símbolos que
+    // no son A, C, G o T (mayúsculas o minúsculas) cortan la ventana.
+    void addSequence(const std::string& sequence);
+
+    // Cuenta del k-mero de longitud k (del canónico si el contador lo es).
+    // Lanza std::invalid_argument si k no es uno de los contados.
+    std::uint64_t count(int k, std::uint64_t kmer) const;
+
+    std::uint64_t totalKmers(int k) const { return totals[indexOf(k)]; }
+    std::size_t distinctKmers(int k) const;
+    std::size_t memoryBytes() const;
+
+    // Lo que pueden llegar a ocupar las tablas de esos k (los repetidos una
+    // vez): 4 bytes por código y otros 8 de la tabla de 64 bits que se añade
+    // tras 2^32 bases. Lanza std::invalid_argument igual que el constructor.
+    static std::size_t maxMemoryBytes(const std::vector<int>& kValues);
+
+private:
+    std::size_t indexOf(int k) const;
+    std::uint64_t forwardCount(std::size_t table, std::uint64_t code) const;
+    void fold();  // Suma las tablas de 32 bits a las de 64 y las deja a cero
+
+    std::vector<int> lengths;
+    bool canonical;
+    std::vector<std::vector<std::uint32_t>> tables;
+    std::vector<std::vector<std::uint64_t>> wide;  // Vacías hasta el primer fold()
+    std::vector<std::uint64_t> totals;
+    std::uint64_t pending = 0;  // Bases desde el último fold(): cota de cualquier cuenta de 32 bits
+};
+
+// Escribe "K-mero: <k-mero>, Frecuencia: <cuenta>" por cada k-mero presente
+// (sólo los canónicos si el contador lo es), k a k y en orden lexicográfico.
+void printKmerFrequencies(const DenseKmerCounter& counter, std::ostream& out);
+
+#endif // DENSE_KMER_COUNTER_H
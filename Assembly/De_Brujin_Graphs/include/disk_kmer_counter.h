@@ -0,0 +1,91 @@
+// disk_kmer_counter.h
+
+#ifndef DISK_KMER_COUNTER_H
+#define DISK_KMER_COUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct DiskCounterOptions {
+    int k = 31;                                       // Entre 1 y 63
+    std::size_t maxMemoryBytes = std::size_t(1) << 30;  // Límite de RAM de las dos pasadas
+    unsigned numThreads = 0;                          // 0: hardware_concurrency()
+    std::size_t buckets = 256;                        // Un fichero temporal abierto por cubo
+    int minimizerLength = 0;                          // 0: min(k, 11)
+    std::string tempDirectory;                        // Vacío: temp_directory_path()
+    bool canonical = true;
+};
+
+// Recuento de k-meros en dos pasadas con cubos en disco, al estilo de KMC:
+// la memoria no depende del tamaño de la entrada, sólo del límite dado.
+//
+// 1. addSequence() parte cada secuencia en super-k-meros (tramos de k-meros
+//    consecutivos con el mismo minimizador: el m-mero canónico de menor hash)
+//    y los escribe en 2 bits al fichero temporal del cubo de su minimizador.
+//    Un k-mero y su complementario inverso tienen el mismo minimizador, así
+//    que todas las apariciones de un k-mero canónico acaban en el mismo cubo.
+// 2. count() cuenta cada cubo en memoria, varios a la vez en el ThreadPool
+//    mientras quepan juntos en el límite: extrae sus k-meros, los ordena y
+//    cuenta las repeticiones. Un cubo que no cabe solo se reparte antes en
+//    varios ficheros por el hash de cada k-mero, ya contados por trozos.
+//    Toda esta memoria se reserva una vez desde el hilo que llama y se
+//    reparte entre los hilos, así que el límite se cumple con cualquier
+//    número de ellos.
+//
+// Los k-meros se guardan en std::uint64_t con k <= 31 y en unsigned __int128
+// hasta k = 63. Los ficheros temporales se crean con mkstemp() y se borran en
+// el acto, así que desaparecen al cerrarse aunque el programa termine mal.
+// Lanza std::invalid_argument con opciones fuera de rango y
+// std::runtime_error si falla el disco. Las cuentas se saturan en 2^32 - 1.
+class DiskKmerCounter {
+public:
+    using Callback = std::function<void(const std::string& kmer, std::uint32_t count)>;
+
+    explicit DiskKmerCounter(const DiskCounterOptions& options);
+    ~DiskKmerCounter();
+    DiskKmerCounter(const DiskKmerCounter&) = delete;
+    DiskKmerCounter& operator=(const DiskKmerCounter&) = delete;
+
+    // Primera pasada. Los símbolos que no son A, C, G o T cortan la secuencia.
+    void addSequence(const std::string& sequence);
+
+    // Segunda pasada: llama a callback(k-mero, cuenta) por cada k-mero
+    // distinto, cubo a cubo y siempre desde el hilo que llama. Consume los
+    // ficheros: después addSequence() y count() lanzan std::logic_error.
+    void count(const Callback& callback);
+
+    int kmerLength() const { return options.k; }
+    std::uint64_t totalKmers() const { return total; }
+    std::uint64_t distinctKmers() const { return distinct; }  // Tras count()
+    std::uint64_t diskBytes() const { return written; }       // Escritos en la primera pasada
+
+    struct Job;  // Fichero temporal pendiente de contar (definido en el .cpp)
+
+private:
+    void addFragment(const std::string& sequence, std::size_t begin, std::size_t end);
+    void writeRecord(std::uint64_t minimizer, const char* bases, std::size_t length);
+    void flush(std::size_t bucket);
+    template <typename Key> void countAll(const Callback& callback);
+    template <typename Key> void splitBucket(std::size_t bucket, std::vector<Job>& jobs, std::uint8_t* memory);
+
+    DiskCounterOptions options;
+    std::string directory;
+    std::size_t bufferBytes;  // Por cubo en la primera pasada
+    std::size_t blockBytes;   // Lecturas del disco en la segunda
+    bool counted = false;
+    std::vector<int> files;                         // Descriptor del fichero de cada cubo
+    std::vector<std::vector<std::uint8_t>> buffers;  // Escrituras pendientes de cada cubo
+    std::vector<std::uint64_t> bucketBytes;
+    std::vector<std::uint64_t> bucketKmers;
+    std::uint64_t total = 0;
+    std::uint64_t distinct = 0;
+    std::uint64_t written = 0;
+    std::deque<std::pair<std::size_t, std::uint64_t>> window;  // Candidatos a minimizador (posición, hash)
+};
+
+#endif // DISK_KMER_COUNTER_H
@@ -0,0 +1,49 @@
+// eulerian_path.h
+
+#ifndef EULERIAN_PATH_H
+#define EULERIAN_PATH_H
+
+#include <cstdint>
+#include <vector>
+#include "compact_graph.h"
+#include "unitig_graph.h"
+
+enum EulerianKind {
+    EULERIAN_NONE,     // Los grados no lo permiten (o, en findEulerianPath(), hay varias componentes)
+    EULERIAN_PATH,     // Camino abierto: empieza en el nodo con una salida de más y acaba en el de una entrada de más
+    EULERIAN_CIRCUIT   // Circuito: todos los nodos equilibrados, empieza y acaba en el mismo
+};
+
+// Recorrido que pasa una vez por cada arista: `nodes` tiene una entrada más
+// que aristas (vacío con EULERIAN_NONE).
+struct EulerianWalk {
+    EulerianKind kind = EULERIAN_NONE;
+    std::vector<std::uint64_t> nodes;
+};
+
+// Algoritmo de Hierholzer con una pila explícita: O(E) y sin recursión, de
+// modo que sirve para grafos de 10^8 aristas. El nodo inicial se elige por
+// los grados (el único con una salida más que entradas, o cualquiera con
+// aristas si todos están equilibrados). Sustituye a fleuryAlgorithm(), que
+// empezaba siempre en "AG" y no comprobaba puentes.
+//
+// Un único recorrido por todas las aristas del grafo; EULERIAN_NONE si las
+// aristas forman más de una componente débilmente conexa.
+EulerianWalk findEulerianPath(const CompactGraph& graph);
+
+// Un recorrido por cada componente débilmente conexa con aristas, en el orden
+// de la tabla del grafo. Las componentes sin camino euleriano aparecen con
+// EULERIAN_NONE.
+std::vector<EulerianWalk> findEulerianWalks(const CompactGraph& graph);
+
+// Lo mismo sobre el grafo de unitigs, mucho más pequeño: Hierholzer recorre
+// un grafo cuyos vértices son el primer y el último nodo de cada unitig, con
+// una arista por unitig de más de un nodo (su cadena interna, que sólo se
+// puede recorrer de una vez) y otra por cada enlace entre unitigs. Los nodos
+// internos tienen una entrada y una salida, así que no cambian la existencia
+// del recorrido. El resultado se expande a los (k-1)-meros de cada unitig,
+// de modo que `nodes` es un recorrido válido del CompactGraph compactado.
+EulerianWalk findEulerianPath(const UnitigGraph& unitigs);
+std::vector<EulerianWalk> findEulerianWalks(const UnitigGraph& unitigs);
+
+#endif // EULERIAN_PATH_H
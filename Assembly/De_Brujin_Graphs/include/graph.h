@@ -14,6 +14,7 @@ struct Edge {
     Node* from;   
     Node* to;     
     bool passed;
+    int coverage;  // Veces que aparece el k-mero de la arista en las lecturas
 
     Edge(Node* f, Node* t);
 };
@@ -22,6 +23,7 @@ struct Edge {
 struct Node {
     std::string kmer;         
     std::vector<Edge*> edges;
+    int coverage;  // Veces que aparece el (k-1)-mero en las lecturas
 
     Node(std::string k);
     ~Node();
@@ -33,8 +35,6 @@ std::unordered_map<std::string, Node*> buildGraph(const std::vector<std::string>
 
 void printGraph(const std::unordered_map<std::string, Node*>& graph);
 
-std::vector<Node*> fleuryAlgorithm(std::unordered_map<std::string, Node*>& graph);
-
 void getKmerFrequency(const std::vector<std::string>& reads, std::unordered_map<std::string, Node*>& graph);
 
 #endif // GRAPH_H
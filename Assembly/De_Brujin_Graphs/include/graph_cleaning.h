@@ -0,0 +1,55 @@
+// graph_cleaning.h
+
+#ifndef GRAPH_CLEANING_H
+#define GRAPH_CLEANING_H
+
+#include <cstddef>
+#include <cstdint>
+#include "compact_graph.h"
+
+// Pasadas de limpieza sobre el propio CompactGraph, pensadas para antes de
+// compactar en unitigs o buscar caminos. Un error de secuenciación en una
+// lectura crea k aristas nuevas de cobertura baja: cerca del extremo de la
+// lectura forman una punta (una cadena que nace o muere en el vacío y se une
+// al grafo por un nodo que se bifurca) y en medio, una burbuja (una rama
+// alternativa que sale de un nodo y vuelve a otro del camino correcto).
+//
+// Las pasadas sólo quitan aristas con CompactGraph::removeEdge(), así que
+// los huecos no cambian mientras trabajan; los nodos que se quedan sin
+// aristas siguen en la tabla hasta dropIsolatedNodes(). Todas devuelven el
+// número de aristas quitadas.
+
+struct CleaningOptions {
+    std::uint16_t minCoverage = 2;    // Se podan las aristas con menos cobertura (0 o 1: ninguna)
+    std::size_t maxTipLength = 0;     // Aristas de una punta; 0 usa 2k
+    std::size_t maxBubbleLength = 0;  // Aristas de cada rama de una burbuja; 0 usa 2k
+    int rounds = 3;                   // Vueltas de puntas y burbujas, mientras quiten algo
+};
+
+struct CleaningStats {
+    std::size_t prunedEdges = 0;
+    std::size_t tipEdges = 0;
+    std::size_t bubbleEdges = 0;
+    std::size_t droppedNodes = 0;
+};
+
+// Quita las aristas con cobertura menor que minCoverage.
+std::size_t pruneLowCoverage(CompactGraph& graph, std::uint16_t minCoverage);
+
+// Quita las puntas de hasta maxLength aristas: cadenas sin ramificaciones
+// que empiezan en un nodo sin entradas (o acaban en uno sin salidas) y se
+// unen a un nodo con otra entrada (o salida) al menos tan cubierta como la
+// media de la punta. Las cadenas sueltas, sin unión, no son puntas.
+std::size_t clipTips(CompactGraph& graph, std::size_t maxLength);
+
+// Revienta las burbujas simples: ramas sin ramificaciones de hasta maxLength
+// aristas que salen de un mismo nodo y llegan a un mismo nodo. Se queda la
+// rama de mayor cobertura media y se quitan las demás.
+std::size_t popBubbles(CompactGraph& graph, std::size_t maxLength);
+
+// Poda por cobertura, después puntas y burbujas hasta options.rounds vueltas
+// (las que quita una pueden dejar al descubierto otras) y al final
+// dropIsolatedNodes().
+CleaningStats cleanGraph(CompactGraph& graph, const CleaningOptions& options = CleaningOptions());
+
+#endif // GRAPH_CLEANING_H
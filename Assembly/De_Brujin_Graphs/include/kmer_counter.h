@@ -0,0 +1,86 @@
+// kmer_counter.h
+
+#ifndef KMER_COUNTER_H
+#define KMER_COUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "kmer_encoding.h"
+
+// Límite de memoria por defecto de la tabla en kmerfreq y getKmerFrequency().
+const std::size_t KMER_FREQUENCY_MEMORY = std::size_t(1) << 30;
+
+// Contador de k-meros en streaming: las secuencias se añaden de una en una
+// (no hace falta tenerlas todas en memoria) y los k-meros se codifican en 2
+// bits con una ventana deslizante, sin crear ninguna cadena. Con `canonical`
+// cada k-mero se cuenta junto a su complementario inverso, bajo el menor de
+// los dos códigos, como corresponde a lecturas de cualquiera de las hebras.
+//
+// La tabla es de direccionamiento abierto (sondeo lineal) y se reserva
+// entera al construir el contador a partir del límite de memoria (sin pasar
+// de lo que ocuparían los 4^k k-meros posibles), de modo que la memoria no
+// crece con el número de lecturas. Cuando la tabla llega
+// a su ocupación máxima ya no admite k-meros nuevos: se siguen contando los
+// que ya estaban y los nuevos se descartan y se cuentan en droppedKmers().
+// Las cuentas son de 32 bits y se saturan. Admite k entre 1 y 31.
+class KmerCounter {
+public:
+    static const std::uint32_t MAX_COUNT = 0xFFFFFFFF;
+
+    // Lanza std::invalid_argument si k no está en [1, 31] o si maxBytes no
+    // alcanza para una tabla de 16 huecos.
+    KmerCounter(int k, std::size_t maxBytes, bool canonical = true);
+
+    int kmerLength() const { return k; }
+    bool isCanonical() const { return canonical; }
+
+    // Cuenta los k-meros de la secuencia. Los símbolos que no son A, C, G o
+    // T (mayúsculas o minúsculas) cortan la ventana.
+    void addSequence(const std::string& sequence);
+
+    // Cuenta del k-mero (del canónico si el contador lo es); 0 si no está.
+    std::uint32_t count(std::uint64_t kmer) const;
+
+    std::size_t distinctKmers() const { return distinct; }
+    std::uint64_t totalKmers() const { return total; }
+    std::uint64_t droppedKmers() const { return dropped; }
+    std::size_t maxDistinctKmers() const { return maxLoad; }
+    std::size_t memoryBytes() const {
+        return keys.capacity() * sizeof(std::uint64_t) + counts.capacity() * sizeof(std::uint32_t);
+    }
+
+    // Recorrido de la tabla: los huecos [0, slotCount()) ocupados son los k-meros.
+    std::size_t slotCount() const { return keys.size(); }
+    bool occupied(std::size_t slot) const { return keys[slot] != EMPTY; }
+    std::uint64_t kmer(std::size_t slot) const { return keys[slot]; }
+    std::uint32_t countAt(std::size_t slot) const { return counts[slot]; }
+
+private:
+    static const std::uint64_t EMPTY = ~std::uint64_t(0);  // Ningún k-mero con k <= 31 usa los 64 bits
+
+    void insertCodes();  // Inserta (o cuenta) los k-meros de `codes`
+
+    int k;
+    bool canonical;
+    std::uint64_t mask;
+    std::vector<std::uint64_t> keys;
+    std::vector<std::uint32_t> counts;
+    std::size_t maxLoad;
+    std::size_t distinct = 0;
+    std::uint64_t total = 0;
+    std::uint64_t dropped = 0;
+    std::vector<std::uint64_t> codes;  // k-meros de la secuencia en curso
+};
+
+// Escribe "K-mero: <k-mero>, Frecuencia: <cuenta>" por cada k-mero, en el
+// orden de la tabla; es el formato que lee visualize_kmerFrequency.py.
+void printKmerFrequencies(const KmerCounter& counter, std::ostream& out);
+
+// Si la tabla se llenó, avisa de cuántas apariciones de k-meros nuevos se
+// han descartado.
+void reportDroppedKmers(const KmerCounter& counter, std::ostream& out);
+
+#endif // KMER_COUNTER_H
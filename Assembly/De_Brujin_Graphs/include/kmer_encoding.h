@@ -0,0 +1,79 @@
+// kmer_encoding.h
+
+#ifndef KMER_ENCODING_H
+#define KMER_ENCODING_H
+
+#include <cstdint>
+#include <string>
+
+// Codificación de k-meros de ADN en 2 bits por base (A = 0, C = 1, G = 2,
+// T = 3), con la primera base en los bits más altos: así el orden de los
+// códigos es el orden lexicográfico de las cadenas y añadir una base por la
+// derecha es (code << 2 | base) & kmerMask(k).
+
+// Código de una base, o 4 si no es A, C, G ni T (mayúsculas o minúsculas).
+inline std::uint8_t encodeBase(char c) {
+    switch (c) {
+        case 'A': case 'a': return 0;
+        case 'C': case 'c': return 1;
+        case 'G': case 'g': return 2;
+        case 'T': case 't': return 3;
+        default: return 4;
+    }
+}
+
+inline char decodeBase(std::uint8_t code) {
+    return "ACGT"[code & 3];
+}
+
+// Bits ocupados por un k-mero de longitud k (k <= 32).
+inline std::uint64_t kmerMask(int k) {
+    return k >= 32 ? ~std::uint64_t(0) : (std::uint64_t(1) << (2 * k)) - 1;
+}
+
+inline std::string decodeKmer(std::uint64_t code, int k) {
+    std::string kmer(k, 'A');
+    for (int i = k - 1; i >= 0; --i) {
+        kmer[i] = decodeBase(static_cast<std::uint8_t>(code & 3));
+        code >>= 2;
+    }
+    return kmer;
+}
+
+// Complementario inverso de un k-mero codificado.
+inline std::uint64_t reverseComplement(std::uint64_t code, int k) {
+    std::uint64_t result = 0;
+    for (int i = 0; i < k; ++i) {
+        result = (result << 2) | (3 - (code & 3));
+        code >>= 2;
+    }
+    return result;
+}
+
+// Mezcla de 64 bits (finalizador de splitmix64) para repartir los códigos en
+// tablas hash: los k-meros consecutivos de una lectura tienen códigos muy
+// parecidos.
+inline std::uint64_t hashKmer(std::uint64_t code) {
+    code ^= code >> 30;
+    code *= 0xbf58476d1ce4e5b9ULL;
+    code ^= code >> 27;
+    code *= 0x94d049bb133111ebULL;
+    code ^= code >> 31;
+    return code;
+}
+
+// Número de bases y primera base de una máscara de 4 bits con un bit por
+// base, como las de aristas de entrada y salida de los grafos.
+const int BIT_COUNT[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+const std::uint8_t LOWEST_BIT[16] = {0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
+
+// Trae a caché la línea de una dirección que se va a leer pronto.
+inline void prefetchAddress(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+}
+
+#endif // KMER_ENCODING_H
@@ -0,0 +1,67 @@
+// parallel_graph_builder.h
+
+#ifndef PARALLEL_GRAPH_BUILDER_H
+#define PARALLEL_GRAPH_BUILDER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "compact_graph.h"
+#include "thread_pool.h"
+
+// Construcción en paralelo de un CompactGraph por lotes de lecturas. Los
+// hilos se reparten las lecturas de cada lote e insertan en una tabla hash
+// concurrente sin cerrojos con la misma disposición que la de CompactGraph:
+// un nodo nuevo ocupa su hueco con un compare-and-swap sobre la clave (si
+// otro hilo se adelanta con otra clave, se sigue sondeando), las aristas se
+// añaden con un OR atómico sobre las máscaras y las coberturas se suman con
+// un compare-and-swap que se detiene en MAX_COVERAGE. Como los huecos nunca se
+// vacían, la tabla resultante es una tabla de sondeo lineal válida y se
+// copia tal cual al CompactGraph; el grafo es el mismo que el de
+// buildCompactGraph() con cualquier número de hilos.
+//
+// La tabla no puede crecer mientras los hilos insertan, así que antes de
+// cada lote se amplía (en paralelo) si los nodos que podría añadir no caben
+// con una ocupación máxima del 75 %. `batchBases` acota ese exceso: un lote
+// largo se parte en varios.
+class ParallelGraphBuilder {
+public:
+    // num_threads == 0 usa std::thread::hardware_concurrency(). Lanza
+    // std::invalid_argument si k no está en [2, 32].
+    explicit ParallelGraphBuilder(int k, unsigned numThreads = 0, std::size_t batchBases = std::size_t(1) << 22);
+    ParallelGraphBuilder(const ParallelGraphBuilder&) = delete;
+    ParallelGraphBuilder& operator=(const ParallelGraphBuilder&) = delete;
+
+    // Añade un lote de lecturas; se puede llamar tantas veces como se quiera.
+    void addReads(const std::vector<std::string>& reads);
+    // Devuelve el grafo construido y vuelve a empezar con uno vacío.
+    CompactGraph finish();
+
+    std::size_t nodeCount() const { return nodes; }
+
+private:
+    void reset();  // Tabla vacía de 16 huecos
+    void insertBatch(const std::vector<std::string>& reads, std::size_t begin, std::size_t end);
+    void reserve(std::size_t newNodes);
+    std::size_t insert(std::uint64_t node, std::size_t& created);
+    void insertRead(const std::string& read, std::vector<std::uint64_t>& readNodes, std::size_t& created);
+
+    int k;
+    std::uint64_t nodeMask;
+    std::size_t batchBases;
+    ThreadPool pool;
+    std::size_t capacity = 0;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> keys;
+    std::unique_ptr<std::atomic<std::uint8_t>[]> masks;
+    std::unique_ptr<std::atomic<std::uint16_t>[]> edgeCounts;  // 4 por hueco, como en CompactGraph
+    std::unique_ptr<std::atomic<std::uint16_t>[]> nodeCounts;
+    std::size_t nodes = 0;
+    std::vector<std::vector<std::uint64_t>> scratch;  // Nodos de la lectura en curso de cada hilo
+};
+
+CompactGraph buildCompactGraphParallel(const std::vector<std::string>& reads, int k, unsigned numThreads = 0);
+
+#endif // PARALLEL_GRAPH_BUILDER_H
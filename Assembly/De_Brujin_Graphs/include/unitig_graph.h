@@ -0,0 +1,74 @@
+// unitig_graph.h
+
+#ifndef UNITIG_GRAPH_H
+#define UNITIG_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "compact_graph.h"
+
+// Grafo de unitigs: cada camino maximal sin ramificaciones del CompactGraph
+// (aristas u -> v con una única salida en u y una única entrada en v) se
+// funde en un solo nodo, el unitig, cuya secuencia es la del primer
+// (k-1)-mero seguida de una base por arista interna. Todo nodo del grafo
+// original está en exactamente un unitig, y las aristas que quedan van
+// siempre del último nodo de un unitig al primero de otro (o de sí mismo,
+// en los ciclos aislados), así que el grafo resultante conserva las mismas
+// bifurcaciones con muchos menos nodos.
+//
+// Las secuencias se guardan seguidas en un único array de 2 bits por base
+// (la base i en los bits 2 * (i % 32) de la palabra i / 32) y cada unitig es
+// un intervalo [offset(id), offset(id + 1)) de ese array.
+class UnitigGraph {
+public:
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    int kmerLength() const { return k; }
+    std::size_t unitigCount() const { return offsets.size() - 1; }
+    std::size_t totalBases() const { return offsets.back(); }
+    std::size_t memoryBytes() const;
+
+    std::size_t length(std::size_t id) const { return offsets[id + 1] - offsets[id]; }
+    // Número de (k-1)-meros del grafo original que contiene el unitig.
+    std::size_t nodeCount(std::size_t id) const { return length(id) - (k - 2); }
+    std::uint8_t base(std::size_t id, std::size_t i) const {
+        const std::size_t position = offsets[id] + i;
+        return static_cast<std::uint8_t>((arena[position / 32] >> (2 * (position % 32))) & 3);
+    }
+    std::string sequence(std::size_t id) const;
+
+    // Aristas hacia otros unitigs: el bit b de outMask() indica que el último
+    // nodo del unitig continúa con la base b, hacia successor(id, b). inMask()
+    // son las entradas del primer nodo.
+    std::uint8_t outMask(std::size_t id) const { return masks[id] & 0xF; }
+    std::uint8_t inMask(std::size_t id) const { return masks[id] >> 4; }
+    std::size_t successor(std::size_t id, std::uint8_t base) const { return successors[4 * id + base]; }
+    // Ciclo aislado: su única salida vuelve a su propio principio.
+    bool circular(std::size_t id) const;
+
+private:
+    friend UnitigGraph buildUnitigGraph(const CompactGraph& graph, unsigned numThreads);
+
+    int k = 0;
+    std::vector<std::uint64_t> arena;
+    std::vector<std::size_t> offsets{0};  // unitigCount() + 1 posiciones en el array
+    std::vector<std::uint8_t> masks;      // Salida en los 4 bits bajos, entrada en los 4 altos
+    std::vector<std::size_t> successors;  // 4 por unitig, npos sin arista
+};
+
+// Compacta el grafo en paralelo: los hilos se reparten la tabla por tramos,
+// detectan los nodos en los que empieza un unitig y recorren cada cadena
+// hasta su final. Los unitigs quedan ordenados por el hueco de su primer
+// nodo (los ciclos aislados, al final), así que el resultado no depende del
+// número de hilos. numThreads == 0 usa std::thread::hardware_concurrency().
+UnitigGraph buildUnitigGraph(const CompactGraph& graph, unsigned numThreads = 0);
+
+// Escribe los unitigs en FASTA (">contig_<id> length=<bases>") con líneas de
+// `lineWidth` bases. `minLength` omite los más cortos.
+void writeContigsFasta(const UnitigGraph& unitigs, std::ostream& out, std::size_t minLength = 0,
+                       std::size_t lineWidth = 80);
+
+#endif // UNITIG_GRAPH_H
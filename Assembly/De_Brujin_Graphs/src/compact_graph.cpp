@@ -0,0 +1,209 @@
+// compact_graph.cpp
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include "compact_graph.h"
+
+const std::size_t CompactGraph::npos;
+const std::uint64_t CompactGraph::EMPTY;
+const std::uint16_t CompactGraph::MAX_COVERAGE;
+
+namespace {
+
+inline void increment(std::uint16_t& coverage) {
+    if (coverage < CompactGraph::MAX_COVERAGE) {
+        ++coverage;
+    }
+}
+
+} // namespace
+
+CompactGraph::CompactGraph(int k, std::size_t expectedNodes) : k(k) {
+    if (k < 2 || k > 32) {
+        throw std::invalid_argument("CompactGraph: k debe estar entre 2 y 32");
+    }
+    nodeMask = kmerMask(k - 1);  // Con k ya comprobado
+    // Potencia de dos con al menos un 25 % de huecos libres.
+    std::size_t capacity = 16;
+    while (capacity * 3 < expectedNodes * 4) {
+        capacity *= 2;
+    }
+    keys.assign(capacity, EMPTY);
+    masks.assign(capacity, 0);
+    edgeCounts.assign(4 * capacity, 0);
+    nodeCounts.assign(capacity, 0);
+}
+
+std::size_t CompactGraph::probe(std::uint64_t node) const {
+    const std::size_t mask = keys.size() - 1;
+    std::size_t slot = hashKmer(node) & mask;
+    while (keys[slot] != EMPTY && keys[slot] != node) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+std::size_t CompactGraph::find(std::uint64_t node) const {
+    const std::size_t slot = probe(node);
+    return keys[slot] == EMPTY ? npos : slot;
+}
+
+void CompactGraph::prefetch(std::uint64_t node) const {
+    const std::size_t slot = homeSlot(node);
+    prefetchAddress(&keys[slot]);
+    prefetchAddress(&masks[slot]);
+}
+
+void CompactGraph::rehash(std::size_t capacity) {
+    std::vector<std::uint64_t> oldKeys(capacity, EMPTY);
+    std::vector<std::uint8_t> oldMasks(capacity, 0);
+    std::vector<std::uint16_t> oldEdgeCounts(4 * capacity, 0);
+    std::vector<std::uint16_t> oldNodeCounts(capacity, 0);
+    oldKeys.swap(keys);
+    oldMasks.swap(masks);
+    oldEdgeCounts.swap(edgeCounts);
+    oldNodeCounts.swap(nodeCounts);
+    for (std::size_t slot = 0; slot < oldKeys.size(); ++slot) {
+        if (oldKeys[slot] != EMPTY) {
+            const std::size_t target = probe(oldKeys[slot]);
+            keys[target] = oldKeys[slot];
+            masks[target] = oldMasks[slot];
+            nodeCounts[target] = oldNodeCounts[slot];
+            std::copy(&oldEdgeCounts[4 * slot], &oldEdgeCounts[4 * slot] + 4, &edgeCounts[4 * target]);
+        }
+    }
+}
+
+std::size_t CompactGraph::addNode(std::uint64_t node) {
+    std::size_t slot = probe(node);
+    if (keys[slot] == EMPTY) {
+        if ((nodes + 1) * 4 > keys.size() * 3) {
+            rehash(2 * keys.size());
+            slot = probe(node);
+        }
+        keys[slot] = node;
+        ++nodes;
+    }
+    return slot;
+}
+
+void CompactGraph::link(std::size_t fromSlot, std::size_t toSlot, std::uint8_t base) {
+    if ((masks[fromSlot] & (1u << base)) == 0) {
+        const std::uint8_t first = static_cast<std::uint8_t>(keys[fromSlot] >> (2 * (k - 2)));
+        masks[fromSlot] |= static_cast<std::uint8_t>(1u << base);
+        masks[toSlot] |= static_cast<std::uint8_t>(0x10u << first);
+        ++edges;
+    }
+    increment(edgeCounts[4 * fromSlot + base]);
+}
+
+void CompactGraph::removeEdge(std::size_t fromSlot, std::uint8_t base) {
+    if ((masks[fromSlot] & (1u << base)) == 0) {
+        return;
+    }
+    const std::uint8_t first = static_cast<std::uint8_t>(keys[fromSlot] >> (2 * (k - 2)));
+    const std::size_t toSlot = find(successor(keys[fromSlot], base));
+    masks[fromSlot] &= static_cast<std::uint8_t>(~(1u << base));
+    masks[toSlot] &= static_cast<std::uint8_t>(~(0x10u << first));
+    edgeCounts[4 * fromSlot + base] = 0;
+    --edges;
+}
+
+std::size_t CompactGraph::dropIsolatedNodes() {
+    const std::size_t before = nodes;
+    for (std::size_t slot = 0; slot < keys.size(); ++slot) {
+        if (keys[slot] != EMPTY && masks[slot] == 0) {
+            keys[slot] = EMPTY;  // rehash() sólo copia los huecos ocupados
+            --nodes;
+        }
+    }
+    std::size_t capacity = 16;
+    while (capacity * 3 < nodes * 4) {
+        capacity *= 2;
+    }
+    rehash(capacity);
+    return before - nodes;
+}
+
+void CompactGraph::addEdge(std::uint64_t from, std::uint8_t base) {
+    addNode(from);
+    const std::size_t toSlot = addNode(successor(from, base));
+    link(find(from), toSlot, base);  // addNode() puede haber redistribuido la tabla
+}
+
+void CompactGraph::addRead(const std::string& read) {
+    // Primero los códigos de los nodos de cada tramo de bases válidas y luego
+    // la inserción, que así puede pedir por adelantado (prefetch) los huecos
+    // de los nodos siguientes: cada búsqueda es un fallo de caché casi seguro
+    // y de otro modo se esperarían uno tras otro.
+    const int nodeLength = k - 1;
+    std::uint64_t node = 0;
+    int valid = 0;  // Bases válidas consecutivas, hasta nodeLength
+    std::size_t runStart = 0;
+    readNodes.clear();
+    for (char c : read) {
+        const std::uint8_t base = encodeBase(c);
+        if (base > 3) {
+            addRun(runStart);
+            runStart = readNodes.size();
+            valid = 0;
+            continue;
+        }
+        node = successor(node, base);
+        if (valid < nodeLength) {
+            ++valid;
+        }
+        if (valid == nodeLength) {
+            readNodes.push_back(node);
+        }
+    }
+    addRun(runStart);
+}
+
+void CompactGraph::addRun(std::size_t begin) {
+    const std::size_t end = readNodes.size();
+    const std::size_t lookahead = 8;
+    std::size_t slot = npos;
+    for (std::size_t i = begin; i < end; ++i) {
+        if (i + lookahead < end) {
+            const std::size_t ahead = homeSlot(readNodes[i + lookahead]);
+            prefetchAddress(&keys[ahead]);
+            prefetchAddress(&masks[ahead]);
+            prefetchAddress(&edgeCounts[4 * ahead]);
+            prefetchAddress(&nodeCounts[ahead]);
+        }
+        const std::size_t capacity = keys.size();
+        const std::size_t nextSlot = addNode(readNodes[i]);
+        increment(nodeCounts[nextSlot]);
+        if (i > begin) {
+            if (keys.size() != capacity) {
+                slot = find(readNodes[i - 1]);  // addNode() ha redistribuido la tabla
+            }
+            link(slot, nextSlot, static_cast<std::uint8_t>(readNodes[i] & 3));
+        }
+        slot = nextSlot;
+    }
+}
+
+CompactGraph buildCompactGraph(const std::vector<std::string>& reads, int k) {
+    CompactGraph graph(k);
+    for (const std::string& read : reads) {
+        graph.addRead(read);
+    }
+    return graph;
+}
+
+void printCompactGraph(const CompactGraph& graph) {
+    for (std::size_t slot = 0; slot < graph.slotCount(); ++slot) {
+        if (!graph.occupied(slot)) {
+            continue;
+        }
+        std::cout << "Node " << graph.nodeString(slot) << " has edges to: ";
+        for (std::uint8_t base = 0; base < 4; ++base) {
+            if (graph.outMask(slot) & (1u << base)) {
+                std::cout << decodeKmer(graph.successor(graph.node(slot), base), graph.nodeLength()) << " ";
+            }
+        }
+        std::cout << '\n';
+    }
+}
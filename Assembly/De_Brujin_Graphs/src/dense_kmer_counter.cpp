@@ -0,0 +1,204 @@
+// dense_kmer_counter.cpp
+#include <algorithm>
+#include <stdexcept>
+#include "dense_kmer_counter.h"
+
+namespace {
+
+const std::uint64_t MAX_PENDING = 0xFFFFFFFF;
+const std::size_t CHUNK_BASES = std::size_t(1) << 30;  // Secuencias de más de 4 Gb también
+
+// encodeBase() en tabla: el bucle de recuento sólo hace una carga por base.
+struct BaseCodes {
+    std::uint8_t code[256];
+    BaseCodes() {
+        for (int c = 0; c < 256; ++c) {
+            code[c] = encodeBase(static_cast<char>(c));
+        }
+    }
+};
+const BaseCodes BASE_CODES;
+
+// Ventana de la secuencia en curso, que sigue de un trozo al siguiente.
+struct Window {
+    std::uint32_t code = 0;
+    int valid = 0;
+};
+
+// Recorre [begin, end) con la ventana de MaxK bases y suma cada k-mero en
+// su tabla; tables[0] es la de MaxK. Los k menores son los últimos k bases
+// de la misma ventana (code & masks[i]) en cuanto hay k válidas.
+template <int MaxK>
+void countKmers(const char* begin, const char* end, Window& window, std::uint32_t* const* tables,
+                const int* lengths, const std::uint32_t* masks, std::size_t count, std::uint64_t* added) {
+    const std::uint32_t fullMask = (std::uint32_t(1) << (2 * MaxK)) - 1;
+    std::uint32_t code = window.code;
+    int valid = window.valid;
+    for (const char* c = begin; c != end; ++c) {
+        const std::uint8_t base = BASE_CODES.code[static_cast<unsigned char>(*c)];
+        if (base > 3) {
+            valid = 0;
+            continue;
+        }
+        code = ((code << 2) | base) & fullMask;
+        if (valid < MaxK) {
+            ++valid;
+        }
+        if (valid == MaxK) {
+            ++tables[0][code];
+            ++added[0];
+            for (std::size_t i = 1; i < count; ++i) {
+                ++tables[i][code & masks[i]];
+                ++added[i];
+            }
+        } else {
+            for (std::size_t i = 1; i < count; ++i) {
+                if (valid >= lengths[i]) {
+                    ++tables[i][code & masks[i]];
+                    ++added[i];
+                }
+            }
+        }
+    }
+    window.code = code;
+    window.valid = valid;
+}
+
+typedef void (*Kernel)(const char*, const char*, Window&, std::uint32_t* const*, const int*, const std::uint32_t*,
+                       std::size_t, std::uint64_t*);
+
+const Kernel KERNELS[DenseKmerCounter::MAX_K + 1] = {
+    nullptr,        countKmers<1>, countKmers<2>, countKmers<3>,  countKmers<4>,  countKmers<5>, countKmers<6>,
+    countKmers<7>, countKmers<8>, countKmers<9>, countKmers<10>, countKmers<11>, countKmers<12>};
+
+// Los k de mayor a menor y sin repetir; lanza si alguno no vale.
+std::vector<int> sortedLengths(std::vector<int> lengths) {
+    if (lengths.empty()) {
+        throw std::invalid_argument("DenseKmerCounter: hace falta al menos un k");
+    }
+    for (int k : lengths) {
+        if (k < 1 || k > DenseKmerCounter::MAX_K) {
+            throw std::invalid_argument("DenseKmerCounter: k debe estar entre 1 y 12");
+        }
+    }
+    std::sort(lengths.begin(), lengths.end(), [](int a, int b) { return a > b; });
+    lengths.erase(std::unique(lengths.begin(), lengths.end()), lengths.end());
+    return lengths;
+}
+
+} // namespace
+
+const int DenseKmerCounter::MAX_K;
+
+DenseKmerCounter::DenseKmerCounter(const std::vector<int>& kValues, bool canonical)
+    : lengths(sortedLengths(kValues)), canonical(canonical) {
+    for (int k : lengths) {
+        tables.emplace_back(std::size_t(1) << (2 * k), 0);
+    }
+    wide.resize(lengths.size());
+    totals.assign(lengths.size(), 0);
+}
+
+DenseKmerCounter::DenseKmerCounter(int k, bool canonical) : DenseKmerCounter(std::vector<int>{k}, canonical) {
+}
+
+void DenseKmerCounter::addSequence(const std::string& sequence) {
+    std::vector<std::uint32_t*> pointers(lengths.size());
+    std::vector<std::uint32_t> masks(lengths.size());
+    std::uint64_t added[MAX_K] = {};
+    for (std::size_t i = 0; i < lengths.size(); ++i) {
+        pointers[i] = tables[i].data();
+        masks[i] = static_cast<std::uint32_t>(kmerMask(lengths[i]));
+    }
+    const Kernel kernel = KERNELS[lengths[0]];
+    Window window;
+    for (std::size_t first = 0; first < sequence.size(); first += CHUNK_BASES) {
+        const std::size_t size = std::min(CHUNK_BASES, sequence.size() - first);
+        if (pending + size > MAX_PENDING) {
+            fold();
+        }
+        pending += size;
+        kernel(sequence.data() + first, sequence.data() + first + size, window, pointers.data(), lengths.data(),
+               masks.data(), lengths.size(), added);
+    }
+    for (std::size_t i = 0; i < lengths.size(); ++i) {
+        totals[i] += added[i];
+    }
+}
+
+void DenseKmerCounter::fold() {
+    for (std::size_t i = 0; i < tables.size(); ++i) {
+        wide[i].resize(tables[i].size(), 0);
+        for (std::size_t code = 0; code < tables[i].size(); ++code) {
+            wide[i][code] += tables[i][code];
+            tables[i][code] = 0;
+        }
+    }
+    pending = 0;
+}
+
+std::size_t DenseKmerCounter::indexOf(int k) const {
+    for (std::size_t i = 0; i < lengths.size(); ++i) {
+        if (lengths[i] == k) {
+            return i;
+        }
+    }
+    throw std::invalid_argument("DenseKmerCounter: k no es uno de los contados");
+}
+
+std::uint64_t DenseKmerCounter::forwardCount(std::size_t table, std::uint64_t code) const {
+    return tables[table][code] + (wide[table].empty() ? 0 : wide[table][code]);
+}
+
+std::uint64_t DenseKmerCounter::count(int k, std::uint64_t kmer) const {
+    const std::size_t table = indexOf(k);
+    kmer &= kmerMask(k);
+    if (!canonical) {
+        return forwardCount(table, kmer);
+    }
+    const std::uint64_t reverse = reverseComplement(kmer, k);
+    return forwardCount(table, kmer) + (reverse != kmer ? forwardCount(table, reverse) : 0);
+}
+
+std::size_t DenseKmerCounter::distinctKmers(int k) const {
+    const std::size_t table = indexOf(k);
+    std::size_t distinct = 0;
+    for (std::uint64_t code = 0; code < tables[table].size(); ++code) {
+        if (canonical && reverseComplement(code, k) < code) {
+            continue;
+        }
+        distinct += count(k, code) > 0;
+    }
+    return distinct;
+}
+
+std::size_t DenseKmerCounter::memoryBytes() const {
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < tables.size(); ++i) {
+        bytes += tables[i].capacity() * sizeof(std::uint32_t) + wide[i].capacity() * sizeof(std::uint64_t);
+    }
+    return bytes;
+}
+
+std::size_t DenseKmerCounter::maxMemoryBytes(const std::vector<int>& kValues) {
+    std::size_t bytes = 0;
+    for (int k : sortedLengths(kValues)) {
+        bytes += (sizeof(std::uint32_t) + sizeof(std::uint64_t)) << (2 * k);
+    }
+    return bytes;
+}
+
+void printKmerFrequencies(const DenseKmerCounter& counter, std::ostream& out) {
+    for (int k : counter.kmerLengths()) {
+        const std::uint64_t codes = std::uint64_t(1) << (2 * k);
+        for (std::uint64_t code = 0; code < codes; ++code) {
+            if (counter.isCanonical() && reverseComplement(code, k) < code) {
+                continue;
+            }
+            const std::uint64_t frequency = counter.count(k, code);
+            if (frequency > 0) {
+                out << "K-mero: " << decodeKmer(code, k) << ", Frecuencia: " << frequency << '\n';
+            }
+        }
+    }
+}
@@ -0,0 +1,548 @@
+// disk_kmer_counter.cpp
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <unistd.h>
+#include "disk_kmer_counter.h"
+#include "kmer_encoding.h"
+#include "thread_pool.h"
+
+__extension__ typedef unsigned __int128 uint128;
+
+namespace {
+
+const std::size_t MAX_RECORD_BASES = 4096;  // Cabe en la longitud de 16 bits de cada registro
+const std::size_t MIN_BUFFER_BYTES = std::size_t(4) << 10;
+const std::size_t MAX_BUFFER_BYTES = std::size_t(1) << 20;
+const std::uint32_t MAX_COUNT = 0xFFFFFFFF;
+
+// Sin esta mezcla el m-mero AAA...A (código 0) tendría siempre hash 0 y sería
+// el minimizador de todas las colas de poli-A.
+const std::uint64_t MINIMIZER_SEED = 0x9e3779b97f4a7c15ULL;
+
+int createTempFile(const std::string& directory) {
+    // Fichero temporal borrado nada más crearlo, como en RapidNJSearch.
+    std::string path = directory + "/disk_kmer_XXXXXX";
+    int fd = mkstemp(&path[0]);
+    if (fd < 0) {
+        throw std::runtime_error("DiskKmerCounter: no se pudo crear un fichero temporal en " + directory);
+    }
+    unlink(path.c_str());
+    return fd;
+}
+
+void writeAll(int fd, const std::uint8_t* data, std::size_t size) {
+    while (size > 0) {
+        const ssize_t done = ::write(fd, data, size);
+        if (done < 0 && errno == EINTR) {
+            continue;
+        }
+        if (done <= 0) {
+            throw std::runtime_error("DiskKmerCounter: error al escribir un fichero temporal");
+        }
+        data += done;
+        size -= static_cast<std::size_t>(done);
+    }
+}
+
+void readAll(int fd, std::uint8_t* data, std::size_t size, std::uint64_t offset) {
+    while (size > 0) {
+        const ssize_t done = ::pread(fd, data, size, static_cast<off_t>(offset));
+        if (done < 0 && errno == EINTR) {
+            continue;
+        }
+        if (done <= 0) {
+            throw std::runtime_error("DiskKmerCounter: error al leer un fichero temporal");
+        }
+        data += done;
+        size -= static_cast<std::size_t>(done);
+        offset += static_cast<std::uint64_t>(done);
+    }
+}
+
+// Lee el fichero por bloques y pasa cada uno a consume(datos, tamaño), que
+// devuelve los bytes que ha usado; lo que sobra se vuelve a leer al principio
+// del bloque siguiente.
+template <typename Consume>
+void readBlocks(int fd, std::uint64_t bytes, std::uint8_t* block, std::size_t blockBytes, Consume consume) {
+    std::uint64_t offset = 0;
+    while (offset < bytes) {
+        const std::size_t size = static_cast<std::size_t>(std::min<std::uint64_t>(blockBytes, bytes - offset));
+        readAll(fd, block, size, offset);
+        const std::size_t used = consume(block, size);
+        if (used == 0) {
+            throw std::runtime_error("DiskKmerCounter: fichero temporal dañado");
+        }
+        offset += used;
+    }
+}
+
+inline std::uint64_t hashKey(std::uint64_t key) {
+    return hashKmer(key);
+}
+
+inline std::uint64_t hashKey(uint128 key) {
+    return hashKmer(static_cast<std::uint64_t>(key) ^ hashKmer(static_cast<std::uint64_t>(key >> 64)));
+}
+
+inline std::uint32_t saturate(std::uint64_t count) {
+    return count < MAX_COUNT ? static_cast<std::uint32_t>(count) : MAX_COUNT;
+}
+
+// Extrae los k-meros de los registros completos de `data` a keys[count...]
+// mientras quepan en maxKeys y devuelve los bytes leídos. Cada registro es su
+// longitud en bases (16 bits) y las bases en 2 bits, la i-ésima en los bits
+// 2 * (i % 4) del byte i / 4.
+template <typename Key>
+std::size_t decodeRecords(const std::uint8_t* data, std::size_t size, int k, bool canonical, Key* keys,
+                          std::size_t& count, std::size_t maxKeys) {
+    const Key mask = (Key(1) << (2 * k)) - 1;
+    const unsigned reverseShift = 2 * (k - 1);
+    std::size_t position = 0;
+    while (position + 2 <= size) {
+        const std::size_t length = data[position] | (std::size_t(data[position + 1]) << 8);
+        const std::size_t recordBytes = 2 + (length + 3) / 4;
+        if (position + recordBytes > size || count + (length - k + 1) > maxKeys) {
+            break;
+        }
+        const std::uint8_t* bases = data + position + 2;
+        Key forward = 0;
+        Key reverse = 0;
+        for (std::size_t i = 0; i < length; ++i) {
+            const std::uint8_t base = (bases[i / 4] >> (2 * (i % 4))) & 3;
+            forward = ((forward << 2) | base) & mask;
+            reverse = (reverse >> 2) | (Key(3 - base) << reverseShift);
+            if (i + 1 >= static_cast<std::size_t>(k)) {
+                keys[count++] = canonical && reverse < forward ? reverse : forward;
+            }
+        }
+        position += recordBytes;
+    }
+    return position;
+}
+
+// Ordena keys[0, size) y deja al principio cada k-mero una vez y en counts
+// sus cuentas, sin memoria aparte. Devuelve los k-meros distintos.
+template <typename Key>
+std::size_t countSorted(Key* keys, std::size_t size, std::uint32_t* counts) {
+    std::sort(keys, keys + size);
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < size;) {
+        std::size_t j = i + 1;
+        while (j < size && keys[j] == keys[i]) {
+            ++j;
+        }
+        keys[out] = keys[i];
+        counts[out++] = saturate(j - i);
+        i = j;
+    }
+    return out;
+}
+
+// Par (k-mero, cuenta) de una parte de un cubo repartido.
+template <typename Key>
+struct Entry {
+    Key key;
+    std::uint32_t count;
+};
+
+// Resultado de un fichero, listo para pasar al callback.
+template <typename Key>
+struct Counted {
+    const Key* keys;
+    const std::uint32_t* counts;
+    std::size_t size;
+};
+
+// Memoria de la segunda pasada. Se reserva desde el hilo que llama a count()
+// y cada trabajo usa su trozo: si los hilos reservaran la suya, lo que
+// liberan se quedaría en el arena de malloc de cada hilo y la RAM pasaría
+// del límite. Sin inicializar, así que sólo ocupa lo que se llega a tocar.
+struct alignas(64) CacheLine {
+    std::uint8_t bytes[64];
+};
+
+class Arena {
+public:
+    void reserve(std::size_t bytes) {
+        if (bytes > size) {
+            storage.reset();
+            storage.reset(new CacheLine[(bytes + sizeof(CacheLine) - 1) / sizeof(CacheLine)]);
+            size = bytes;
+        }
+    }
+    std::uint8_t* data() const { return reinterpret_cast<std::uint8_t*>(storage.get()); }
+
+private:
+    std::unique_ptr<CacheLine[]> storage;
+    std::size_t size = 0;
+};
+
+// Tamaño de cada trozo de la memoria redondeado a una línea de caché: los
+// trozos quedan alineados para cualquier Key y los hilos no comparten líneas.
+inline std::size_t aligned(std::size_t bytes) {
+    return (bytes + sizeof(CacheLine) - 1) & ~(sizeof(CacheLine) - 1);
+}
+
+template <typename T>
+T* take(std::uint8_t*& cursor, std::size_t count) {
+    static_assert(alignof(T) <= alignof(CacheLine), "Arena: alineamiento insuficiente");
+    T* memory = reinterpret_cast<T*>(cursor);
+    cursor += aligned(count * sizeof(T));
+    return memory;
+}
+
+} // namespace
+
+// Un fichero de super-k-meros (un cubo) o de pares (k-mero, cuenta) de
+// sizeof(Key) + 4 bytes (una parte de un cubo repartido).
+struct DiskKmerCounter::Job {
+    std::size_t file;     // Índice en `files`
+    std::uint64_t bytes;
+    std::uint64_t items;  // k-meros o pares
+    bool pairs;
+};
+
+DiskKmerCounter::DiskKmerCounter(const DiskCounterOptions& options) : options(options) {
+    if (options.k < 1 || options.k > 63) {
+        throw std::invalid_argument("DiskKmerCounter: k debe estar entre 1 y 63");
+    }
+    if (options.buckets < 1 || options.buckets > 4096) {
+        throw std::invalid_argument("DiskKmerCounter: el número de cubos debe estar entre 1 y 4096");
+    }
+    if (this->options.minimizerLength == 0) {
+        this->options.minimizerLength = std::min(options.k, 11);
+    }
+    if (this->options.minimizerLength < 1 || this->options.minimizerLength > std::min(options.k, 31)) {
+        throw std::invalid_argument("DiskKmerCounter: el minimizador debe medir entre 1 y min(k, 31)");
+    }
+    if (options.maxMemoryBytes < (std::size_t(1) << 20) ||
+        options.maxMemoryBytes / 2 < options.buckets * MIN_BUFFER_BYTES) {
+        throw std::invalid_argument("DiskKmerCounter: límite de memoria demasiado pequeño");
+    }
+    // La mitad del límite para los búferes de la primera pasada.
+    bufferBytes = std::min(MAX_BUFFER_BYTES, options.maxMemoryBytes / 2 / options.buckets);
+    blockBytes = std::min(MAX_BUFFER_BYTES, options.maxMemoryBytes / 16);
+    directory = options.tempDirectory.empty() ? std::filesystem::temp_directory_path().string()
+                                              : options.tempDirectory;
+
+    files.assign(options.buckets, -1);
+    buffers.resize(options.buckets);
+    bucketBytes.assign(options.buckets, 0);
+    bucketKmers.assign(options.buckets, 0);
+    for (std::size_t bucket = 0; bucket < options.buckets; ++bucket) {
+        files[bucket] = createTempFile(directory);
+    }
+}
+
+DiskKmerCounter::~DiskKmerCounter() {
+    for (int fd : files) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+void DiskKmerCounter::addSequence(const std::string& sequence) {
+    if (counted) {
+        throw std::logic_error("DiskKmerCounter: count() ya se ha llamado");
+    }
+    std::size_t begin = 0;
+    while (begin < sequence.size()) {
+        while (begin < sequence.size() && encodeBase(sequence[begin]) > 3) {
+            ++begin;
+        }
+        std::size_t end = begin;
+        while (end < sequence.size() && encodeBase(sequence[end]) <= 3) {
+            ++end;
+        }
+        if (end - begin >= static_cast<std::size_t>(options.k)) {
+            addFragment(sequence, begin, end);
+        }
+        begin = end;
+    }
+}
+
+void DiskKmerCounter::addFragment(const std::string& sequence, std::size_t begin, std::size_t end) {
+    // El minimizador de cada k-mero sale de una ventana deslizante de mínimos
+    // sobre los hashes de sus k - m + 1 m-meros canónicos; los k-meros
+    // consecutivos con el mismo minimizador forman un super-k-mero.
+    const std::size_t k = static_cast<std::size_t>(options.k);
+    const int m = options.minimizerLength;
+    const std::uint64_t mMask = kmerMask(m);
+    const unsigned reverseShift = 2 * (m - 1);
+    std::uint64_t forward = 0;
+    std::uint64_t reverse = 0;
+    window.clear();
+
+    std::size_t recordStart = 0;
+    std::size_t recordKmers = 0;
+    std::uint64_t recordMinimizer = 0;
+    for (std::size_t position = begin; position < end; ++position) {
+        const std::uint8_t base = encodeBase(sequence[position]);
+        forward = ((forward << 2) | base) & mMask;
+        reverse = (reverse >> 2) | (std::uint64_t(3 - base) << reverseShift);
+        if (position + 1 - begin >= static_cast<std::size_t>(m)) {
+            const std::uint64_t hash = hashKmer((reverse < forward ? reverse : forward) ^ MINIMIZER_SEED);
+            while (!window.empty() && window.back().second >= hash) {
+                window.pop_back();
+            }
+            window.emplace_back(position + 1 - m, hash);
+        }
+        if (position + 1 - begin < k) {
+            continue;
+        }
+        const std::size_t start = position + 1 - k;
+        while (window.front().first < start) {
+            window.pop_front();
+        }
+        const std::uint64_t minimizer = window.front().second;
+        if (recordKmers > 0 && (minimizer != recordMinimizer || recordKmers + k > MAX_RECORD_BASES)) {
+            writeRecord(recordMinimizer, sequence.data() + recordStart, recordKmers + k - 1);
+            recordKmers = 0;
+        }
+        if (recordKmers == 0) {
+            recordStart = start;
+            recordMinimizer = minimizer;
+        }
+        ++recordKmers;
+    }
+    if (recordKmers > 0) {
+        writeRecord(recordMinimizer, sequence.data() + recordStart, recordKmers + k - 1);
+    }
+}
+
+void DiskKmerCounter::writeRecord(std::uint64_t minimizer, const char* bases, std::size_t length) {
+    const std::size_t bucket = minimizer % options.buckets;
+    std::vector<std::uint8_t>& buffer = buffers[bucket];
+    const std::size_t first = buffer.size();
+    buffer.resize(first + 2 + (length + 3) / 4, 0);
+    buffer[first] = static_cast<std::uint8_t>(length & 0xFF);
+    buffer[first + 1] = static_cast<std::uint8_t>(length >> 8);
+    std::uint8_t* packed = buffer.data() + first + 2;
+    for (std::size_t i = 0; i < length; ++i) {
+        packed[i / 4] |= static_cast<std::uint8_t>(encodeBase(bases[i]) << (2 * (i % 4)));
+    }
+    const std::uint64_t kmers = length - options.k + 1;
+    bucketKmers[bucket] += kmers;
+    total += kmers;
+    if (buffer.size() >= bufferBytes) {
+        flush(bucket);
+    }
+}
+
+void DiskKmerCounter::flush(std::size_t bucket) {
+    std::vector<std::uint8_t>& buffer = buffers[bucket];
+    writeAll(files[bucket], buffer.data(), buffer.size());
+    bucketBytes[bucket] += buffer.size();
+    written += buffer.size();
+    buffer.clear();
+}
+
+void DiskKmerCounter::count(const Callback& callback) {
+    if (counted) {
+        throw std::logic_error("DiskKmerCounter: count() ya se ha llamado");
+    }
+    counted = true;
+    for (std::size_t bucket = 0; bucket < options.buckets; ++bucket) {
+        flush(bucket);
+    }
+    // Los búferes de la primera pasada dejan sitio a la segunda.
+    std::vector<std::vector<std::uint8_t>>().swap(buffers);
+    if (options.k <= 31) {
+        countAll<std::uint64_t>(callback);
+    } else {
+        countAll<uint128>(callback);
+    }
+}
+
+template <typename Key>
+void DiskKmerCounter::countAll(const Callback& callback) {
+    const std::size_t cap = options.maxMemoryBytes;
+    // Trozo de memoria de un fichero: sus k-meros, sus cuentas, los pares si
+    // es una parte de un cubo repartido y el bloque de lectura.
+    auto need = [&](const Job& job) {
+        const std::size_t items = static_cast<std::size_t>(job.items);
+        return aligned(items * sizeof(Key)) + aligned(items * sizeof(std::uint32_t)) +
+               (job.pairs ? aligned(items * sizeof(Entry<Key>)) : 0) + aligned(blockBytes);
+    };
+
+    Arena arena;
+    std::vector<Job> jobs;
+    for (std::size_t bucket = 0; bucket < options.buckets; ++bucket) {
+        const Job job = {bucket, bucketBytes[bucket], bucketKmers[bucket], false};
+        if (job.items == 0) {
+            continue;
+        }
+        if (need(job) > cap) {
+            arena.reserve(cap);
+            splitBucket<Key>(bucket, jobs, arena.data());
+        } else {
+            jobs.push_back(job);
+        }
+    }
+
+    // Oleadas de ficheros que caben juntos en el límite, uno por hilo; un
+    // fichero que no cabe ni solo (una parte muy desequilibrada) va aparte.
+    ThreadPool pool(options.numThreads);
+    std::vector<std::size_t> waveEnds;
+    std::size_t arenaBytes = 0;
+    for (std::size_t next = 0; next < jobs.size();) {
+        std::size_t end = next;
+        std::size_t used = 0;
+        while (end < jobs.size() && end - next < pool.size() && (end == next || used + need(jobs[end]) <= cap)) {
+            used += need(jobs[end]);
+            ++end;
+        }
+        waveEnds.push_back(end);
+        arenaBytes = std::max(arenaBytes, used);
+        next = end;
+    }
+    arena.reserve(arenaBytes);
+
+    std::vector<std::uint8_t*> regions(pool.size());
+    std::vector<Counted<Key>> results(pool.size());
+    std::string kmer(options.k, 'A');
+    std::size_t next = 0;
+    for (std::size_t end : waveEnds) {
+        std::uint8_t* cursor = arena.data();
+        for (std::size_t index = 0; index < end - next; ++index) {
+            regions[index] = cursor;
+            cursor += need(jobs[next + index]);
+        }
+        pool.parallel_for(end - next, [&](std::size_t index) {
+            const Job& job = jobs[next + index];
+            const std::size_t items = static_cast<std::size_t>(job.items);
+            std::uint8_t* memory = regions[index];
+            Key* keys = take<Key>(memory, items);
+            std::uint32_t* counts = take<std::uint32_t>(memory, items);
+            Entry<Key>* entries = job.pairs ? take<Entry<Key>>(memory, items) : nullptr;
+            std::uint8_t* block = take<std::uint8_t>(memory, blockBytes);
+            const int fd = files[job.file];
+            std::size_t filled = 0;
+            if (!job.pairs) {
+                readBlocks(fd, job.bytes, block, blockBytes, [&](const std::uint8_t* data, std::size_t size) {
+                    return decodeRecords<Key>(data, size, options.k, options.canonical, keys, filled, items);
+                });
+                results[index] = {keys, counts, countSorted(keys, filled, counts)};
+                return;
+            }
+            const std::size_t entryBytes = sizeof(Key) + 4;
+            readBlocks(fd, job.bytes, block, blockBytes, [&](const std::uint8_t* data, std::size_t size) {
+                const std::size_t count = std::min(size / entryBytes, items - filled);
+                for (std::size_t i = 0; i < count; ++i, ++filled) {
+                    std::memcpy(&entries[filled].key, data + i * entryBytes, sizeof(Key));
+                    std::memcpy(&entries[filled].count, data + i * entryBytes + sizeof(Key), 4);
+                }
+                return count * entryBytes;
+            });
+            std::sort(entries, entries + filled,
+                      [](const Entry<Key>& a, const Entry<Key>& b) { return a.key < b.key; });
+            std::size_t distinctKeys = 0;
+            for (std::size_t i = 0; i < filled;) {
+                std::uint64_t sum = 0;
+                std::size_t j = i;
+                for (; j < filled && entries[j].key == entries[i].key; ++j) {
+                    sum += entries[j].count;
+                }
+                keys[distinctKeys] = entries[i].key;
+                counts[distinctKeys++] = saturate(sum);
+                i = j;
+            }
+            results[index] = {keys, counts, distinctKeys};
+        });
+
+        for (std::size_t index = 0; index < end - next; ++index) {
+            const Counted<Key>& result = results[index];
+            for (std::size_t i = 0; i < result.size; ++i) {
+                Key code = result.keys[i];
+                for (std::size_t j = kmer.size(); j-- > 0; code >>= 2) {
+                    kmer[j] = decodeBase(static_cast<std::uint8_t>(code & 3));
+                }
+                callback(kmer, result.counts[i]);
+            }
+            distinct += result.size;
+            close(files[jobs[next + index].file]);
+            files[jobs[next + index].file] = -1;
+        }
+        next = end;
+    }
+}
+
+template <typename Key>
+void DiskKmerCounter::splitBucket(std::size_t bucket, std::vector<Job>& jobs, std::uint8_t* memory) {
+    // El cubo se lee por trozos que caben en el límite junto con los búferes
+    // de las partes; cada trozo se ordena y se cuenta, y sus pares (k-mero,
+    // cuenta) van a la parte que marca el hash del k-mero. Así todas las
+    // apariciones de un k-mero acaban en la misma parte, y una parte lleva
+    // como mucho un par por k-mero y trozo aunque el cubo sea un único k-mero
+    // repetido. Todo sale de `memory`, de maxMemoryBytes bytes.
+    const std::size_t cap = options.maxMemoryBytes;
+    const std::size_t entryBytes = sizeof(Key) + 4;
+    const std::uint64_t perItem = sizeof(Entry<Key>) + sizeof(Key) + 4;
+    const std::uint64_t target = (cap - blockBytes) / 2;
+    const std::size_t parts = static_cast<std::size_t>(
+        std::max<std::uint64_t>(2, (bucketKmers[bucket] * perItem + target - 1) / target));
+    // Búfer de cada parte: pares enteros, entre todas un cuarto del límite.
+    const std::size_t partBytes = std::max<std::size_t>(1, cap / 4 / parts / entryBytes) * entryBytes;
+
+    std::uint8_t* cursor = memory;
+    std::uint8_t* block = take<std::uint8_t>(cursor, blockBytes);
+    std::uint8_t* partData = take<std::uint8_t>(cursor, parts * partBytes);
+    const std::size_t used = static_cast<std::size_t>(cursor - memory) + 2 * sizeof(CacheLine);
+    const std::size_t chunkKeys = used < cap ? (cap - used) / (sizeof(Key) + sizeof(std::uint32_t)) : 0;
+    if (chunkKeys < MAX_RECORD_BASES) {
+        throw std::runtime_error("DiskKmerCounter: límite de memoria demasiado pequeño para repartir un cubo");
+    }
+    Key* keys = take<Key>(cursor, chunkKeys);
+    std::uint32_t* counts = take<std::uint32_t>(cursor, chunkKeys);
+
+    const std::size_t firstJob = jobs.size();
+    std::vector<std::size_t> partFill(parts, 0);
+    for (std::size_t part = 0; part < parts; ++part) {
+        files.push_back(createTempFile(directory));
+        jobs.push_back({files.size() - 1, 0, 0, true});
+    }
+    auto flushPart = [&](std::size_t part) {
+        Job& job = jobs[firstJob + part];
+        writeAll(files[job.file], partData + part * partBytes, partFill[part]);
+        job.bytes += partFill[part];
+        partFill[part] = 0;
+    };
+
+    std::size_t filled = 0;
+    auto flushChunk = [&]() {
+        const std::size_t distinctKeys = countSorted(keys, filled, counts);
+        for (std::size_t i = 0; i < distinctKeys; ++i) {
+            const std::size_t part = hashKey(keys[i]) % parts;
+            std::uint8_t* entry = partData + part * partBytes + partFill[part];
+            std::memcpy(entry, &keys[i], sizeof(Key));
+            std::memcpy(entry + sizeof(Key), &counts[i], 4);
+            partFill[part] += entryBytes;
+            ++jobs[firstJob + part].items;
+            if (partFill[part] == partBytes) {
+                flushPart(part);
+            }
+        }
+        filled = 0;
+    };
+
+    readBlocks(files[bucket], bucketBytes[bucket], block, blockBytes, [&](const std::uint8_t* data, std::size_t size) {
+        std::size_t read = decodeRecords<Key>(data, size, options.k, options.canonical, keys, filled, chunkKeys);
+        if (read < size && filled + MAX_RECORD_BASES > chunkKeys) {
+            flushChunk();
+            read += decodeRecords<Key>(data + read, size - read, options.k, options.canonical, keys, filled, chunkKeys);
+        }
+        return read;
+    });
+    flushChunk();
+    for (std::size_t part = 0; part < parts; ++part) {
+        flushPart(part);
+    }
+    close(files[bucket]);
+    files[bucket] = -1;
+}
@@ -0,0 +1,385 @@
+// eulerian_path.cpp
+#include <algorithm>
+#include "eulerian_path.h"
+
+namespace {
+
+struct Component {
+    std::size_t start = CompactGraph::npos;  // Hueco del nodo inicial
+    std::size_t edges = 0;
+    EulerianKind kind = EULERIAN_NONE;
+};
+
+// Recorre la componente débilmente conexa de `seed` (pila explícita) y
+// clasifica sus nodos por la diferencia entre aristas de salida y de entrada.
+Component explore(const CompactGraph& graph, std::size_t seed, std::vector<bool>& visited,
+                  std::vector<std::size_t>& stack) {
+    Component component;
+    std::size_t starts = 0;
+    std::size_t ends = 0;
+    bool balanced = true;
+    std::size_t anyStart = CompactGraph::npos;
+
+    stack.assign(1, seed);
+    visited[seed] = true;
+    while (!stack.empty()) {
+        const std::size_t slot = stack.back();
+        stack.pop_back();
+        const std::uint64_t node = graph.node(slot);
+        const int out = BIT_COUNT[graph.outMask(slot)];
+        const int in = BIT_COUNT[graph.inMask(slot)];
+        component.edges += out;
+        if (out - in == 1) {
+            ++starts;
+            component.start = slot;
+        } else if (in - out == 1) {
+            ++ends;
+        } else if (out != in) {
+            balanced = false;
+        }
+        if (out > 0 && (anyStart == CompactGraph::npos || slot < anyStart)) {
+            anyStart = slot;
+        }
+
+        for (std::uint8_t base = 0; base < 4; ++base) {
+            if (graph.outMask(slot) & (1u << base)) {
+                const std::size_t next = graph.find(graph.successor(node, base));
+                if (!visited[next]) {
+                    visited[next] = true;
+                    stack.push_back(next);
+                }
+            }
+            if (graph.inMask(slot) & (1u << base)) {
+                const std::size_t previous = graph.find(graph.predecessor(node, base));
+                if (!visited[previous]) {
+                    visited[previous] = true;
+                    stack.push_back(previous);
+                }
+            }
+        }
+    }
+
+    if (balanced && starts == 0 && ends == 0) {
+        component.kind = EULERIAN_CIRCUIT;
+        component.start = anyStart;
+    } else if (balanced && starts == 1 && ends == 1) {
+        component.kind = EULERIAN_PATH;
+    } else {
+        component.start = CompactGraph::npos;
+    }
+    return component;
+}
+
+// Hierholzer: se avanza por aristas sin usar apilando nodos; al llegar a un
+// nodo sin salidas libres se desapila al camino. El camino sale al revés.
+// `remaining` son las máscaras de salida aún sin usar. La pila guarda el
+// código de cada nodo junto a su hueco para no volver a leer la tabla al
+// desapilarlo.
+void hierholzer(const CompactGraph& graph, const Component& component, std::vector<std::uint8_t>& remaining,
+                std::vector<std::size_t>& stack, EulerianWalk& walk) {
+    walk.kind = component.kind;
+    walk.nodes.clear();
+    walk.nodes.reserve(component.edges + 1);
+    std::vector<std::uint64_t> stackNodes(1, graph.node(component.start));
+    stack.assign(1, component.start);
+    while (!stack.empty()) {
+        const std::size_t slot = stack.back();
+        if (remaining[slot] != 0) {
+            const std::uint8_t base = LOWEST_BIT[remaining[slot]];
+            remaining[slot] &= static_cast<std::uint8_t>(~(1u << base));
+            const std::uint64_t next = graph.successor(stackNodes.back(), base);
+            // El siguiente paso saldrá de `next` hacia uno de sus cuatro
+            // posibles sucesores: se piden ya sus huecos para que esa búsqueda
+            // no espere a memoria.
+            for (std::uint8_t ahead = 0; ahead < 4; ++ahead) {
+                const std::uint64_t candidate = graph.successor(next, ahead);
+                graph.prefetch(candidate);
+                prefetchAddress(&remaining[graph.homeSlot(candidate)]);
+            }
+            stack.push_back(graph.find(next));
+            stackNodes.push_back(next);
+        } else {
+            walk.nodes.push_back(stackNodes.back());
+            stack.pop_back();
+            stackNodes.pop_back();
+        }
+    }
+    std::reverse(walk.nodes.begin(), walk.nodes.end());
+}
+
+// Grafo de Hierholzer sobre los unitigs: el vértice 2u es el primer nodo del
+// unitig u y 2u + 1 el último (si el unitig es un solo nodo, 2u hace de los
+// dos y 2u + 1 no se usa). Del primer nodo de un unitig de varios nodos sólo
+// sale su cadena interna, hacia 2u + 1 (bit 0 de su máscara); del último
+// salen los enlaces de outMask(), hacia el primer nodo de cada sucesor.
+class UnitigVertices {
+public:
+    explicit UnitigVertices(const UnitigGraph& unitigs) : unitigs(unitigs) {}
+
+    std::size_t count() const { return 2 * unitigs.unitigCount(); }
+    bool exists(std::size_t vertex) const { return vertex % 2 == 0 || unitigs.nodeCount(vertex / 2) > 1; }
+    bool chain(std::size_t vertex) const { return vertex % 2 == 0 && unitigs.nodeCount(vertex / 2) > 1; }
+    std::uint8_t outMask(std::size_t vertex) const {
+        return !exists(vertex) ? 0 : chain(vertex) ? 1 : unitigs.outMask(vertex / 2);
+    }
+    int inDegree(std::size_t vertex) const {
+        return !exists(vertex) ? 0 : vertex % 2 == 1 ? 1 : BIT_COUNT[unitigs.inMask(vertex / 2)];
+    }
+    std::size_t next(std::size_t vertex, std::uint8_t base) const {
+        return chain(vertex) ? vertex + 1 : 2 * unitigs.successor(vertex / 2, base);
+    }
+    // Aristas del CompactGraph que representa la arista que sale de `vertex`.
+    std::size_t nodeEdges(std::size_t vertex) const {
+        return chain(vertex) ? unitigs.nodeCount(vertex / 2) - 1 : 1;
+    }
+
+    // Añade los (k-1)-meros [from, to) del unitig.
+    void appendNodes(std::size_t id, std::size_t from, std::size_t to, std::vector<std::uint64_t>& nodes) const {
+        const int nodeLength = unitigs.kmerLength() - 1;
+        const std::uint64_t mask = kmerMask(nodeLength);
+        std::uint64_t code = 0;
+        for (std::size_t i = from; i < from + nodeLength - 1; ++i) {
+            code = (code << 2) | unitigs.base(id, i);
+        }
+        for (std::size_t i = from; i < to; ++i) {
+            code = ((code << 2) | unitigs.base(id, i + nodeLength - 1)) & mask;
+            nodes.push_back(code);
+        }
+    }
+
+private:
+    const UnitigGraph& unitigs;
+};
+
+// Clasifica un conjunto de vértices por sus grados, como explore().
+Component classifyUnitigVertices(const UnitigVertices& vertices, const std::vector<std::size_t>& members) {
+    Component component;
+    std::size_t starts = 0;
+    std::size_t ends = 0;
+    bool balanced = true;
+    std::size_t anyStart = CompactGraph::npos;
+    for (std::size_t vertex : members) {
+        const int out = BIT_COUNT[vertices.outMask(vertex)];
+        const int in = vertices.inDegree(vertex);
+        component.edges += out;
+        if (out - in == 1) {
+            ++starts;
+            component.start = vertex;
+        } else if (in - out == 1) {
+            ++ends;
+        } else if (out != in) {
+            balanced = false;
+        }
+        if (out > 0 && (anyStart == CompactGraph::npos || vertex < anyStart)) {
+            anyStart = vertex;
+        }
+    }
+    if (balanced && starts == 0 && ends == 0 && anyStart != CompactGraph::npos) {
+        component.kind = EULERIAN_CIRCUIT;
+        component.start = anyStart;
+    } else if (balanced && starts == 1 && ends == 1) {
+        component.kind = EULERIAN_PATH;
+    } else {
+        component.kind = EULERIAN_NONE;
+        component.start = CompactGraph::npos;
+    }
+    return component;
+}
+
+// Hierholzer sobre los vértices de los unitigs y expansión a (k-1)-meros.
+// Devuelve las aristas recorridas.
+std::size_t hierholzerUnitigs(const UnitigVertices& vertices, const Component& component,
+                              std::vector<std::uint8_t>& remaining, std::vector<std::size_t>& stack,
+                              std::vector<std::size_t>& path, EulerianWalk& walk) {
+    path.clear();
+    stack.assign(1, component.start);
+    while (!stack.empty()) {
+        const std::size_t vertex = stack.back();
+        if (remaining[vertex] != 0) {
+            const std::uint8_t base = LOWEST_BIT[remaining[vertex]];
+            remaining[vertex] &= static_cast<std::uint8_t>(~(1u << base));
+            stack.push_back(vertices.next(vertex, base));
+        } else {
+            path.push_back(vertex);
+            stack.pop_back();
+        }
+    }
+    std::reverse(path.begin(), path.end());
+
+    walk.kind = component.kind;
+    walk.nodes.clear();
+    std::size_t edges = 0;
+    for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+        edges += vertices.nodeEdges(path[i]);
+    }
+    walk.nodes.reserve(edges + 1);
+    const std::size_t first = path[0] / 2;
+    const std::size_t position = path[0] % 2 == 0 ? 0 : vertices.nodeEdges(path[0] - 1);
+    vertices.appendNodes(first, position, position + 1, walk.nodes);
+    for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+        if (vertices.chain(path[i])) {
+            vertices.appendNodes(path[i] / 2, 1, vertices.nodeEdges(path[i]) + 1, walk.nodes);
+        } else {
+            vertices.appendNodes(path[i + 1] / 2, 0, 1, walk.nodes);
+        }
+    }
+    return path.size() - 1;
+}
+
+std::vector<std::uint8_t> unitigRemaining(const UnitigVertices& vertices) {
+    std::vector<std::uint8_t> remaining(vertices.count());
+    for (std::size_t vertex = 0; vertex < vertices.count(); ++vertex) {
+        remaining[vertex] = vertices.outMask(vertex);
+    }
+    return remaining;
+}
+
+std::size_t findRoot(std::vector<std::size_t>& parent, std::size_t id) {
+    while (parent[id] != id) {
+        parent[id] = parent[parent[id]];
+        id = parent[id];
+    }
+    return id;
+}
+
+} // namespace
+
+std::vector<EulerianWalk> findEulerianWalks(const CompactGraph& graph) {
+    std::vector<EulerianWalk> walks;
+    std::vector<bool> visited(graph.slotCount(), false);
+    std::vector<std::uint8_t> remaining(graph.slotCount(), 0);
+    for (std::size_t slot = 0; slot < graph.slotCount(); ++slot) {
+        if (graph.occupied(slot)) {
+            remaining[slot] = graph.outMask(slot);
+        }
+    }
+
+    std::vector<std::size_t> stack;
+    for (std::size_t slot = 0; slot < graph.slotCount(); ++slot) {
+        if (!graph.occupied(slot) || visited[slot] || (graph.outMask(slot) | graph.inMask(slot)) == 0) {
+            continue;
+        }
+        const Component component = explore(graph, slot, visited, stack);
+        walks.emplace_back();
+        if (component.kind != EULERIAN_NONE) {
+            hierholzer(graph, component, remaining, stack, walks.back());
+        }
+    }
+    return walks;
+}
+
+EulerianWalk findEulerianPath(const CompactGraph& graph) {
+    // Sin buscar componentes: basta con los grados y con comprobar al final
+    // que el recorrido ha usado todas las aristas.
+    Component component;
+    std::size_t starts = 0;
+    std::size_t ends = 0;
+    std::size_t anyStart = CompactGraph::npos;
+    std::vector<std::uint8_t> remaining(graph.slotCount(), 0);
+    for (std::size_t slot = 0; slot < graph.slotCount(); ++slot) {
+        if (!graph.occupied(slot)) {
+            continue;
+        }
+        remaining[slot] = graph.outMask(slot);
+        const int out = BIT_COUNT[graph.outMask(slot)];
+        const int in = BIT_COUNT[graph.inMask(slot)];
+        component.edges += out;
+        if (out - in == 1) {
+            ++starts;
+            component.start = slot;
+        } else if (in - out == 1) {
+            ++ends;
+        } else if (out != in) {
+            return EulerianWalk();
+        }
+        if (out > 0 && anyStart == CompactGraph::npos) {
+            anyStart = slot;
+        }
+    }
+    if (starts == 0 && ends == 0 && anyStart != CompactGraph::npos) {
+        component.kind = EULERIAN_CIRCUIT;
+        component.start = anyStart;
+    } else if (starts == 1 && ends == 1) {
+        component.kind = EULERIAN_PATH;
+    } else {
+        return EulerianWalk();
+    }
+
+    EulerianWalk walk;
+    std::vector<std::size_t> stack;
+    hierholzer(graph, component, remaining, stack, walk);
+    if (walk.nodes.size() != component.edges + 1) {
+        return EulerianWalk();  // Aristas en más de una componente
+    }
+    return walk;
+}
+
+std::vector<EulerianWalk> findEulerianWalks(const UnitigGraph& unitigs) {
+    // Componentes débilmente conexas uniendo cada unitig con sus sucesores;
+    // se numeran por su unitig más bajo, en el orden de la tabla.
+    const std::size_t count = unitigs.unitigCount();
+    std::vector<std::size_t> parent(count);
+    for (std::size_t id = 0; id < count; ++id) {
+        parent[id] = id;
+    }
+    for (std::size_t id = 0; id < count; ++id) {
+        for (std::uint8_t base = 0; base < 4; ++base) {
+            if (unitigs.outMask(id) & (1u << base)) {
+                const std::size_t a = findRoot(parent, id);
+                const std::size_t b = findRoot(parent, unitigs.successor(id, base));
+                parent[std::max(a, b)] = std::min(a, b);
+            }
+        }
+    }
+    const UnitigVertices vertices(unitigs);
+    std::vector<std::size_t> componentOf(count, UnitigGraph::npos);
+    std::vector<std::vector<std::size_t>> members;
+    for (std::size_t id = 0; id < count; ++id) {
+        if (unitigs.nodeCount(id) == 1 && (unitigs.outMask(id) | unitigs.inMask(id)) == 0) {
+            continue;  // Nodo sin aristas
+        }
+        const std::size_t root = findRoot(parent, id);
+        if (componentOf[root] == UnitigGraph::npos) {
+            componentOf[root] = members.size();
+            members.emplace_back();
+        }
+        members[componentOf[root]].push_back(2 * id);
+        if (vertices.exists(2 * id + 1)) {
+            members[componentOf[root]].push_back(2 * id + 1);
+        }
+    }
+
+    std::vector<EulerianWalk> walks(members.size());
+    std::vector<std::uint8_t> remaining = unitigRemaining(vertices);
+    std::vector<std::size_t> stack;
+    std::vector<std::size_t> path;
+    for (std::size_t c = 0; c < members.size(); ++c) {
+        const Component component = classifyUnitigVertices(vertices, members[c]);
+        if (component.kind != EULERIAN_NONE) {
+            hierholzerUnitigs(vertices, component, remaining, stack, path, walks[c]);
+        }
+    }
+    return walks;
+}
+
+EulerianWalk findEulerianPath(const UnitigGraph& unitigs) {
+    const UnitigVertices vertices(unitigs);
+    std::vector<std::size_t> all;
+    for (std::size_t vertex = 0; vertex < vertices.count(); ++vertex) {
+        if (vertices.exists(vertex)) {
+            all.push_back(vertex);
+        }
+    }
+    const Component component = classifyUnitigVertices(vertices, all);
+    if (component.kind == EULERIAN_NONE) {
+        return EulerianWalk();
+    }
+    EulerianWalk walk;
+    std::vector<std::uint8_t> remaining = unitigRemaining(vertices);
+    std::vector<std::size_t> stack;
+    std::vector<std::size_t> path;
+    if (hierholzerUnitigs(vertices, component, remaining, stack, path, walk) != component.edges) {
+        return EulerianWalk();  // Aristas en más de una componente
+    }
+    return walk;
+}
@@ -4,16 +4,18 @@
 #include <string>
 #include <algorithm>
 #include "graph.h"
+#include "dense_kmer_counter.h"
+#include "kmer_counter.h"
 
 using namespace std;
 
 struct Node;
 
 // Structures used to create the graph
-Edge::Edge(Node* f, Node* t) : from(f), to(t), passed(false) {}
+Edge::Edge(Node* f, Node* t) : from(f), to(t), passed(false), coverage(1) {}
 
 // Implementación de Node
-Node::Node(std::string k) : kmer(std::move(k)) {}
+Node::Node(std::string k) : kmer(std::move(k)), coverage(0) {}
 
 Node::~Node() {
     for (Edge* edge : edges) {
@@ -33,6 +35,8 @@ void addEdge(Node* fromNode, Node* toNode, std::unordered_map<std::string, Node*
     if (it == fromNode->edges.end()) { // Si no se encuentra, añadir nueva arista
         Edge* edge = new Edge(fromNode, toNode);
         fromNode->edges.push_back(edge);
+    } else { // Si ya existe, contar una aparición más
+        (*it)->coverage++;
     }
 }
 
@@ -45,6 +49,7 @@ std::unordered_map<std::string, Node*> buildGraph(const std::vector<std::string>
             if (graph.find(k1mer) == graph.end()) {
                 graph[k1mer] = new Node(k1mer);
             }
+            graph[k1mer]->coverage++;
 
             if (i > 0) {
                 std::string prev_k1mer = read.substr(i - 1, k1);
@@ -69,67 +74,38 @@ void printGraph(const std::unordered_map<std::string, Node*>& graph) {
     }
 }
 
-std::vector<Node*> fleuryAlgorithm(std::unordered_map<std::string, Node*>& graph) {
-    std::vector<Node*> path;
-    // Get the starting node
-    Node* current = graph["AG"];
-
-    while (true) {
-        bool foundEdge = false;
-        Edge* nextEdge = nullptr;
-
-        // Look for an unexplored edge
-        for (Edge* edge : current->edges) {
-            // We wont check if the edge forms a bridge since we are not getting
-            // really complicated reads as inputs 
-            if (!edge->passed) { 
-                nextEdge = edge;
-                foundEdge = true;
-                // Exit the for loop
-                break;
-            }
+void getKmerFrequency(const std::vector<std::string>& reads, std::unordered_map<std::string, Node*>& graph) {
+    // Calcular la longitud del k-mero basado en el primer nodo del grafo
+    // Asumiendo que todos los k-meros tienen la misma longitud
+    const int k = graph.begin()->first.length();
+
+    // Con k pequeño, una tabla de 4^k cuentas indexada por el código.
+    if (k <= DenseKmerCounter::MAX_K) {
+        DenseKmerCounter counter(k, false);
+        for (const std::string& read : reads) {
+            counter.addSequence(read);
         }
+        printKmerFrequencies(counter, std::cout);
+        return;
+    }
 
-        // If we havent found any edge, we've finished
-        if (!foundEdge) {break;}
-
-        // Mark this edge as passed by the algorithm
-        nextEdge->passed = true;
-        // Add the current node
-        path.push_back(current);
-        // Next current node will be the one that the edge points to
-        current = nextEdge->to;
-
+    // Tabla con sitio para todos los k-meros distintos posibles (no más que
+    // los k-meros de las lecturas ni que 4^k), pero como mucho el límite por
+    // defecto de kmerfreq: con lecturas muy redundantes las posiciones
+    // superan con mucho a los k-meros distintos.
+    std::size_t kmers = 0;
+    for (const std::string& read : reads) {
+        kmers += read.length() >= static_cast<size_t>(k) ? read.length() - k + 1 : 0;
     }
-    // Add the last node
-    if (!path.empty() && path.back() != current) {
-        path.push_back(current);
+    if (k < 16) {
+        kmers = std::min(kmers, size_t(1) << (2 * k));
     }
-    return path;
-}
-
-
-void getKmerFrequency(const std::vector<std::string>& reads, std::unordered_map<std::string, Node*>& graph) {
-    std::unordered_map<std::string, int> kmerFrequency;
-
+    const std::size_t slotBytes = sizeof(std::uint64_t) + sizeof(std::uint32_t);
+    KmerCounter counter(k, std::min((kmers * 8 / 3 + 32) * slotBytes, KMER_FREQUENCY_MEMORY), false);
     for (const std::string& read : reads) {
-        // Calcular la longitud del k-mero basado en el primer nodo del grafo
-        // Asumiendo que todos los k-meros tienen la misma longitud
-        int k = graph.begin()->first.length();
-
-        // Iterar sobre cada k-mero en la lectura actual
-        for (int i = 0; i <= read.length() - k; ++i) {
-            std::string kmer = read.substr(i, k);
-
-            // Incrementar la frecuencia del k-mero en el mapa
-            kmerFrequency[kmer]++;
-        }
+        counter.addSequence(read);
     }
 
-    for (const auto& pair : kmerFrequency) {
-        std::cout << "K-mero: " << pair.first << ", Frecuencia: " << pair.second << std::endl;
-    }
+    printKmerFrequencies(counter, std::cout);
+    reportDroppedKmers(counter, std::cerr);
 }
-
-
-
@@ -0,0 +1,215 @@
+// graph_cleaning.cpp
+#include <algorithm>
+#include <vector>
+#include "graph_cleaning.h"
+
+namespace {
+
+// Una arista, por el hueco de su origen y la base que añade.
+struct Step {
+    std::size_t slot;
+    std::uint8_t base;
+};
+
+// Rama de una burbuja: sus aristas son steps[first, first + length).
+struct Branch {
+    std::size_t end;
+    std::size_t first;
+    std::size_t length;
+    std::size_t coverage;  // Suma de las coberturas de sus aristas
+};
+
+std::size_t removePath(CompactGraph& graph, const std::vector<Step>& steps, std::size_t first, std::size_t length) {
+    for (std::size_t i = first; i < first + length; ++i) {
+        graph.removeEdge(steps[i].slot, steps[i].base);
+    }
+    return length;
+}
+
+// Punta que empieza en `slot`, sin entradas: se sigue hacia delante hasta
+// el primer nodo con varias entradas.
+std::size_t clipForward(CompactGraph& graph, std::size_t slot, std::size_t maxLength, std::vector<Step>& path) {
+    path.clear();
+    std::size_t coverage = 0;
+    std::uint64_t node = graph.node(slot);
+    while (path.size() < maxLength) {
+        const std::uint8_t base = LOWEST_BIT[graph.outMask(slot)];
+        path.push_back({slot, base});
+        coverage += graph.edgeCoverage(slot, base);
+        const std::uint64_t nextNode = graph.successor(node, base);
+        const std::size_t next = graph.find(nextNode);
+        if (BIT_COUNT[graph.inMask(next)] >= 2) {
+            // Unión: se compara con la entrada más cubierta de las demás.
+            const std::uint8_t own = static_cast<std::uint8_t>(node >> (2 * (graph.nodeLength() - 1)));
+            std::size_t best = 0;
+            for (std::uint8_t other = 0; other < 4; ++other) {
+                if (other != own && (graph.inMask(next) & (1u << other))) {
+                    const std::size_t previous = graph.find(graph.predecessor(nextNode, other));
+                    best = std::max<std::size_t>(best, graph.edgeCoverage(previous, base));
+                }
+            }
+            return coverage <= best * path.size() ? removePath(graph, path, 0, path.size()) : 0;
+        }
+        if (BIT_COUNT[graph.outMask(next)] != 1) {
+            return 0;  // Cadena suelta o que se bifurca sin unirse a nada
+        }
+        slot = next;
+        node = nextNode;
+    }
+    return 0;
+}
+
+// Punta que acaba en `slot`, sin salidas: se sigue hacia atrás hasta el
+// primer nodo con varias salidas.
+std::size_t clipBackward(CompactGraph& graph, std::size_t slot, std::size_t maxLength, std::vector<Step>& path) {
+    path.clear();
+    std::size_t coverage = 0;
+    std::uint64_t node = graph.node(slot);
+    while (path.size() < maxLength) {
+        const std::uint64_t previousNode = graph.predecessor(node, LOWEST_BIT[graph.inMask(slot)]);
+        const std::size_t previous = graph.find(previousNode);
+        const std::uint8_t base = static_cast<std::uint8_t>(node & 3);
+        path.push_back({previous, base});
+        coverage += graph.edgeCoverage(previous, base);
+        if (BIT_COUNT[graph.outMask(previous)] >= 2) {
+            std::size_t best = 0;
+            for (std::uint8_t other = 0; other < 4; ++other) {
+                if (other != base) {
+                    best = std::max<std::size_t>(best, graph.edgeCoverage(previous, other));
+                }
+            }
+            return coverage <= best * path.size() ? removePath(graph, path, 0, path.size()) : 0;
+        }
+        if (BIT_COUNT[graph.inMask(previous)] != 1) {
+            return 0;
+        }
+        slot = previous;
+        node = previousNode;
+    }
+    return 0;
+}
+
+} // namespace
+
+std::size_t pruneLowCoverage(CompactGraph& graph, std::uint16_t minCoverage) {
+    std::size_t removed = 0;
+    for (std::size_t slot = 0; slot < graph.slotCount(); ++slot) {
+        if (!graph.occupied(slot)) {
+            continue;
+        }
+        for (std::uint8_t base = 0; base < 4; ++base) {
+            if ((graph.outMask(slot) & (1u << base)) && graph.edgeCoverage(slot, base) < minCoverage) {
+                graph.removeEdge(slot, base);
+                ++removed;
+            }
+        }
+    }
+    return removed;
+}
+
+std::size_t clipTips(CompactGraph& graph, std::size_t maxLength) {
+    std::size_t removed = 0;
+    std::vector<Step> path;
+    for (std::size_t slot = 0; slot < graph.slotCount(); ++slot) {
+        if (!graph.occupied(slot)) {
+            continue;
+        }
+        const std::uint8_t in = graph.inMask(slot);
+        const std::uint8_t out = graph.outMask(slot);
+        if (in == 0 && BIT_COUNT[out] == 1) {
+            removed += clipForward(graph, slot, maxLength, path);
+        } else if (out == 0 && BIT_COUNT[in] == 1) {
+            removed += clipBackward(graph, slot, maxLength, path);
+        }
+    }
+    return removed;
+}
+
+std::size_t popBubbles(CompactGraph& graph, std::size_t maxLength) {
+    std::size_t removed = 0;
+    std::vector<Step> steps;
+    std::vector<Branch> branches;
+    for (std::size_t slot = 0; slot < graph.slotCount(); ++slot) {
+        if (!graph.occupied(slot) || BIT_COUNT[graph.outMask(slot)] < 2) {
+            continue;
+        }
+        // Cada rama avanza mientras sus nodos tengan una entrada y una
+        // salida; sólo vale si acaba en un nodo con varias entradas.
+        steps.clear();
+        branches.clear();
+        for (std::uint8_t first = 0; first < 4; ++first) {
+            if (!(graph.outMask(slot) & (1u << first))) {
+                continue;
+            }
+            Branch branch = {CompactGraph::npos, steps.size(), 0, 0};
+            std::size_t current = slot;
+            std::uint64_t node = graph.node(slot);
+            std::uint8_t base = first;
+            while (branch.length < maxLength) {
+                steps.push_back({current, base});
+                ++branch.length;
+                branch.coverage += graph.edgeCoverage(current, base);
+                const std::uint64_t nextNode = graph.successor(node, base);
+                const std::size_t next = graph.find(nextNode);
+                if (BIT_COUNT[graph.inMask(next)] >= 2) {
+                    branch.end = next;
+                    break;
+                }
+                if (BIT_COUNT[graph.outMask(next)] != 1) {
+                    break;
+                }
+                current = next;
+                node = nextNode;
+                base = LOWEST_BIT[graph.outMask(next)];
+            }
+            if (branch.end != CompactGraph::npos) {
+                branches.push_back(branch);
+            }
+        }
+
+        // Entre las ramas que llegan al mismo nodo gana la de mayor
+        // cobertura media (cov_a / len_a > cov_b / len_b sin dividir).
+        for (std::size_t i = 0; i < branches.size(); ++i) {
+            if (branches[i].end == CompactGraph::npos) {
+                continue;
+            }
+            std::size_t best = i;
+            for (std::size_t j = i + 1; j < branches.size(); ++j) {
+                if (branches[j].end == branches[i].end &&
+                    branches[j].coverage * branches[best].length > branches[best].coverage * branches[j].length) {
+                    best = j;
+                }
+            }
+            for (std::size_t j = i; j < branches.size(); ++j) {
+                if (j != best && branches[j].end == branches[i].end) {
+                    removed += removePath(graph, steps, branches[j].first, branches[j].length);
+                    branches[j].end = CompactGraph::npos;
+                }
+            }
+            branches[best].end = CompactGraph::npos;
+        }
+    }
+    return removed;
+}
+
+CleaningStats cleanGraph(CompactGraph& graph, const CleaningOptions& options) {
+    const std::size_t defaultLength = 2 * static_cast<std::size_t>(graph.kmerLength());
+    const std::size_t maxTipLength = options.maxTipLength != 0 ? options.maxTipLength : defaultLength;
+    const std::size_t maxBubbleLength = options.maxBubbleLength != 0 ? options.maxBubbleLength : defaultLength;
+
+    CleaningStats stats;
+    if (options.minCoverage > 1) {
+        stats.prunedEdges = pruneLowCoverage(graph, options.minCoverage);
+    }
+    for (int round = 0; round < options.rounds; ++round) {
+        const std::size_t tips = clipTips(graph, maxTipLength);
+        const std::size_t bubbles = popBubbles(graph, maxBubbleLength);
+        stats.tipEdges += tips;
+        stats.bubbleEdges += bubbles;
+        if (tips == 0 && bubbles == 0) {
+            break;
+        }
+    }
+    stats.droppedNodes = graph.dropIsolatedNodes();
+    return stats;
+}
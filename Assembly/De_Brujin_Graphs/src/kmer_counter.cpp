@@ -0,0 +1,133 @@
+// kmer_counter.cpp
+#include <stdexcept>
+#include "kmer_counter.h"
+
+namespace {
+
+const std::size_t LOOKAHEAD = 8;
+const std::size_t CODES_PER_BATCH = std::size_t(1) << 16;  // Acota `codes` con secuencias de megabases
+
+} // namespace
+
+const std::uint32_t KmerCounter::MAX_COUNT;
+const std::uint64_t KmerCounter::EMPTY;
+
+KmerCounter::KmerCounter(int k, std::size_t maxBytes, bool canonical)
+    : k(k), canonical(canonical) {
+    if (k < 1 || k > 31) {
+        throw std::invalid_argument("KmerCounter: k debe estar entre 1 y 31");
+    }
+    mask = kmerMask(k);  // Con k ya comprobado
+    // La mayor potencia de dos que cabe en maxBytes, con un 25 % de huecos
+    // siempre libres para que el sondeo lineal sea corto.
+    const std::size_t slotBytes = sizeof(std::uint64_t) + sizeof(std::uint32_t);
+    std::size_t capacity = 16;
+    if (maxBytes < capacity * slotBytes) {
+        throw std::invalid_argument("KmerCounter: límite de memoria demasiado pequeño");
+    }
+    // Con k pequeño no hacen falta más huecos que los de los 4^k k-meros.
+    const std::size_t possible = k < 31 ? std::size_t(1) << (2 * k) : ~std::size_t(0);
+    while (capacity * 2 * slotBytes <= maxBytes && capacity / 4 * 3 < possible) {
+        capacity *= 2;
+    }
+    keys.assign(capacity, EMPTY);
+    counts.assign(capacity, 0);
+    maxLoad = capacity / 4 * 3;
+}
+
+void KmerCounter::addSequence(const std::string& sequence) {
+    // Primero los códigos y luego la inserción, que así puede pedir por
+    // adelantado los huecos de los siguientes (como CompactGraph::addRead()).
+    const unsigned reverseShift = 2 * (k - 1);
+    std::uint64_t forward = 0;
+    std::uint64_t reverse = 0;
+    int valid = 0;
+    codes.clear();
+    for (char c : sequence) {
+        const std::uint8_t base = encodeBase(c);
+        if (base > 3) {
+            valid = 0;
+            continue;
+        }
+        forward = ((forward << 2) | base) & mask;
+        reverse = (reverse >> 2) | (std::uint64_t(3 - base) << reverseShift);
+        if (valid < k) {
+            ++valid;
+        }
+        if (valid == k) {
+            codes.push_back(canonical && reverse < forward ? reverse : forward);
+            if (codes.size() == CODES_PER_BATCH) {
+                insertCodes();
+                codes.clear();
+            }
+        }
+    }
+    insertCodes();
+}
+
+void KmerCounter::insertCodes() {
+    const std::size_t slotMask = keys.size() - 1;
+    const std::size_t end = codes.size();
+    for (std::size_t i = 0; i < end; ++i) {
+        if (i + LOOKAHEAD < end) {
+            const std::size_t ahead = hashKmer(codes[i + LOOKAHEAD]) & slotMask;
+            prefetchAddress(&keys[ahead]);
+            prefetchAddress(&counts[ahead]);
+        }
+        const std::uint64_t code = codes[i];
+        std::size_t slot = hashKmer(code) & slotMask;
+        while (keys[slot] != EMPTY && keys[slot] != code) {
+            slot = (slot + 1) & slotMask;
+        }
+        ++total;
+        if (keys[slot] == EMPTY) {
+            if (distinct == maxLoad) {
+                ++dropped;  // Tabla llena: el k-mero nuevo no cabe
+                continue;
+            }
+            keys[slot] = code;
+            ++distinct;
+        }
+        if (counts[slot] < MAX_COUNT) {
+            ++counts[slot];
+        }
+    }
+}
+
+std::uint32_t KmerCounter::count(std::uint64_t kmer) const {
+    if (canonical) {
+        const std::uint64_t reverse = reverseComplement(kmer, k);
+        kmer = reverse < kmer ? reverse : kmer;
+    }
+    const std::size_t slotMask = keys.size() - 1;
+    std::size_t slot = hashKmer(kmer) & slotMask;
+    while (keys[slot] != EMPTY) {
+        if (keys[slot] == kmer) {
+            return counts[slot];
+        }
+        slot = (slot + 1) & slotMask;
+    }
+    return 0;
+}
+
+void printKmerFrequencies(const KmerCounter& counter, std::ostream& out) {
+    std::string kmer(counter.kmerLength(), 'A');
+    for (std::size_t slot = 0; slot < counter.slotCount(); ++slot) {
+        if (!counter.occupied(slot)) {
+            continue;
+        }
+        std::uint64_t code = counter.kmer(slot);
+        for (std::size_t i = kmer.size(); i-- > 0; code >>= 2) {
+            kmer[i] = decodeBase(static_cast<std::uint8_t>(code & 3));
+        }
+        out << "K-mero: " << kmer << ", Frecuencia: " << counter.countAt(slot) << '\n';
+    }
+}
+
+void reportDroppedKmers(const KmerCounter& counter, std::ostream& out) {
+    if (counter.droppedKmers() > 0) {
+        out << "Aviso: la tabla se llenó con " << counter.distinctKmers() << " k-meros distintos; "
+            << counter.droppedKmers() << " apariciones de k-meros nuevos no se han contado. "
+            << "Aumente el límite de memoria." << std::endl;
+    }
+}
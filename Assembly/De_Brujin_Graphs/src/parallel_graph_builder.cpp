@@ -0,0 +1,255 @@
+// parallel_graph_builder.cpp
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "parallel_graph_builder.h"
+
+namespace {
+
+const std::uint64_t EMPTY = ~std::uint64_t(0);  // El mismo marcador que CompactGraph
+const std::size_t READS_PER_TASK = 64;
+const std::size_t SLOTS_PER_TASK = std::size_t(1) << 16;
+
+// Suma uno a la cobertura salvo que ya esté saturada.
+inline void increment(std::atomic<std::uint16_t>& coverage) {
+    std::uint16_t current = coverage.load(std::memory_order_relaxed);
+    while (current < CompactGraph::MAX_COVERAGE &&
+           !coverage.compare_exchange_weak(current, static_cast<std::uint16_t>(current + 1),
+                                           std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+ParallelGraphBuilder::ParallelGraphBuilder(int k, unsigned numThreads, std::size_t batchBases)
+    : k(k), batchBases(std::max<std::size_t>(batchBases, 1)), pool(numThreads) {
+    if (k < 2 || k > 32) {
+        throw std::invalid_argument("ParallelGraphBuilder: k debe estar entre 2 y 32");
+    }
+    nodeMask = kmerMask(k - 1);  // Con k ya comprobado
+    scratch.resize(pool.size());
+    reset();
+}
+
+void ParallelGraphBuilder::reset() {
+    nodes = 0;
+    capacity = 16;
+    keys.reset(new std::atomic<std::uint64_t>[capacity]);
+    masks.reset(new std::atomic<std::uint8_t>[capacity]);
+    edgeCounts.reset(new std::atomic<std::uint16_t>[4 * capacity]);
+    nodeCounts.reset(new std::atomic<std::uint16_t>[capacity]);
+    for (std::size_t slot = 0; slot < capacity; ++slot) {
+        keys[slot].store(EMPTY, std::memory_order_relaxed);
+        masks[slot].store(0, std::memory_order_relaxed);
+        nodeCounts[slot].store(0, std::memory_order_relaxed);
+        for (std::size_t base = 0; base < 4; ++base) {
+            edgeCounts[4 * slot + base].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+std::size_t ParallelGraphBuilder::insert(std::uint64_t node, std::size_t& created) {
+    const std::size_t mask = capacity - 1;
+    std::size_t slot = hashKmer(node) & mask;
+    while (true) {
+        std::uint64_t current = keys[slot].load(std::memory_order_relaxed);
+        if (current == node) {
+            return slot;
+        }
+        if (current == EMPTY) {
+            if (keys[slot].compare_exchange_strong(current, node, std::memory_order_relaxed)) {
+                ++created;
+                return slot;
+            }
+            // Otro hilo ha ocupado el hueco antes, quizá con el mismo nodo.
+            if (current == node) {
+                return slot;
+            }
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+void ParallelGraphBuilder::reserve(std::size_t newNodes) {
+    std::size_t target = capacity;
+    while (target * 3 < (nodes + newNodes) * 4) {
+        target *= 2;
+    }
+    if (target == capacity) {
+        return;
+    }
+
+    std::unique_ptr<std::atomic<std::uint64_t>[]> oldKeys(new std::atomic<std::uint64_t>[target]);
+    std::unique_ptr<std::atomic<std::uint8_t>[]> oldMasks(new std::atomic<std::uint8_t>[target]);
+    std::unique_ptr<std::atomic<std::uint16_t>[]> oldEdgeCounts(new std::atomic<std::uint16_t>[4 * target]);
+    std::unique_ptr<std::atomic<std::uint16_t>[]> oldNodeCounts(new std::atomic<std::uint16_t>[target]);
+    std::swap(keys, oldKeys);
+    std::swap(masks, oldMasks);
+    std::swap(edgeCounts, oldEdgeCounts);
+    std::swap(nodeCounts, oldNodeCounts);
+    const std::size_t oldCapacity = capacity;
+    capacity = target;
+
+    const std::size_t newTasks = (target + SLOTS_PER_TASK - 1) / SLOTS_PER_TASK;
+    pool.parallel_for(newTasks, [&](std::size_t task) {
+        const std::size_t end = std::min(target, (task + 1) * SLOTS_PER_TASK);
+        for (std::size_t slot = task * SLOTS_PER_TASK; slot < end; ++slot) {
+            keys[slot].store(EMPTY, std::memory_order_relaxed);
+            masks[slot].store(0, std::memory_order_relaxed);
+            nodeCounts[slot].store(0, std::memory_order_relaxed);
+            for (std::size_t base = 0; base < 4; ++base) {
+                edgeCounts[4 * slot + base].store(0, std::memory_order_relaxed);
+            }
+        }
+    });
+    const std::size_t oldTasks = (oldCapacity + SLOTS_PER_TASK - 1) / SLOTS_PER_TASK;
+    pool.parallel_for(oldTasks, [&](std::size_t task) {
+        const std::size_t end = std::min(oldCapacity, (task + 1) * SLOTS_PER_TASK);
+        std::size_t created = 0;
+        for (std::size_t slot = task * SLOTS_PER_TASK; slot < end; ++slot) {
+            const std::uint64_t node = oldKeys[slot].load(std::memory_order_relaxed);
+            if (node != EMPTY) {
+                const std::size_t target = insert(node, created);
+                masks[target].store(oldMasks[slot].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                nodeCounts[target].store(oldNodeCounts[slot].load(std::memory_order_relaxed),
+                                         std::memory_order_relaxed);
+                for (std::size_t base = 0; base < 4; ++base) {
+                    edgeCounts[4 * target + base].store(oldEdgeCounts[4 * slot + base].load(std::memory_order_relaxed),
+                                                        std::memory_order_relaxed);
+                }
+            }
+        }
+    });
+}
+
+void ParallelGraphBuilder::insertRead(const std::string& read, std::vector<std::uint64_t>& readNodes,
+                                      std::size_t& created) {
+    // Como CompactGraph::addRead(): primero los nodos de la lectura y luego la
+    // inserción, pidiendo por adelantado los huecos de los siguientes.
+    const int nodeLength = k - 1;
+    const unsigned firstShift = 2 * (k - 2);
+    const std::size_t lookahead = 8;
+    std::uint64_t node = 0;
+    int valid = 0;
+    readNodes.clear();
+    auto insertRun = [&](std::size_t begin) {
+        const std::size_t end = readNodes.size();
+        std::size_t previous = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            if (i + lookahead < end) {
+                const std::size_t ahead = hashKmer(readNodes[i + lookahead]) & (capacity - 1);
+                prefetchAddress(&keys[ahead]);
+                prefetchAddress(&masks[ahead]);
+                prefetchAddress(&edgeCounts[4 * ahead]);
+                prefetchAddress(&nodeCounts[ahead]);
+            }
+            const std::size_t slot = insert(readNodes[i], created);
+            increment(nodeCounts[slot]);
+            if (i > begin) {
+                // Las máscaras sólo se escriben si falta el bit, para no
+                // generar más tráfico entre núcleos que el de las coberturas.
+                const std::uint8_t out = static_cast<std::uint8_t>(1u << (readNodes[i] & 3));
+                const std::uint8_t in = static_cast<std::uint8_t>(0x10u << (readNodes[i - 1] >> firstShift));
+                if ((masks[previous].load(std::memory_order_relaxed) & out) == 0) {
+                    masks[previous].fetch_or(out, std::memory_order_relaxed);
+                }
+                if ((masks[slot].load(std::memory_order_relaxed) & in) == 0) {
+                    masks[slot].fetch_or(in, std::memory_order_relaxed);
+                }
+                increment(edgeCounts[4 * previous + (readNodes[i] & 3)]);
+            }
+            previous = slot;
+        }
+    };
+
+    std::size_t runStart = 0;
+    for (char c : read) {
+        const std::uint8_t base = encodeBase(c);
+        if (base > 3) {
+            insertRun(runStart);
+            runStart = readNodes.size();
+            valid = 0;
+            continue;
+        }
+        node = ((node << 2) | base) & nodeMask;
+        if (valid < nodeLength) {
+            ++valid;
+        }
+        if (valid == nodeLength) {
+            readNodes.push_back(node);
+        }
+    }
+    insertRun(runStart);
+}
+
+void ParallelGraphBuilder::insertBatch(const std::vector<std::string>& reads, std::size_t begin, std::size_t end) {
+    std::size_t positions = 0;
+    for (std::size_t r = begin; r < end; ++r) {
+        positions += reads[r].size() >= static_cast<std::size_t>(k - 1) ? reads[r].size() - (k - 2) : 0;
+    }
+    reserve(positions);
+
+    std::vector<std::size_t> created(pool.size(), 0);
+    const std::size_t tasks = (end - begin + READS_PER_TASK - 1) / READS_PER_TASK;
+    pool.parallel_for_worker(tasks, [&](std::size_t task, unsigned worker) {
+        const std::size_t first = begin + task * READS_PER_TASK;
+        const std::size_t last = std::min(end, first + READS_PER_TASK);
+        for (std::size_t r = first; r < last; ++r) {
+            insertRead(reads[r], scratch[worker], created[worker]);
+        }
+    });
+    for (std::size_t count : created) {
+        nodes += count;
+    }
+}
+
+void ParallelGraphBuilder::addReads(const std::vector<std::string>& reads) {
+    std::size_t begin = 0;
+    while (begin < reads.size()) {
+        std::size_t end = begin;
+        std::size_t bases = 0;
+        while (end < reads.size() && (end == begin || bases + reads[end].size() <= batchBases)) {
+            bases += reads[end].size();
+            ++end;
+        }
+        insertBatch(reads, begin, end);
+        begin = end;
+    }
+}
+
+CompactGraph ParallelGraphBuilder::finish() {
+    CompactGraph graph(k);
+    graph.keys.resize(capacity);
+    graph.masks.resize(capacity);
+    graph.edgeCounts.resize(4 * capacity);
+    graph.nodeCounts.resize(capacity);
+    std::vector<std::size_t> edges(pool.size(), 0);
+    const std::size_t tasks = (capacity + SLOTS_PER_TASK - 1) / SLOTS_PER_TASK;
+    pool.parallel_for_worker(tasks, [&](std::size_t task, unsigned worker) {
+        const std::size_t end = std::min(capacity, (task + 1) * SLOTS_PER_TASK);
+        for (std::size_t slot = task * SLOTS_PER_TASK; slot < end; ++slot) {
+            graph.keys[slot] = keys[slot].load(std::memory_order_relaxed);
+            graph.masks[slot] = masks[slot].load(std::memory_order_relaxed);
+            graph.nodeCounts[slot] = nodeCounts[slot].load(std::memory_order_relaxed);
+            for (unsigned base = 0; base < 4; ++base) {
+                graph.edgeCounts[4 * slot + base] = edgeCounts[4 * slot + base].load(std::memory_order_relaxed);
+            }
+            for (unsigned base = 0; base < 4; ++base) {
+                edges[worker] += (graph.masks[slot] >> base) & 1;
+            }
+        }
+    });
+    graph.nodes = nodes;
+    for (std::size_t count : edges) {
+        graph.edges += count;
+    }
+
+    reset();
+    return graph;
+}
+
+CompactGraph buildCompactGraphParallel(const std::vector<std::string>& reads, int k, unsigned numThreads) {
+    ParallelGraphBuilder builder(k, numThreads);
+    builder.addReads(reads);
+    return builder.finish();
+}
@@ -0,0 +1,290 @@
+// unitig_graph.cpp
+#include <algorithm>
+#include "thread_pool.h"
+#include "unitig_graph.h"
+
+namespace {
+
+const std::size_t SLOTS_PER_TASK = std::size_t(1) << 14;
+const std::size_t UNITIGS_PER_TASK = std::size_t(1) << 12;
+const std::size_t PREFETCH_DISTANCE = 16;
+const std::size_t CHAIN_LANES = 16;
+
+// Unitigs encontrados por una tarea, con sus secuencias empaquetadas desde
+// el bit 0 de `packed` en el mismo formato que el array del UnitigGraph.
+struct ChainBatch {
+    std::vector<std::size_t> firstSlots;
+    std::vector<std::size_t> lastSlots;
+    std::vector<std::size_t> lengths;
+    std::vector<std::uint64_t> packed;
+    std::size_t bases = 0;
+    std::size_t offset = 0;               // Posición de su primera base en el array final
+    std::uint64_t boundary[2] = {0, 0};   // Palabras primera y última, compartidas con las tareas vecinas
+
+    void append(std::uint8_t base) {
+        if (bases % 32 == 0) {
+            packed.push_back(0);
+        }
+        packed.back() |= std::uint64_t(base) << (2 * (bases % 32));
+        ++bases;
+    }
+};
+
+// Un nodo empieza un unitig salvo que tenga una única entrada y esta venga
+// de un nodo con una única salida (entonces es la continuación de su cadena).
+bool startsUnitig(const CompactGraph& graph, std::size_t slot) {
+    const std::uint8_t in = graph.inMask(slot);
+    if (BIT_COUNT[in] != 1) {
+        return true;
+    }
+    const std::size_t previous = graph.find(graph.predecessor(graph.node(slot), LOWEST_BIT[in]));
+    return BIT_COUNT[graph.outMask(previous)] != 1;
+}
+
+// Recorre las cadenas que empiezan en `starts` (en orden de hueco) hasta el
+// primer nodo con varias salidas, o cuyo sucesor tiene varias entradas o es
+// otra vez el primero (un ciclo), y añade los unitigs a `batch` en ese orden.
+// Cada paso de una cadena depende de una búsqueda al azar en la tabla, así
+// que se avanzan CHAIN_LANES cadenas a la vez: cada una pide el hueco de su
+// siguiente nodo y no lo busca hasta la vuelta siguiente, cuando ya está en
+// caché. Cada nodo pertenece a una sola cadena, así que los hilos nunca
+// escriben el mismo byte de `visited`.
+void walkChains(const CompactGraph& graph, const std::vector<std::size_t>& starts, std::vector<std::uint8_t>& visited,
+                ChainBatch& batch) {
+    struct Lane {
+        std::size_t chain = 0;
+        std::size_t slot = 0;
+        std::uint64_t node = 0;
+        std::uint64_t next = 0;  // Sucesor pedido a la caché en la vuelta anterior
+        bool active = false;
+    };
+    std::vector<std::size_t> lastSlots(starts.size());
+    std::vector<std::vector<std::uint8_t>> extensions(starts.size());  // Bases tras el primer nodo
+    Lane lanes[CHAIN_LANES];
+    std::size_t nextChain = 0;
+    std::size_t active = 0;
+
+    // Deja la cadena del carril en su nodo actual y pide su sucesor, o la
+    // termina si el nodo no tiene una única salida.
+    auto request = [&](Lane& lane) {
+        const std::uint8_t out = graph.outMask(lane.slot);
+        if (BIT_COUNT[out] != 1) {
+            lastSlots[lane.chain] = lane.slot;
+            lane.active = false;
+            --active;
+            return;
+        }
+        lane.next = graph.successor(lane.node, LOWEST_BIT[out]);
+        graph.prefetch(lane.next);
+        prefetchAddress(&visited[graph.homeSlot(lane.next)]);
+    };
+
+    while (active > 0 || nextChain < starts.size()) {
+        for (Lane& lane : lanes) {
+            if (!lane.active) {
+                if (nextChain == starts.size()) {
+                    continue;
+                }
+                lane.chain = nextChain++;
+                lane.slot = starts[lane.chain];
+                lane.node = graph.node(lane.slot);
+                lane.active = true;
+                ++active;
+                visited[lane.slot] = 1;
+                request(lane);
+                continue;
+            }
+            const std::size_t nextSlot = graph.find(lane.next);
+            if (BIT_COUNT[graph.inMask(nextSlot)] != 1 || nextSlot == starts[lane.chain]) {
+                lastSlots[lane.chain] = lane.slot;
+                lane.active = false;
+                --active;
+                continue;
+            }
+            extensions[lane.chain].push_back(static_cast<std::uint8_t>(lane.next & 3));
+            visited[nextSlot] = 1;
+            lane.slot = nextSlot;
+            lane.node = lane.next;
+            request(lane);
+        }
+    }
+
+    for (std::size_t chain = 0; chain < starts.size(); ++chain) {
+        const std::uint64_t node = graph.node(starts[chain]);
+        for (int i = graph.nodeLength() - 1; i >= 0; --i) {
+            batch.append(static_cast<std::uint8_t>((node >> (2 * i)) & 3));
+        }
+        for (std::uint8_t base : extensions[chain]) {
+            batch.append(base);
+        }
+        batch.firstSlots.push_back(starts[chain]);
+        batch.lastSlots.push_back(lastSlots[chain]);
+        batch.lengths.push_back(graph.nodeLength() + extensions[chain].size());
+    }
+}
+
+// Copia las bases de la tarea a su posición del array. Las palabras
+// interiores sólo las escribe esta tarea; la primera y la última pueden
+// compartirse con las vecinas y se guardan aparte para combinarlas después.
+void copyToArena(ChainBatch& batch, std::vector<std::uint64_t>& arena) {
+    if (batch.bases == 0) {
+        return;
+    }
+    const std::size_t firstWord = batch.offset / 32;
+    const std::size_t lastWord = (batch.offset + batch.bases - 1) / 32;
+    const unsigned shift = 2 * (batch.offset % 32);
+    auto put = [&](std::size_t word, std::uint64_t bits) {
+        if (word == firstWord) {
+            batch.boundary[0] |= bits;
+        } else if (word == lastWord) {
+            batch.boundary[1] |= bits;
+        } else if (word < lastWord) {
+            arena[word] |= bits;
+        }
+    };
+    for (std::size_t j = 0; j < batch.packed.size(); ++j) {
+        put(firstWord + j, batch.packed[j] << shift);
+        if (shift != 0) {
+            put(firstWord + j + 1, batch.packed[j] >> (64 - shift));
+        }
+    }
+}
+
+} // namespace
+
+const std::size_t UnitigGraph::npos;
+
+std::size_t UnitigGraph::memoryBytes() const {
+    return arena.capacity() * sizeof(std::uint64_t) + offsets.capacity() * sizeof(std::size_t) + masks.capacity() +
+           successors.capacity() * sizeof(std::size_t);
+}
+
+std::string UnitigGraph::sequence(std::size_t id) const {
+    std::string result(length(id), 'A');
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        result[i] = decodeBase(base(id, i));
+    }
+    return result;
+}
+
+bool UnitigGraph::circular(std::size_t id) const {
+    return BIT_COUNT[outMask(id)] == 1 && BIT_COUNT[inMask(id)] == 1 && successor(id, LOWEST_BIT[outMask(id)]) == id;
+}
+
+UnitigGraph buildUnitigGraph(const CompactGraph& graph, unsigned numThreads) {
+    ThreadPool pool(numThreads);
+    const std::size_t slots = graph.slotCount();
+    std::vector<std::uint8_t> visited(slots, 0);
+
+    // 1. Cada tarea busca los principios de unitig en su tramo de la tabla y
+    //    recorre sus cadenas (que pueden salirse del tramo).
+    const std::size_t tasks = (slots + SLOTS_PER_TASK - 1) / SLOTS_PER_TASK;
+    std::vector<ChainBatch> batches(tasks + 1);
+    pool.parallel_for(tasks, [&](std::size_t task) {
+        const std::size_t end = std::min(slots, (task + 1) * SLOTS_PER_TASK);
+        std::vector<std::size_t> starts;
+        for (std::size_t slot = task * SLOTS_PER_TASK; slot < end; ++slot) {
+            // El recorrido de la tabla es secuencial, pero cada comprobación
+            // busca al predecesor en un hueco al azar: se pide con antelación.
+            const std::size_t ahead = slot + PREFETCH_DISTANCE;
+            if (ahead < end && graph.occupied(ahead) && BIT_COUNT[graph.inMask(ahead)] == 1) {
+                graph.prefetch(graph.predecessor(graph.node(ahead), LOWEST_BIT[graph.inMask(ahead)]));
+            }
+            if (graph.occupied(slot) && startsUnitig(graph, slot)) {
+                starts.push_back(slot);
+            }
+        }
+        walkChains(graph, starts, visited, batches[task]);
+    });
+
+    // 2. Los nodos que quedan forman ciclos aislados sin principio: se
+    //    recorren aquí, en la última tanda, desde su primer hueco.
+    for (std::size_t slot = 0; slot < slots; ++slot) {
+        if (graph.occupied(slot) && !visited[slot]) {
+            walkChains(graph, std::vector<std::size_t>(1, slot), visited, batches[tasks]);
+        }
+    }
+    visited = std::vector<std::uint8_t>();
+
+    UnitigGraph unitigs;
+    unitigs.k = graph.kmerLength();
+    std::size_t count = 0;
+    std::size_t bases = 0;
+    for (ChainBatch& batch : batches) {
+        batch.offset = bases;
+        bases += batch.bases;
+        count += batch.lengths.size();
+    }
+    std::vector<std::size_t> firstSlots;
+    std::vector<std::size_t> lastSlots;
+    firstSlots.reserve(count);
+    lastSlots.reserve(count);
+    unitigs.offsets.reserve(count + 1);
+    for (const ChainBatch& batch : batches) {
+        firstSlots.insert(firstSlots.end(), batch.firstSlots.begin(), batch.firstSlots.end());
+        lastSlots.insert(lastSlots.end(), batch.lastSlots.begin(), batch.lastSlots.end());
+        for (std::size_t length : batch.lengths) {
+            unitigs.offsets.push_back(unitigs.offsets.back() + length);
+        }
+    }
+
+    // 3. Secuencias al array común, en paralelo por tandas.
+    unitigs.arena.assign((bases + 31) / 32, 0);
+    pool.parallel_for(batches.size(), [&](std::size_t task) {
+        copyToArena(batches[task], unitigs.arena);
+        std::vector<std::uint64_t>().swap(batches[task].packed);
+    });
+    for (const ChainBatch& batch : batches) {
+        if (batch.bases != 0) {
+            unitigs.arena[batch.offset / 32] |= batch.boundary[0];
+            unitigs.arena[(batch.offset + batch.bases - 1) / 32] |= batch.boundary[1];
+        }
+    }
+
+    // 4. Aristas entre unitigs: el sucesor del último nodo es siempre el
+    //    primero de un unitig lineal (ordenados por hueco, así que basta una
+    //    búsqueda binaria) o, en un ciclo aislado, el propio unitig.
+    const std::size_t linear = count - batches[tasks].lengths.size();
+    unitigs.masks.assign(count, 0);
+    unitigs.successors.assign(4 * count, UnitigGraph::npos);
+    const std::size_t linkTasks = (count + UNITIGS_PER_TASK - 1) / UNITIGS_PER_TASK;
+    pool.parallel_for(linkTasks, [&](std::size_t task) {
+        const std::size_t end = std::min(count, (task + 1) * UNITIGS_PER_TASK);
+        for (std::size_t id = task * UNITIGS_PER_TASK; id < end; ++id) {
+            const std::uint8_t out = graph.outMask(lastSlots[id]);
+            unitigs.masks[id] = static_cast<std::uint8_t>(out | (graph.inMask(firstSlots[id]) << 4));
+            for (std::uint8_t base = 0; base < 4; ++base) {
+                if ((out & (1u << base)) == 0) {
+                    continue;
+                }
+                if (id >= linear) {
+                    unitigs.successors[4 * id + base] = id;
+                    continue;
+                }
+                const std::size_t next = graph.find(graph.successor(graph.node(lastSlots[id]), base));
+                unitigs.successors[4 * id + base] =
+                    std::lower_bound(firstSlots.begin(), firstSlots.begin() + linear, next) - firstSlots.begin();
+            }
+        }
+    });
+    return unitigs;
+}
+
+void writeContigsFasta(const UnitigGraph& unitigs, std::ostream& out, std::size_t minLength, std::size_t lineWidth) {
+    lineWidth = std::max<std::size_t>(lineWidth, 1);
+    std::string line;
+    for (std::size_t id = 0; id < unitigs.unitigCount(); ++id) {
+        const std::size_t length = unitigs.length(id);
+        if (length < minLength) {
+            continue;
+        }
+        out << ">contig_" << id << " length=" << length << '\n';
+        for (std::size_t start = 0; start < length; start += lineWidth) {
+            line.resize(std::min(lineWidth, length - start));
+            for (std::size_t i = 0; i < line.size(); ++i) {
+                line[i] = decodeBase(unitigs.base(id, start + i));
+            }
+            out << line << '\n';
+        }
+    }
+}
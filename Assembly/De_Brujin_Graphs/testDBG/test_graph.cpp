@@ -0,0 +1,804 @@
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "compact_graph.h"
+#include "dense_kmer_counter.h"
+#include "disk_kmer_counter.h"
+#include "eulerian_path.h"
+#include "graph.h"
+#include "graph_cleaning.h"
+#include "kmer_counter.h"
+#include "parallel_graph_builder.h"
+#include "unitig_graph.h"
+
+namespace {
+
+std::string random_read(size_t length, std::mt19937& rng) {
+    static const char bases[] = "ACGT";
+    std::string read(length, 'A');
+    for (char& c : read) {
+        c = bases[rng() % 4];
+    }
+    return read;
+}
+
+// Aristas del grafo compacto como parejas de cadenas.
+std::set<std::pair<std::string, std::string>> compact_edges(const CompactGraph& graph) {
+    std::set<std::pair<std::string, std::string>> edges;
+    for (size_t slot = 0; slot < graph.slotCount(); ++slot) {
+        if (!graph.occupied(slot)) {
+            continue;
+        }
+        for (uint8_t base = 0; base < 4; ++base) {
+            if (graph.outMask(slot) & (1u << base)) {
+                edges.emplace(graph.nodeString(slot),
+                              decodeKmer(graph.successor(graph.node(slot), base), graph.nodeLength()));
+            }
+        }
+    }
+    return edges;
+}
+
+char bases_lower(char c) {
+    return static_cast<char>(c - 'A' + 'a');
+}
+
+} // namespace
+
+// Mismos nodos y aristas que buildGraph() con lecturas aleatorias de un
+// genoma pequeño (muchos k-meros repetidos) y varios k.
+bool test_matches_build_graph() {
+    std::mt19937 rng(5);
+    bool ok = true;
+    for (int k : {2, 3, 5, 12, 32}) {
+        const std::string genome = random_read(400, rng);
+        std::vector<std::string> reads;
+        for (int r = 0; r < 200; ++r) {
+            const size_t length = k + rng() % 40;
+            const size_t start = rng() % (genome.size() - length);
+            reads.push_back(genome.substr(start, length));
+        }
+
+        std::unordered_map<std::string, Node*> legacy = buildGraph(reads, k);
+        std::set<std::string> legacy_nodes;
+        std::set<std::pair<std::string, std::string>> legacy_edges;
+        for (const auto& entry : legacy) {
+            legacy_nodes.insert(entry.first);
+            for (const Edge* edge : entry.second->edges) {
+                legacy_edges.emplace(entry.first, edge->to->kmer);
+            }
+        }
+        for (auto& entry : legacy) {
+            delete entry.second;
+        }
+
+        CompactGraph graph = buildCompactGraph(reads, k);
+        std::set<std::string> nodes;
+        for (size_t slot = 0; slot < graph.slotCount(); ++slot) {
+            if (graph.occupied(slot)) {
+                nodes.insert(graph.nodeString(slot));
+            }
+        }
+        std::set<std::pair<std::string, std::string>> edges = compact_edges(graph);
+        ok = ok && nodes == legacy_nodes && edges == legacy_edges && graph.nodeCount() == nodes.size() &&
+             graph.edgeCount() == edges.size();
+
+        // Las máscaras de entrada son el reflejo de las de salida.
+        for (size_t slot = 0; slot < graph.slotCount(); ++slot) {
+            if (!graph.occupied(slot)) {
+                continue;
+            }
+            for (uint8_t base = 0; base < 4; ++base) {
+                const bool has_in = graph.inMask(slot) & (1u << base);
+                const size_t from = graph.find(graph.predecessor(graph.node(slot), base));
+                const uint8_t last = static_cast<uint8_t>(graph.node(slot) & 3);
+                ok = ok && has_in == (from != CompactGraph::npos && (graph.outMask(from) & (1u << last)));
+            }
+        }
+    }
+    std::cout << "Grafo compacto vs buildGraph: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Los símbolos que no son ACGT cortan la lectura y las minúsculas cuentan
+// como mayúsculas.
+bool test_ambiguous_bases() {
+    CompactGraph graph = buildCompactGraph({"acgTNNAGG", "TTNA"}, 3);
+    std::set<std::pair<std::string, std::string>> expected = {{"AC", "CG"}, {"CG", "GT"}, {"AG", "GG"}};
+    bool ok = compact_edges(graph) == expected && graph.nodeCount() == 6 && graph.find(0) == CompactGraph::npos &&
+              graph.find(encodeBase('T') * 4 + encodeBase('T')) != CompactGraph::npos;
+    std::cout << "Bases ambiguas: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// La tabla crece sin perder nodos ni aristas y ocupa unos pocos bytes por
+// nodo. Un k fuera de [2, 32] se rechaza.
+bool test_growth() {
+    std::mt19937 rng(9);
+    const std::string genome = random_read(200000, rng);
+    CompactGraph graph(25);
+    graph.addRead(genome);
+    CompactGraph reserved(25, genome.size());
+    reserved.addRead(genome);
+    bool ok = graph.nodeCount() == genome.size() - 23 && graph.edgeCount() == genome.size() - 24 &&
+              compact_edges(graph) == compact_edges(reserved) && graph.memoryBytes() <= 64 * graph.nodeCount();
+    for (int k : {-1, 0, 1, 33}) {
+        bool rejected = false;
+        try {
+            CompactGraph invalid(k);
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        ok = ok && rejected;
+    }
+    std::cout << "Crecimiento de la tabla: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// El constructor paralelo da el mismo grafo que el secuencial con cualquier
+// número de hilos y de lotes, también con lecturas cortas y bases ambiguas.
+// Un k fuera de [2, 32] se rechaza.
+bool test_parallel_builder() {
+    std::mt19937 rng(17);
+    const std::string genome = random_read(30000, rng);
+    std::vector<std::string> reads;
+    for (int r = 0; r < 3000; ++r) {
+        const size_t length = 5 + rng() % 120;
+        std::string read = genome.substr(rng() % (genome.size() - length), length);
+        for (char& c : read) {
+            const unsigned event = rng() % 500;
+            c = event == 0 ? 'N' : event == 1 ? bases_lower(c) : event < 5 ? "ACGT"[rng() % 4] : c;
+        }
+        reads.push_back(read);
+    }
+
+    bool ok = true;
+    for (int k : {3, 21, 32}) {
+        CompactGraph serial = buildCompactGraph(reads, k);
+        for (unsigned threads : {1u, 4u}) {
+            for (size_t batch : {size_t(500), size_t(1) << 22}) {
+                ParallelGraphBuilder builder(k, threads, batch);
+                // En dos llamadas, como al leer un fichero por partes.
+                builder.addReads(std::vector<std::string>(reads.begin(), reads.begin() + 1000));
+                builder.addReads(std::vector<std::string>(reads.begin() + 1000, reads.end()));
+                CompactGraph parallel = builder.finish();
+                bool same = parallel.nodeCount() == serial.nodeCount() && parallel.edgeCount() == serial.edgeCount();
+                for (size_t slot = 0; slot < serial.slotCount() && same; ++slot) {
+                    if (serial.occupied(slot)) {
+                        const size_t found = parallel.find(serial.node(slot));
+                        same = found != CompactGraph::npos && parallel.outMask(found) == serial.outMask(slot) &&
+                               parallel.inMask(found) == serial.inMask(slot) &&
+                               parallel.nodeCoverage(found) == serial.nodeCoverage(slot);
+                        for (uint8_t base = 0; base < 4 && same; ++base) {
+                            same = parallel.edgeCoverage(found, base) == serial.edgeCoverage(slot, base);
+                        }
+                    }
+                }
+                ok = ok && same;
+            }
+        }
+    }
+    for (int k : {0, 1, 33}) {
+        bool rejected = false;
+        try {
+            ParallelGraphBuilder invalid(k, 2);
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        ok = ok && rejected;
+    }
+    std::cout << "Construcción en paralelo: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Comprueba que un recorrido pasa exactamente una vez por cada arista del
+// grafo (o de `edges` aristas de él) siguiendo aristas existentes.
+bool valid_walk(const CompactGraph& graph, const EulerianWalk& walk, size_t edges) {
+    if (walk.nodes.size() != edges + 1) {
+        return false;
+    }
+    std::set<std::pair<uint64_t, uint64_t>> used;
+    for (size_t i = 0; i + 1 < walk.nodes.size(); ++i) {
+        const size_t slot = graph.find(walk.nodes[i]);
+        const uint8_t base = static_cast<uint8_t>(walk.nodes[i + 1] & 3);
+        if (slot == CompactGraph::npos || graph.successor(walk.nodes[i], base) != walk.nodes[i + 1] ||
+            !(graph.outMask(slot) & (1u << base)) || !used.emplace(walk.nodes[i], walk.nodes[i + 1]).second) {
+            return false;
+        }
+    }
+    return walk.kind != EULERIAN_CIRCUIT || walk.nodes.front() == walk.nodes.back();
+}
+
+// Hierholzer con los ejemplos de main.cpp, un genoma largo (un camino de
+// millones de aristas sin recursión), grafos sin camino y varias componentes.
+bool test_eulerian_path() {
+    bool ok = true;
+
+    CompactGraph cycle = buildCompactGraph({"AGT", "GTA", "TAG", "AGT"}, 3);
+    EulerianWalk circuit = findEulerianPath(cycle);
+    ok = ok && circuit.kind == EULERIAN_CIRCUIT && valid_walk(cycle, circuit, 3);
+
+    // AG -> GT -> TC -> CA -> AT: camino, no circuito, y empieza en AG.
+    CompactGraph chain = buildCompactGraph({"AGT", "GTC", "TCA", "CAT"}, 3);
+    EulerianWalk path = findEulerianPath(chain);
+    ok = ok && path.kind == EULERIAN_PATH && valid_walk(chain, path, 4) &&
+         decodeKmer(path.nodes.front(), 2) == "AG" && decodeKmer(path.nodes.back(), 2) == "AT";
+
+    // AC y CT tienen una salida de más cada uno: sin camino euleriano.
+    CompactGraph extras = buildCompactGraph({"AGT", "GTA", "TAC", "ACT", "CTG", "TGA", "ACG", "GAG", "CTT"}, 3);
+    ok = ok && findEulerianPath(extras).kind == EULERIAN_NONE;
+
+    // Un genoma aleatorio sin (k-1)-meros repetidos es su propio camino.
+    std::mt19937 rng(29);
+    const std::string genome = random_read(2000000, rng);
+    CompactGraph linear = buildCompactGraph({genome}, 31);
+    EulerianWalk genome_path = findEulerianPath(linear);
+    std::string spelled = decodeKmer(genome_path.nodes.front(), 30);
+    for (size_t i = 1; i < genome_path.nodes.size(); ++i) {
+        spelled += decodeBase(static_cast<uint8_t>(genome_path.nodes[i] & 3));
+    }
+    ok = ok && genome_path.kind == EULERIAN_PATH && spelled == genome;
+
+    // Dos componentes: ningún camino único, pero uno por componente.
+    CompactGraph components = buildCompactGraph({"AAACCC", "GGGTTTGGG"}, 4);
+    std::vector<EulerianWalk> walks = findEulerianWalks(components);
+    ok = ok && findEulerianPath(components).kind == EULERIAN_NONE && walks.size() == 2;
+    size_t total_edges = 0;
+    for (const EulerianWalk& walk : walks) {
+        ok = ok && walk.kind != EULERIAN_NONE && valid_walk(components, walk, walk.nodes.size() - 1);
+        total_edges += walk.nodes.size() - 1;
+    }
+    ok = ok && total_edges == components.edgeCount();
+
+    // Grafo de De Bruijn completo de orden 5: circuito por sus 4^6 aristas.
+    CompactGraph complete(7);
+    for (uint64_t node = 0; node < (uint64_t(1) << 12); ++node) {
+        for (uint8_t base = 0; base < 4; ++base) {
+            complete.addEdge(node, base);
+        }
+    }
+    EulerianWalk complete_circuit = findEulerianPath(complete);
+    ok = ok && complete_circuit.kind == EULERIAN_CIRCUIT && valid_walk(complete, complete_circuit, 4096 * 4);
+
+    std::cout << "Camino euleriano (Hierholzer): " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Comprueba un grafo de unitigs contra el grafo del que sale: cada nodo en
+// un solo unitig, las aristas internas más las de salida son todas las del
+// grafo y cada sucesor empieza por la continuación del unitig.
+bool valid_unitigs(const CompactGraph& graph, const UnitigGraph& unitigs) {
+    const int node_length = graph.nodeLength();
+    std::set<std::string> nodes;
+    size_t edges = 0;
+    for (size_t id = 0; id < unitigs.unitigCount(); ++id) {
+        const std::string sequence = unitigs.sequence(id);
+        for (size_t i = 0; i + node_length <= sequence.size(); ++i) {
+            if (!nodes.insert(sequence.substr(i, node_length)).second) {
+                return false;
+            }
+        }
+        edges += unitigs.nodeCount(id) - 1;
+        for (uint8_t base = 0; base < 4; ++base) {
+            if (!(unitigs.outMask(id) & (1u << base))) {
+                continue;
+            }
+            ++edges;
+            const std::string next = sequence.substr(sequence.size() - node_length + 1) + decodeBase(base);
+            if (unitigs.sequence(unitigs.successor(id, base)).compare(0, node_length, next) != 0) {
+                return false;
+            }
+        }
+    }
+    std::set<std::string> expected;
+    for (size_t slot = 0; slot < graph.slotCount(); ++slot) {
+        if (graph.occupied(slot)) {
+            expected.insert(graph.nodeString(slot));
+        }
+    }
+    return nodes == expected && edges == graph.edgeCount();
+}
+
+// Compactación en unitigs: ejemplos pequeños, un genoma sin repeticiones (un
+// único unitig), lecturas con errores con 1 y 4 hilos y la salida FASTA.
+bool test_unitigs() {
+    bool ok = true;
+
+    // AG -> GT se bifurca en TC y TT: tres unitigs, AGT con dos sucesores.
+    CompactGraph fork = buildCompactGraph({"AGTC", "AGTT"}, 3);
+    UnitigGraph fork_unitigs = buildUnitigGraph(fork, 1);
+    std::set<std::string> fork_sequences;
+    for (size_t id = 0; id < fork_unitigs.unitigCount(); ++id) {
+        fork_sequences.insert(fork_unitigs.sequence(id));
+        if (fork_unitigs.sequence(id) == "AGT") {
+            ok = ok && fork_unitigs.outMask(id) == 0xA && fork_unitigs.inMask(id) == 0 &&
+                 fork_unitigs.sequence(fork_unitigs.successor(id, 3)) == "TT";
+        }
+    }
+    ok = ok && fork_sequences == std::set<std::string>{"AGT", "TC", "TT"} && valid_unitigs(fork, fork_unitigs);
+
+    // Un ciclo aislado no tiene principio: un unitig circular.
+    CompactGraph cycle = buildCompactGraph({"AGT", "GTA", "TAG", "AGT"}, 3);
+    UnitigGraph cycle_unitigs = buildUnitigGraph(cycle, 2);
+    ok = ok && cycle_unitigs.unitigCount() == 1 && cycle_unitigs.length(0) == 4 && cycle_unitigs.circular(0) &&
+         valid_unitigs(cycle, cycle_unitigs);
+
+    std::mt19937 rng(31);
+    const std::string genome = random_read(100000, rng);
+    UnitigGraph single = buildUnitigGraph(buildCompactGraph({genome}, 31), 4);
+    ok = ok && single.unitigCount() == 1 && single.sequence(0) == genome && !single.circular(0);
+
+    // Un genoma con un tramo repetido y lecturas con errores: muchas
+    // bifurcaciones, varias tareas (y palabras del array compartidas entre
+    // ellas) y el mismo resultado con cualquier número de hilos.
+    const std::string repeat = random_read(60, rng);
+    const std::string repetitive =
+        random_read(20000, rng) + repeat + random_read(20000, rng) + repeat + random_read(20000, rng);
+    std::vector<std::string> reads;
+    for (int r = 0; r < 5000; ++r) {
+        std::string read = repetitive.substr(rng() % (repetitive.size() - 100), 100);
+        if (rng() % 4 == 0) {
+            read[rng() % read.size()] = "ACGT"[rng() % 4];
+        }
+        reads.push_back(read);
+    }
+    for (int k : {4, 11, 21}) {
+        CompactGraph graph = buildCompactGraph(reads, k);
+        UnitigGraph serial = buildUnitigGraph(graph, 1);
+        UnitigGraph parallel = buildUnitigGraph(graph, 4);
+        bool same = serial.unitigCount() == parallel.unitigCount() && serial.totalBases() == parallel.totalBases();
+        for (size_t id = 0; id < serial.unitigCount() && same; ++id) {
+            same = serial.sequence(id) == parallel.sequence(id) && serial.outMask(id) == parallel.outMask(id);
+            for (uint8_t base = 0; base < 4 && same; ++base) {
+                same = serial.successor(id, base) == parallel.successor(id, base);
+            }
+        }
+        ok = ok && same && valid_unitigs(graph, serial) && (k < 11 || serial.unitigCount() * 4 < graph.nodeCount());
+    }
+
+    std::ostringstream fasta;
+    writeContigsFasta(fork_unitigs, fasta, 3, 2);
+    size_t agt = 0;
+    while (fork_unitigs.sequence(agt) != "AGT") {
+        ++agt;
+    }
+    ok = ok && fasta.str() == ">contig_" + std::to_string(agt) + " length=3\nAG\nT\n";
+
+    std::cout << "Unitigs: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Hierholzer sobre el grafo de unitigs: el mismo tipo de recorrido que
+// sobre el CompactGraph y, expandido a (k-1)-meros, un recorrido válido de
+// este, con los ejemplos de main.cpp, un genoma lineal, dos componentes, un
+// grafo de De Bruijn completo y grafos aleatorios con muchas repeticiones.
+bool test_unitig_eulerian() {
+    std::vector<std::pair<CompactGraph, std::string>> graphs;
+    graphs.emplace_back(buildCompactGraph({"AGT", "GTA", "TAG", "AGT"}, 3), "ciclo");
+    graphs.emplace_back(buildCompactGraph({"AGT", "GTC", "TCA", "CAT"}, 3), "cadena");
+    graphs.emplace_back(buildCompactGraph({"AGT", "GTA", "TAC", "ACT", "CTG", "TGA", "ACG", "GAG", "CTT"}, 3), "extras");
+    graphs.emplace_back(buildCompactGraph({"ATGCTAGCAC"}, 3), "laboratorio");
+    graphs.emplace_back(buildCompactGraph({"AAACCC", "GGGTTTGGG"}, 4), "componentes");
+    std::mt19937 rng(53);
+    graphs.emplace_back(buildCompactGraph({random_read(200000, rng)}, 31), "genoma");
+    CompactGraph complete(5);
+    for (uint64_t node = 0; node < (uint64_t(1) << 8); ++node) {
+        for (uint8_t base = 0; base < 4; ++base) {
+            complete.addEdge(node, base);
+        }
+    }
+    graphs.emplace_back(complete, "completo");
+    for (int r = 0; r < 40; ++r) {
+        graphs.emplace_back(buildCompactGraph({random_read(20 + rng() % 60, rng)}, 4 + r % 3), "aleatorio");
+    }
+
+    bool ok = true;
+    for (const auto& entry : graphs) {
+        const CompactGraph& graph = entry.first;
+        const UnitigGraph unitigs = buildUnitigGraph(graph, 2);
+        const EulerianWalk nodes = findEulerianPath(graph);
+        const EulerianWalk compacted = findEulerianPath(unitigs);
+        bool same = compacted.kind == nodes.kind &&
+                    (compacted.kind == EULERIAN_NONE || valid_walk(graph, compacted, graph.edgeCount()));
+
+        const std::vector<EulerianWalk> node_walks = findEulerianWalks(graph);
+        const std::vector<EulerianWalk> unitig_walks = findEulerianWalks(unitigs);
+        same = same && unitig_walks.size() == node_walks.size();
+        for (size_t w = 0; same && w < unitig_walks.size(); ++w) {
+            same = unitig_walks[w].kind == node_walks[w].kind &&
+                   unitig_walks[w].nodes.size() == node_walks[w].nodes.size() &&
+                   (unitig_walks[w].kind == EULERIAN_NONE ||
+                    valid_walk(graph, unitig_walks[w], unitig_walks[w].nodes.size() - 1));
+        }
+        if (!same) {
+            std::cout << "  recorrido sobre unitigs distinto en el grafo " << entry.second << std::endl;
+        }
+        ok = ok && same;
+    }
+
+    std::cout << "Camino euleriano sobre unitigs: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Coberturas de nodos y aristas en los dos grafos: buildGraph() ya no pierde
+// las repeticiones de una arista al deduplicarla.
+bool test_coverage() {
+    const std::vector<std::string> reads = {"AGTC", "AGTC", "AGTT", "GTC"};
+    std::unordered_map<std::string, Node*> legacy = buildGraph(reads, 3);
+    int ag_gt = 0;
+    int gt_tc = 0;
+    for (const Edge* edge : legacy["AG"]->edges) {
+        ag_gt += edge->to->kmer == "GT" ? edge->coverage : 0;
+    }
+    for (const Edge* edge : legacy["GT"]->edges) {
+        gt_tc += edge->to->kmer == "TC" ? edge->coverage : 0;
+    }
+    bool ok = ag_gt == 3 && gt_tc == 3 && legacy["GT"]->edges.size() == 2 && legacy["GT"]->coverage == 4 &&
+              legacy["TT"]->coverage == 1;
+    for (auto& entry : legacy) {
+        delete entry.second;
+    }
+
+    CompactGraph graph = buildCompactGraph(reads, 3);
+    const size_t gt = graph.find(encodeBase('G') << 2 | encodeBase('T'));
+    const size_t ag = graph.find(encodeBase('A') << 2 | encodeBase('G'));
+    ok = ok && graph.edgeCoverage(ag, encodeBase('T')) == 3 && graph.edgeCoverage(gt, encodeBase('C')) == 3 &&
+         graph.edgeCoverage(gt, encodeBase('T')) == 1 && graph.edgeCoverage(gt, encodeBase('A')) == 0 &&
+         graph.nodeCoverage(gt) == 4 && graph.edgeCount() == 3;
+
+    // addEdge() repetido suma cobertura sin duplicar la arista, y la
+    // cobertura se satura en vez de dar la vuelta.
+    CompactGraph repeated(3);
+    for (int i = 0; i < 70000; ++i) {
+        repeated.addEdge(0, 2);
+    }
+    ok = ok && repeated.edgeCount() == 1 && repeated.edgeCoverage(repeated.find(0), 2) == CompactGraph::MAX_COVERAGE;
+
+    // removeEdge() quita los dos bits y dropIsolatedNodes() los nodos sueltos.
+    graph.removeEdge(gt, encodeBase('T'));
+    ok = ok && graph.edgeCount() == 2 && graph.outMask(gt) == 1u << encodeBase('C') &&
+         graph.dropIsolatedNodes() == 1 && graph.nodeCount() == 3 && graph.find(0xF) == CompactGraph::npos &&
+         graph.edgeCoverage(graph.find(0xB), encodeBase('C')) == 3;
+
+    std::cout << "Coberturas: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Limpieza: una punta, una burbuja y la poda por cobertura en ejemplos
+// pequeños, y lecturas con errores de un genoma que vuelve a ser un único
+// unitig tras cleanGraph().
+bool test_cleaning() {
+    std::mt19937 rng(37);
+    const std::string genome = random_read(300, rng);
+    const int k = 15;
+    bool ok = true;
+
+    // Un error en la penúltima base de una lectura: punta de 2 aristas que
+    // sale del camino y muere en el vacío.
+    std::vector<std::string> tip_reads(10, genome);
+    std::string tip = genome.substr(0, 200);
+    tip[198] = tip[198] == 'A' ? 'C' : 'A';
+    tip_reads.push_back(tip);
+    CompactGraph tipped = buildCompactGraph(tip_reads, k);
+    ok = ok && tipped.edgeCount() == genome.size() - k + 1 + 2 && clipTips(tipped, 2 * k) == 2 &&
+         popBubbles(tipped, 2 * k) == 0 && tipped.edgeCount() == genome.size() - k + 1;
+
+    // Un error en medio, repetido en tres lecturas (la poda con cobertura 2
+    // no lo quita): burbuja de k aristas frente a las 10 del camino correcto.
+    std::vector<std::string> bubble_reads(10, genome);
+    std::string bubble = genome;
+    bubble[150] = bubble[150] == 'A' ? 'C' : 'A';
+    bubble_reads.insert(bubble_reads.end(), 3, bubble);
+    CompactGraph bubbled = buildCompactGraph(bubble_reads, k);
+    ok = ok && pruneLowCoverage(bubbled, 2) == 0 && clipTips(bubbled, 2 * k) == 0 && popBubbles(bubbled, 2 * k) == k &&
+         bubbled.edgeCount() == genome.size() - k + 1 && bubbled.dropIsolatedNodes() == k - 1 &&
+         buildUnitigGraph(bubbled, 1).sequence(0) == genome;
+
+    // Poda: la lectura con el error, una sola vez.
+    CompactGraph pruned = buildCompactGraph({genome, genome, bubble}, k);
+    ok = ok && pruneLowCoverage(pruned, 2) == k && pruned.edgeCount() == genome.size() - k + 1;
+
+    // Lecturas con un 1 % de errores a 40x de cobertura.
+    const std::string long_genome = random_read(20000, rng);
+    std::vector<std::string> reads;
+    for (int r = 0; r < 8000; ++r) {
+        std::string read = long_genome.substr(rng() % (long_genome.size() - 100), 100);
+        for (char& c : read) {
+            if (rng() % 100 == 0) {
+                c = "ACGT"[rng() % 4];
+            }
+        }
+        reads.push_back(read);
+    }
+    CompactGraph noisy = buildCompactGraph(reads, 21);
+    const size_t noisy_nodes = noisy.nodeCount();
+    CleaningStats stats = cleanGraph(noisy);
+    UnitigGraph unitigs = buildUnitigGraph(noisy, 1);
+    size_t longest = 0;
+    for (size_t id = 1; id < unitigs.unitigCount(); ++id) {
+        longest = unitigs.length(id) > unitigs.length(longest) ? id : longest;
+    }
+    ok = ok && stats.prunedEdges > 0 && noisy.nodeCount() < noisy_nodes / 2 &&
+         noisy.nodeCount() < long_genome.size() * 105 / 100 && unitigs.length(longest) * 2 > long_genome.size() &&
+         long_genome.find(unitigs.sequence(longest)) != std::string::npos;
+
+    std::cout << "Limpieza del grafo: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Complementario inverso de una cadena de ADN.
+std::string reverse_complement(const std::string& kmer) {
+    std::string result(kmer.rbegin(), kmer.rend());
+    for (char& c : result) {
+        c = c == 'A' ? 'T' : c == 'C' ? 'G' : c == 'G' ? 'C' : 'A';
+    }
+    return result;
+}
+
+// Contador en streaming frente a un recuento con substr y unordered_map:
+// canónicos o no, bases ambiguas, salida de printKmerFrequencies(), una
+// tabla que se llena sin crecer y un k fuera de [1, 31], que se rechaza.
+bool test_kmer_counter() {
+    std::mt19937 rng(41);
+    const std::string genome = random_read(5000, rng);
+    std::vector<std::string> reads;
+    for (int r = 0; r < 400; ++r) {
+        std::string read = genome.substr(rng() % (genome.size() - 80), 10 + rng() % 70);
+        for (char& c : read) {
+            const unsigned event = rng() % 300;
+            c = event == 0 ? 'N' : event == 1 ? bases_lower(c) : c;
+        }
+        reads.push_back(read);
+    }
+
+    bool ok = true;
+    for (int k : {1, 5, 21, 31}) {
+        for (bool canonical : {false, true}) {
+            std::unordered_map<std::string, uint32_t> expected;
+            for (const std::string& read : reads) {
+                std::string upper = read;
+                for (char& c : upper) {
+                    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+                }
+                for (size_t i = 0; i + k <= upper.size(); ++i) {
+                    std::string kmer = upper.substr(i, k);
+                    if (kmer.find('N') != std::string::npos) {
+                        continue;
+                    }
+                    const std::string reverse = reverse_complement(kmer);
+                    ++expected[canonical && reverse < kmer ? reverse : kmer];
+                }
+            }
+
+            KmerCounter counter(k, size_t(1) << 20, canonical);
+            for (const std::string& read : reads) {
+                counter.addSequence(read);
+            }
+            std::ostringstream printed;
+            printKmerFrequencies(counter, printed);
+            std::unordered_map<std::string, uint32_t> counted;
+            std::istringstream lines(printed.str());
+            std::string line;
+            while (std::getline(lines, line)) {
+                const size_t comma = line.find(", Frecuencia: ");
+                counted[line.substr(8, comma - 8)] = static_cast<uint32_t>(std::stoul(line.substr(comma + 14)));
+            }
+            ok = ok && counted == expected && counter.distinctKmers() == expected.size() && counter.droppedKmers() == 0;
+            // count() acepta cualquiera de las dos hebras.
+            const std::string probe = genome.substr(100, k);
+            uint64_t code = 0;
+            for (char c : reverse_complement(probe)) {
+                code = (code << 2) | encodeBase(c);
+            }
+            ok = ok && (!canonical || counter.count(code) == expected[std::min(probe, reverse_complement(probe))]);
+        }
+    }
+
+    // 1 kB: 64 huecos, 48 k-meros distintos como mucho. Los que ya están se
+    // siguen contando; los nuevos se descartan.
+    KmerCounter small(21, 1024);
+    small.addSequence(genome);
+    small.addSequence(genome);
+    ok = ok && small.memoryBytes() <= 1024 && small.distinctKmers() == small.maxDistinctKmers() &&
+         small.totalKmers() == 2 * (genome.size() - 20) &&
+         small.droppedKmers() == small.totalKmers() - 2 * small.distinctKmers();
+    for (int k : {-3, 0, 32}) {
+        bool rejected = false;
+        try {
+            KmerCounter invalid(k, 1024);
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        ok = ok && rejected;
+    }
+
+    std::cout << "Contador de k-meros: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Recuento en disco frente a substr y unordered_map: k de 1 a 63 (de una y de
+// dos palabras), las dos hebras y bases ambiguas, 16 cubos en 1 MB, y cubos
+// que no caben en memoria y se cuentan por partes igual que KmerCounter.
+bool test_disk_kmer_counter() {
+    std::mt19937 rng(43);
+    const std::string genome = random_read(5000, rng);
+    std::vector<std::string> reads;
+    for (int r = 0; r < 400; ++r) {
+        std::string read = genome.substr(rng() % (genome.size() - 100), 10 + rng() % 90);
+        for (char& c : read) {
+            c = rng() % 300 == 0 ? 'N' : c;
+        }
+        reads.push_back(read);
+    }
+
+    bool ok = true;
+    for (int k : {1, 5, 31, 32, 63}) {
+        for (bool canonical : {false, true}) {
+            std::unordered_map<std::string, uint32_t> expected;
+            size_t total = 0;
+            for (const std::string& read : reads) {
+                for (size_t i = 0; i + k <= read.size(); ++i) {
+                    std::string kmer = read.substr(i, k);
+                    if (kmer.find('N') != std::string::npos) {
+                        continue;
+                    }
+                    const std::string reverse = reverse_complement(kmer);
+                    ++expected[canonical && reverse < kmer ? reverse : kmer];
+                    ++total;
+                }
+            }
+
+            DiskCounterOptions options;
+            options.k = k;
+            options.maxMemoryBytes = size_t(1) << 20;
+            options.numThreads = 2;
+            options.buckets = 16;
+            options.canonical = canonical;
+            DiskKmerCounter counter(options);
+            for (const std::string& read : reads) {
+                counter.addSequence(read);
+            }
+            std::unordered_map<std::string, uint32_t> counted;
+            bool unique = true;
+            counter.count([&](const std::string& kmer, uint32_t count) {
+                unique = unique && counted.emplace(kmer, count).second;
+            });
+            ok = ok && unique && counted == expected && counter.totalKmers() == total &&
+                 counter.distinctKmers() == expected.size() && counter.diskBytes() > 0;
+        }
+    }
+
+    // 1 MB para 600 000 k-meros en 2 cubos: cada cubo se reparte en partes
+    // contadas por trozos y el resultado es el mismo que el de KmerCounter.
+    const std::string large = random_read(200000, rng);
+    DiskCounterOptions options;
+    options.k = 21;
+    options.maxMemoryBytes = size_t(1) << 20;
+    options.numThreads = 2;
+    options.buckets = 2;
+    DiskKmerCounter counter(options);
+    KmerCounter reference(21, size_t(64) << 20);
+    for (int copy = 0; copy < 3; ++copy) {
+        counter.addSequence(large);
+        reference.addSequence(large);
+    }
+    bool same = true;
+    counter.count([&](const std::string& kmer, uint32_t count) {
+        uint64_t code = 0;
+        for (char c : kmer) {
+            code = (code << 2) | encodeBase(c);
+        }
+        same = same && reference.count(code) == count;
+    });
+    ok = ok && same && counter.distinctKmers() == reference.distinctKmers() &&
+         counter.totalKmers() == reference.totalKmers();
+
+    bool rejected = false;
+    try {
+        counter.addSequence(large);
+    } catch (const std::logic_error&) {
+        rejected = true;
+    }
+    ok = ok && rejected;
+
+    std::cout << "Contador de k-meros en disco: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+// Contador directo de k pequeños: una sola pasada con varios k (repetidos y
+// desordenados) coincide con KmerCounter para cada uno, en las dos hebras,
+// con bases ambiguas y minúsculas y con la misma salida impresa. La memoria
+// máxima cuenta cada k una vez, con sus tablas de 32 y de 64 bits.
+bool test_dense_kmer_counter() {
+    std::mt19937 rng(47);
+    const std::string genome = random_read(20000, rng);
+    std::vector<std::string> reads;
+    for (int r = 0; r < 300; ++r) {
+        std::string read = genome.substr(rng() % (genome.size() - 100), 1 + rng() % 100);
+        for (char& c : read) {
+            const unsigned event = rng() % 300;
+            c = event == 0 ? 'N' : event == 1 ? bases_lower(c) : c;
+        }
+        reads.push_back(read);
+    }
+    reads.push_back(genome);
+
+    // Una sola pasada con varios k da lo mismo que KmerCounter con cada uno,
+    // en las dos hebras y con la misma salida impresa.
+    bool ok = true;
+    for (bool canonical : {false, true}) {
+        DenseKmerCounter dense({3, 12, 1, 6, 3}, canonical);
+        for (const std::string& read : reads) {
+            dense.addSequence(read);
+        }
+        ok = ok && dense.kmerLengths() == std::vector<int>{12, 6, 3, 1} &&
+             DenseKmerCounter::maxMemoryBytes({3, 12, 1, 6, 3}) == 12 * ((size_t(1) << 24) + 4096 + 64 + 4) &&
+             dense.memoryBytes() <= DenseKmerCounter::maxMemoryBytes({3, 12, 1, 6, 3});
+        for (int k : dense.kmerLengths()) {
+            KmerCounter reference(k, size_t(16) << 20, canonical);
+            DenseKmerCounter single(k, canonical);
+            for (const std::string& read : reads) {
+                reference.addSequence(read);
+                single.addSequence(read);
+            }
+            for (size_t slot = 0; slot < reference.slotCount(); ++slot) {
+                ok = ok && (!reference.occupied(slot) ||
+                            dense.count(k, reference.kmer(slot)) == reference.countAt(slot));
+            }
+            ok = ok && dense.totalKmers(k) == reference.totalKmers() &&
+                 dense.distinctKmers(k) == reference.distinctKmers();
+
+            std::ostringstream expected;
+            std::ostringstream printed;
+            printKmerFrequencies(reference, expected);
+            printKmerFrequencies(single, printed);
+            std::vector<std::string> expected_lines;
+            std::vector<std::string> printed_lines;
+            std::istringstream expected_stream(expected.str());
+            std::istringstream printed_stream(printed.str());
+            for (std::string line; std::getline(expected_stream, line);) {
+                expected_lines.push_back(line);
+            }
+            for (std::string line; std::getline(printed_stream, line);) {
+                printed_lines.push_back(line);
+            }
+            std::sort(expected_lines.begin(), expected_lines.end());
+            ok = ok && printed_lines == expected_lines;
+        }
+    }
+
+    bool rejected = false;
+    try {
+        DenseKmerCounter too_long(13);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    ok = ok && rejected;
+
+    std::cout << "Contador directo de k-meros: " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+
+int main() {
+    bool ok = test_matches_build_graph();
+    ok = test_ambiguous_bases() && ok;
+    ok = test_growth() && ok;
+    ok = test_parallel_builder() && ok;
+    ok = test_eulerian_path() && ok;
+    ok = test_unitigs() && ok;
+    ok = test_unitig_eulerian() && ok;
+    ok = test_coverage() && ok;
+    ok = test_cleaning() && ok;
+    ok = test_kmer_counter() && ok;
+    ok = test_disk_kmer_counter() && ok;
+    ok = test_dense_kmer_counter() && ok;
+    return ok ? 0 : 1;
+}
@@ -1,7 +1,19 @@
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <limits>
 #include <iostream>
 #include <vector>
 #include <string>
 #include "graph.h" 
+#include "compact_graph.h"
+#include "dense_kmer_counter.h"
+#include "disk_kmer_counter.h"
+#include "parallel_graph_builder.h"
+#include "eulerian_path.h"
+#include "graph_cleaning.h"
+#include "kmer_counter.h"
+#include "unitig_graph.h"
 #include <fstream>
 #include <vector>
 #include <string>
@@ -37,29 +49,25 @@ void runTest(const std::vector<std::string>& reads, int k, const std::string& te
     std::cout << "Test: " << testName << std::endl;
     
     // Construir el grafo
-    std::unordered_map<std::string, Node*> graph = buildGraph(reads, k);
+    CompactGraph graph = buildCompactGraph(reads, k);
 
     // Imprimir el grafo
     std::cout << "Graph structure:" << std::endl;
-    printGraph(graph);
+    printCompactGraph(graph);
 
-    // Encontrar el circuito Euleriano si existe
-    std::vector<Node*> circuit = fleuryAlgorithm(graph);
-    
-    std::cout << "Eulerian Circuit:";
-    if (circuit.empty()) {
-        std::cout << " No Eulerian Circuit found.";
+    // Buscar un camino o circuito euleriano (Hierholzer) sobre el grafo de
+    // unitigs, expandido de vuelta a sus (k-1)-meros
+    EulerianWalk walk = findEulerianPath(buildUnitigGraph(graph));
+
+    std::cout << (walk.kind == EULERIAN_PATH ? "Eulerian Path:" : "Eulerian Circuit:");
+    if (walk.kind == EULERIAN_NONE) {
+        std::cout << " No Eulerian Path found.";
     } else {
-        for (Node* node : circuit) {
-            std::cout << " " << node->kmer << " ->";
+        for (std::uint64_t node : walk.nodes) {
+            std::cout << " " << decodeKmer(node, graph.nodeLength()) << " ->";
         }
     }
     std::cout << " END" << std::endl << std::endl;
-
-    // Limpiar la memoria
-    for (auto& pair : graph) {
-        delete pair.second;
-    }
 }
 
 void runTests() {
@@ -72,28 +80,182 @@ void runTests() {
     runTest(readsEulerianWithDeadEnds, k, "Eulerian Cycle with Extras");
 }
 
-void calculateKmerFrequencyFastq(const std::string& fastqPath) {
+// Pasa cada registro del fichero a counter.addSequence(); false si no se abre.
+template <typename Counter>
+bool countRecords(const std::string& fastqPath, Counter& counter) {
+    KSeq record;
+    SeqStreamIn iss(fastqPath.c_str());
+    if (!iss) {
+        std::cerr << "Error al abrir el archivo: " << fastqPath << std::endl;
+        return false;
+    }
+    while (iss >> record) {
+        counter.addSequence(record.seq);
+    }
+    return true;
+}
+
+// Cuenta los k-meros canónicos de un FASTQ o FASTA (comprimido o no)
+// registro a registro, sin cargar el fichero en memoria: las tablas ocupan
+// como mucho memoryMB megabytes sea cual sea el tamaño del fichero. Con k
+// pequeños (hasta DenseKmerCounter::MAX_K) cuyas tablas de 4^k cuentas
+// quepan, se cuentan todos en una sola pasada indexando por el código del
+// k-mero; si no, con la tabla hash, una pasada por k.
+void calculateKmerFrequencyFastq(const std::string& fastqPath, const std::vector<int>& kValues, std::size_t memoryMB) {
+    // Las tablas directas ocupan hasta 12 * 4^k bytes cada una: 192 MB con k = 12.
+    const int maxK = *std::max_element(kValues.begin(), kValues.end());
+    if (maxK <= DenseKmerCounter::MAX_K && DenseKmerCounter::maxMemoryBytes(kValues) <= memoryMB << 20) {
+        DenseKmerCounter counter(kValues);
+        if (countRecords(fastqPath, counter)) {
+            printKmerFrequencies(counter, std::cout);
+        }
+        return;
+    }
+
+    std::vector<int> lengths(kValues);
+    std::sort(lengths.begin(), lengths.end(), [](int a, int b) { return a > b; });
+    lengths.erase(std::unique(lengths.begin(), lengths.end()), lengths.end());
+    for (int k : lengths) {
+        KmerCounter counter(k, memoryMB << 20);
+        if (!countRecords(fastqPath, counter)) {
+            return;
+        }
+        printKmerFrequencies(counter, std::cout);
+        reportDroppedKmers(counter, std::cerr);
+    }
+}
+
+// Lista de k separados por comas ("2,3,4"); vacía si alguno no es un número
+// entre 1 y 63, el mayor k que admite el recuento en disco.
+std::vector<int> parseKmerLengths(const std::string& text) {
+    std::vector<int> kValues;
+    std::size_t begin = 0;
+    while (begin <= text.size()) {
+        std::size_t end = text.find(',', begin);
+        end = end == std::string::npos ? text.size() : end;
+        char* parsed = nullptr;
+        const std::string item = text.substr(begin, end - begin);
+        const long k = std::strtol(item.c_str(), &parsed, 10);
+        if (item.empty() || *parsed != '\0' || k < 1 || k > 63) {
+            return {};
+        }
+        kValues.push_back(static_cast<int>(k));
+        begin = end + 1;
+    }
+    return kValues;
+}
+
+// Megabytes de memoria; 0 si no es un número positivo o no cabe en bytes.
+std::size_t parseMemoryMB(const std::string& text) {
+    char* parsed = nullptr;
+    const unsigned long long megabytes = std::strtoull(text.c_str(), &parsed, 10);
+    if (text.empty() || text[0] == '-' || *parsed != '\0' ||
+        megabytes > (std::numeric_limits<std::size_t>::max() >> 20)) {
+        return 0;
+    }
+    return static_cast<std::size_t>(megabytes);
+}
+
+// Número de hilos de 0 (todos los núcleos) a MAX_THREADS; -1 si no es válido.
+const unsigned long MAX_THREADS = 1024;
+long parseThreadCount(const std::string& text) {
+    char* parsed = nullptr;
+    const unsigned long threads = std::strtoul(text.c_str(), &parsed, 10);
+    if (text.empty() || text[0] == '-' || *parsed != '\0' || threads > MAX_THREADS) {
+        return -1;
+    }
+    return static_cast<long>(threads);
+}
+
+// Cuenta los k-meros canónicos (k hasta 63) en dos pasadas con cubos en
+// disco: la RAM no pasa de memoryMB megabytes aunque los k-meros distintos
+// no quepan en ella, a cambio de escribir las lecturas en 2 bits en
+// tempDirectory (vacío: el directorio temporal del sistema).
+void calculateKmerFrequencyDisk(const std::string& fastqPath, int k, std::size_t memoryMB, unsigned numThreads,
+                                const std::string& tempDirectory) {
+    DiskCounterOptions options;
+    options.k = k;
+    options.maxMemoryBytes = memoryMB << 20;
+    // Con poca memoria, menos cubos: cada uno necesita un búfer de al menos
+    // 4 kB en la mitad del límite, y así 1 MB sigue siendo un límite válido.
+    options.buckets = std::min(options.buckets, options.maxMemoryBytes / (std::size_t(8) << 10));
+    options.numThreads = numThreads;
+    options.tempDirectory = tempDirectory;
+    DiskKmerCounter counter(options);
+    KSeq record;
+    SeqStreamIn iss(fastqPath.c_str());
+    if (!iss) {
+        std::cerr << "Error al abrir el archivo: " << fastqPath << std::endl;
+        return;
+    }
+    while (iss >> record) {
+        counter.addSequence(record.seq);
+    }
+
+    counter.count([](const std::string& kmer, std::uint32_t count) {
+        std::cout << "K-mero: " << kmer << ", Frecuencia: " << count << '\n';
+    });
+    std::cerr << counter.totalKmers() << " k-meros, " << counter.distinctKmers() << " distintos, "
+              << (counter.diskBytes() >> 20) << " MB en disco" << std::endl;
+}
+
+// Limpia el grafo de las lecturas (cobertura, puntas y burbujas), lo compacta
+// en unitigs y los escribe en FASTA por la salida estándar.
+void writeContigsFastq(const std::string& fastqPath, int k) {
     std::vector<std::string> sequences = readFastqSequences(fastqPath);
 
-    std::unordered_map<std::string, Node*> graph = buildGraph(sequences, 5);
+    CompactGraph graph = buildCompactGraphParallel(sequences, k);
+    sequences.clear();
+    const std::size_t rawNodes = graph.nodeCount();
+    cleanGraph(graph);
+    UnitigGraph unitigs = buildUnitigGraph(graph);
 
-    getKmerFrequency(sequences, graph);
+    std::cerr << rawNodes << " nodos, " << graph.nodeCount() << " tras limpiar, " << unitigs.unitigCount()
+              << " unitigs" << std::endl;
+    writeContigsFasta(unitigs, std::cout);
 }
 
 int main_assembly(int argc, char* argv[]) {
     if (argc < 3) {
-        std::cout << "Uso: " << argv[0] << " <kmerfreq|testFleury> <ruta_archivo|modo_prueba>" << std::endl;
+        std::cout << "Uso: " << argv[0] << " <kmerfreq|kmerfreqDisk|contigs|testEulerian> <ruta_archivo|modo_prueba> [k] [memoria_MB]"
+                  << " [hilos] [dir_temporal]" << std::endl;
         return 1;
     }
 
     std::string mode = argv[1];
     std::string input = argv[2];
 
-    if (mode == "kmerfreq") {
-        // Llama directamente a la función con la ruta proporcionada
-        calculateKmerFrequencyFastq(input);
+    if (mode == "kmerfreq" || mode == "kmerfreqDisk") {
+        // Con k > 31 los k-meros no caben en la tabla en memoria: van a disco.
+        // kmerfreq acepta varios k separados por comas, todos hasta 12.
+        const std::vector<int> kValues = parseKmerLengths(argc > 3 ? argv[3] : (mode == "kmerfreq" ? "5" : "31"));
+        const std::size_t memoryMB = argc > 4 ? parseMemoryMB(argv[4]) : KMER_FREQUENCY_MEMORY >> 20;
+        if (memoryMB == 0) {
+            std::cout << "Memoria inválida: indique un número de megabytes mayor que 0." << std::endl;
+            return 1;
+        }
+        const long numThreads = argc > 5 ? parseThreadCount(argv[5]) : 0;
+        if (numThreads < 0) {
+            std::cout << "Hilos inválidos: indique un número de 0 (todos los núcleos) a " << MAX_THREADS << "."
+                      << std::endl;
+            return 1;
+        }
+        const int maxK = kValues.empty() ? 0 : *std::max_element(kValues.begin(), kValues.end());
+        if (kValues.empty() || (kValues.size() > 1 && (mode != "kmerfreq" || maxK > DenseKmerCounter::MAX_K))) {
+            std::cout << "k inválido: use un número de 1 a 63 o, con kmerfreq, varios hasta 12 separados por comas." << std::endl;
+            return 1;
+        }
+        if (mode == "kmerfreq" && kValues[0] <= 31) {
+            calculateKmerFrequencyFastq(input, kValues, memoryMB);
+        } else {
+            calculateKmerFrequencyDisk(input, kValues[0], memoryMB, static_cast<unsigned>(numThreads),
+                                       argc > 6 ? argv[6] : "");
+        }
+
+    } else if (mode == "contigs") {
+        writeContigsFastq(input, argc > 3 ? std::atoi(argv[3]) : 31);
 
-    } else if (mode == "testFleury") {
+    } else if (mode == "testEulerian" || mode == "testFleury") {
         std::vector<std::string> reads;
         int k = 3;
 
@@ -114,14 +276,20 @@ int main_assembly(int argc, char* argv[]) {
             return 1;
         }
     } else {
-        std::cout << "Modo inválido. Use 'kmerfreq' o 'testFleury'." << std::endl;
+        std::cout << "Modo inválido. Use 'kmerfreq', 'kmerfreqDisk', 'contigs' o 'testEulerian'." << std::endl;
         return 1;
     }
+    return 0;
 }
 
-int main() {
-    
-
-    return 0;
+int main(int argc, char* argv[]) {
+    // Los parámetros fuera de rango que no se comprueban aquí (k de contigs,
+    // un límite que no alcanza para el contador...) llegan como excepciones.
+    try {
+        return main_assembly(argc, argv);
+    } catch (const std::exception& error) {
+        std::cerr << "Error: " << error.what() << std::endl;
+        return 1;
+    }
 }
 
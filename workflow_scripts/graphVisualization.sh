@@ -1,5 +1,5 @@
 #!/bin/bash
 TESTTYPE="readsNonEulerian"
 
-./build/main testFleury "$TESTTYPE" > workflow_scripts/temp_output.txt
+./build/main testEulerian "$TESTTYPE" > workflow_scripts/temp_output.txt
 python ./Assembly/De_Brujin_Graphs/visualize_graph.py < workflow_scripts/temp_output.txt